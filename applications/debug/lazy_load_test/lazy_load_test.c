@@ -0,0 +1,56 @@
+#include <furi.h>
+
+#define TAG "LazyLoadTest"
+
+/*
+ * Used by elf_loader unit test: cold functions are loaded on first call through
+ * loader stubs, which must pass register, floating point and stack arguments as is.
+ */
+
+// Static function may be relocated against its section instead of own symbol
+static FAP_COLD int32_t lazy_load_test_static(int32_t a, int32_t b) {
+    return a * b - 1;
+}
+
+FAP_COLD int32_t lazy_load_test_stack_args(
+    int32_t a,
+    int32_t b,
+    int32_t c,
+    int32_t d,
+    int32_t e,
+    int32_t f) {
+    return a + 2 * b + 3 * c + 4 * d + 5 * e + 6 * f + lazy_load_test_static(e, f);
+}
+
+FAP_COLD double lazy_load_test_float_args(
+    int32_t a,
+    float b,
+    int32_t c,
+    double d,
+    int32_t e,
+    float f,
+    int32_t g,
+    int32_t h) {
+    return a + (double)b * 2 + c * 3 + d * 4 + e * 5 + (double)f * 6 + g * 7 + h * 8;
+}
+
+int32_t lazy_load_test_app(void* p) {
+    UNUSED(p);
+    // Keep compiler from evaluating cold calls at build time
+    volatile int32_t one = 1;
+    int32_t (*volatile static_fn)(int32_t, int32_t) = lazy_load_test_static;
+    bool success = true;
+
+    // 1 + 4 + 9 + 16 + 25 + 36 + (5 * 6 - 1)
+    success &= lazy_load_test_stack_args(one, one + 1, one + 2, one + 3, one + 4, one + 5) ==
+               120;
+    // 1 + 3 + 9 + 10 + 25 + 4.5 + 49 + 64
+    success &= lazy_load_test_float_args(
+                   one, 1.5f, one + 2, 2.5, one + 4, 0.75f, one + 6, one + 7) == 165.5;
+    success &= static_fn(one + 2, one + 3) == 11;
+    // Second round goes straight to the loaded section
+    success &= lazy_load_test_static(one + 1, one + 1) == 3;
+
+    FURI_LOG_I(TAG, "Cold calls %s", success ? "passed" : "failed");
+    return success ? 0 : -1;
+}
@@ -0,0 +1,217 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <toolbox/stream/string_stream.h>
+#include <ducky_script/ducky_script_program.h>
+#include "../minunit.h"
+
+#define BAD_USB_TEST_KEYS_MAX 128
+
+static const char* bad_usb_test_script = "ID 1234:abcd Flipper:Keyboard\r\n"
+                                         "REM Example payload\r\n"
+                                         "\r\n"
+                                         "DEFAULT_DELAY 0\n"
+                                         "  DELAY 500  \r\n"
+                                         "STRINGLN echo hello\r\n"
+                                         "REPEAT 2\r\n"
+                                         "GUI r\n"
+                                         "CTRL-ALT DELETE\n"
+                                         "\n"
+                                         "DELAY 0\n"
+                                         "REPEAT abc\n"
+                                         "NOKEY\n"
+                                         "STRING last";
+
+typedef struct {
+    DuckyOpcode opcode;
+    uint16_t key;
+    uint8_t chr;
+    uint32_t value;
+    const char* text;
+} BadUsbTestLine;
+
+static const BadUsbTestLine bad_usb_test_program[] = {
+    {DuckyOpId, 0, 0, 0, "1234:abcd Flipper:Keyboard"},
+    {DuckyOpRem, 0, 0, 0, ""},
+    {DuckyOpDefaultDelay, 0, 0, 0, ""},
+    {DuckyOpDelay, 0, 0, 500, ""},
+    {DuckyOpString, 0, 0, 0, "echo hello\n"},
+    {DuckyOpRepeat, 0, 0, 2, ""},
+    {DuckyOpKey, KEY_MOD_LEFT_GUI, 'r', 0, ""},
+    {DuckyOpKey, KEY_MOD_LEFT_CTRL | KEY_MOD_LEFT_ALT | HID_KEYBOARD_DELETE_FORWARD, 0, 0, ""},
+    {DuckyOpError, 0, 0, 0, "Invalid number 0"},
+    {DuckyOpError, 0, 0, 0, "Invalid number abc"},
+    {DuckyOpError, 0, 0, 0, "No keycode defined for NOKEY"},
+    {DuckyOpString, 0, 0, 0, "last"},
+};
+
+static DuckyProgram* bad_usb_test_compile(const char* script_text) {
+    Stream* script = string_stream_alloc();
+    Stream* stream = string_stream_alloc();
+    DuckyProgramHeader header = {0};
+
+    stream_write_cstring(script, script_text);
+    stream_rewind(script);
+    bool compiled = ducky_program_compile(script, stream, &header);
+    stream_free(script);
+
+    if(!compiled) {
+        stream_free(stream);
+        return NULL;
+    }
+    return ducky_program_alloc(stream, &header);
+}
+
+MU_TEST(bad_usb_compile_test) {
+    DuckyProgram* program = bad_usb_test_compile(bad_usb_test_script);
+    mu_assert(program, "compilation failed");
+
+    // Empty lines are not counted, same as in script preview
+    mu_assert_int_eq(COUNT_OF(bad_usb_test_program), program->line_nb);
+
+    for(size_t i = 0; i < COUNT_OF(bad_usb_test_program); i++) {
+        const BadUsbTestLine* line = &bad_usb_test_program[i];
+        DuckyInstruction instruction;
+
+        mu_assert(ducky_program_next(program, &instruction), "program read failed");
+        mu_assert_int_eq(line->opcode, instruction.opcode);
+        mu_assert_int_eq(line->key, instruction.key);
+        mu_assert_int_eq(line->chr, instruction.chr);
+        mu_assert_int_eq(line->value, instruction.value);
+        mu_assert_string_eq(line->text, program->text);
+    }
+
+    ducky_program_free(program);
+}
+
+MU_TEST(bad_usb_repeat_test) {
+    DuckyProgram* program = bad_usb_test_compile("REPEAT 3\n"
+                                                 "STRING a\n"
+                                                 "REPEAT 2\n"
+                                                 "ENTER\n");
+    mu_assert(program, "compilation failed");
+
+    DuckyInstruction instruction;
+    mu_assert(ducky_program_next(program, &instruction), "program read failed");
+    mu_assert_int_eq(DuckyOpRepeat, instruction.opcode);
+    mu_assert(!ducky_program_previous(program, &instruction), "nothing to repeat on first line");
+
+    mu_assert(ducky_program_next(program, &instruction), "program read failed");
+    mu_assert(ducky_program_next(program, &instruction), "program read failed");
+    mu_assert_int_eq(DuckyOpRepeat, instruction.opcode);
+
+    // REPEAT executes the line before it, not itself
+    for(size_t i = 0; i < 2; i++) {
+        mu_assert(ducky_program_previous(program, &instruction), "program read failed");
+        mu_assert_int_eq(DuckyOpString, instruction.opcode);
+        mu_assert_string_eq("a", program->text);
+    }
+
+    mu_assert(ducky_program_next(program, &instruction), "program read failed");
+    mu_assert_int_eq(DuckyOpKey, instruction.opcode);
+    mu_assert_int_eq(HID_KEYBOARD_RETURN, instruction.key);
+    mu_assert(!ducky_program_next(program, &instruction), "read past program end");
+
+    ducky_program_rewind(program);
+    mu_assert(ducky_program_next(program, &instruction), "program read failed");
+    mu_assert_int_eq(DuckyOpRepeat, instruction.opcode);
+    mu_assert_int_eq(3, instruction.value);
+
+    ducky_program_free(program);
+}
+
+// Host side of keyboard: registers keys that were not pressed in previous report
+typedef struct {
+    uint16_t layout[128];
+    DuckyHidReport pressed;
+    uint16_t keys[BAD_USB_TEST_KEYS_MAX];
+    size_t keys_nb;
+    size_t reports_nb;
+} BadUsbTestHost;
+
+static void bad_usb_test_host_report(BadUsbTestHost* host, const DuckyHidReport* report) {
+    for(uint8_t i = 0; i < report->keys_nb; i++) {
+        bool pressed = false;
+        for(uint8_t j = 0; j < host->pressed.keys_nb; j++) {
+            pressed |= (host->pressed.keys[j] == report->keys[i]);
+        }
+        if(!pressed && host->keys_nb < BAD_USB_TEST_KEYS_MAX) {
+            host->keys[host->keys_nb++] = (report->mods << 8) | report->keys[i];
+        }
+    }
+    host->pressed = *report;
+    host->reports_nb++;
+}
+
+// Same sequence as ducky_string_batch() sends
+static void bad_usb_test_type(BadUsbTestHost* host, const char* text) {
+    DuckyHidReport prev = {0};
+    DuckyHidReport report;
+    DuckyHidReport release = {0};
+
+    while(*text != '\0') {
+        text += ducky_string_plan_report(host->layout, text, &prev, &report);
+        if(report.keys_nb == 0) break;
+
+        if(report.release) {
+            bad_usb_test_host_report(host, &release);
+        }
+        bad_usb_test_host_report(host, &report);
+        prev = report;
+    }
+    bad_usb_test_host_report(host, &release);
+}
+
+static void bad_usb_test_batch(const char* text, size_t reports_max) {
+    BadUsbTestHost* host = malloc(sizeof(BadUsbTestHost));
+    memcpy(host->layout, hid_asciimap, MIN(sizeof(hid_asciimap), sizeof(host->layout)));
+
+    bad_usb_test_type(host, text);
+
+    // Keys registered by host must be the same as typed one by one
+    size_t keys_nb = 0;
+    for(size_t i = 0; text[i] != '\0'; i++) {
+        uint16_t keycode = ducky_string_get_keycode(host->layout, text[i]);
+        if(keycode == HID_KEYBOARD_NONE) continue;
+        mu_assert(keys_nb < host->keys_nb, "key is not registered");
+        mu_assert_int_eq(keycode, host->keys[keys_nb]);
+        keys_nb++;
+    }
+    mu_assert_int_eq(keys_nb, host->keys_nb);
+    mu_assert_int_eq(0, host->pressed.keys_nb);
+    mu_assert(host->reports_nb <= reports_max, "too many reports");
+
+    free(host);
+}
+
+MU_TEST(bad_usb_string_batch_test) {
+    // Report and final release
+    bad_usb_test_batch("abcdef", 2);
+    // Runs longer than six keys
+    bad_usb_test_batch("abcdefghijklmnopqrstuvwxyz0123456789", 8);
+    // Repeated keys
+    bad_usb_test_batch("aaa", 6);
+    bad_usb_test_batch("hello world", 10);
+    bad_usb_test_batch("\n\n\n", 6);
+    // Shift changes
+    bad_usb_test_batch("Hello World!\nABCabcABC", 22);
+    bad_usb_test_batch("aA", 4);
+    // Unmapped characters are skipped
+    bad_usb_test_batch("a\x01"
+                       "b\x7f"
+                       "c\xc3\xa9"
+                       "d",
+                       2);
+    bad_usb_test_batch("\x01\x02", 1);
+    bad_usb_test_batch("", 1);
+}
+
+MU_TEST_SUITE(bad_usb_suite) {
+    MU_RUN_TEST(bad_usb_compile_test);
+    MU_RUN_TEST(bad_usb_repeat_test);
+    MU_RUN_TEST(bad_usb_string_batch_test);
+}
+
+int run_minunit_test_bad_usb() {
+    MU_RUN_SUITE(bad_usb_suite);
+    return MU_EXIT_CODE;
+}
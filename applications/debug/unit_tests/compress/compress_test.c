@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <string.h>
+#include <furi.h>
+#include <furi_hal.h>
+#include <assets_icons.h>
+#include <gui/icon_i.h>
+#include <toolbox/compress.h>
+#include "../minunit.h"
+#include "../test_benchmark.h"
+
+#define COMPRESS_TEST_ROUNDS 100
+
+// Icons drawn by menus and status screens on every redraw
+static const Icon* const compress_test_icons[] = {
+    &A_Sub1ghz_14,
+    &A_125khz_14,
+    &A_NFC_14,
+    &A_Infrared_14,
+    &A_Loading_24,
+    &I_ButtonCenter_7x7,
+    &I_ButtonLeft_4x7,
+    &I_ButtonRight_4x7,
+    &I_DolphinCommon_56x48,
+    &I_Warning_30x23,
+};
+
+static size_t compress_test_frame_size(const Icon* icon) {
+    return ((icon->width + 7) / 8) * icon->height;
+}
+
+static uint32_t compress_test_render(CompressIcon* compress_icon, bool cold) {
+    uint32_t cycles = 0;
+
+    for(size_t round = 0; round < COMPRESS_TEST_ROUNDS; round++) {
+        for(size_t i = 0; i < COUNT_OF(compress_test_icons); i++) {
+            const Icon* icon = compress_test_icons[i];
+            uint8_t* decoded = NULL;
+            if(cold) compress_icon_cache_clear(compress_icon);
+
+            uint32_t cycles_start = test_benchmark_cycles();
+            compress_icon_decode(
+                compress_icon, icon->frames[round % icon->frame_count], &decoded);
+            cycles += test_benchmark_cycles() - cycles_start;
+        }
+    }
+
+    return cycles;
+}
+
+MU_TEST(compress_icon_cache_test) {
+    CompressIcon* compress_icon = compress_icon_alloc();
+    uint8_t* frame = malloc(1024);
+
+    for(size_t i = 0; i < COUNT_OF(compress_test_icons); i++) {
+        const Icon* icon = compress_test_icons[i];
+        size_t size = compress_test_frame_size(icon);
+
+        for(size_t j = 0; j < icon->frame_count; j++) {
+            uint8_t* decoded = NULL;
+
+            compress_icon_cache_clear(compress_icon);
+            compress_icon_decode(compress_icon, icon->frames[j], &decoded);
+            memcpy(frame, decoded, size);
+
+            compress_icon_decode(compress_icon, icon->frames[j], &decoded);
+            mu_assert(memcmp(frame, decoded, size) == 0, "cached frame differs from decoded");
+        }
+    }
+
+    CompressIconStats stats;
+    compress_icon_get_stats(compress_icon, &stats);
+    mu_assert(stats.hits > 0, "no cache hits");
+    mu_assert(stats.hits == stats.misses, "unexpected cache miss");
+
+    compress_icon_cache_clear(compress_icon);
+    compress_icon_get_stats(compress_icon, &stats);
+    mu_assert_int_eq(0, stats.cache_entries);
+    mu_assert_int_eq(0, stats.cache_size);
+
+    free(frame);
+    compress_icon_free(compress_icon);
+}
+
+MU_TEST(compress_icon_cache_benchmark) {
+    CompressIcon* compress_icon = compress_icon_alloc();
+    size_t draws = COMPRESS_TEST_ROUNDS * COUNT_OF(compress_test_icons);
+
+    uint32_t cold = compress_test_render(compress_icon, true);
+    compress_icon_cache_clear(compress_icon);
+
+    CompressIconStats before;
+    compress_icon_get_stats(compress_icon, &before);
+    uint32_t warm = compress_test_render(compress_icon, false);
+    CompressIconStats after;
+    compress_icon_get_stats(compress_icon, &after);
+
+    uint32_t hits = after.hits - before.hits;
+    uint32_t misses = after.misses - before.misses;
+    printf(
+        "  icon decode: %lu ns/draw uncached, %lu ns/draw cached\r\n",
+        test_benchmark_ns_per_item(cold, draws),
+        test_benchmark_ns_per_item(warm, draws));
+    printf(
+        "  cache: %lu%% hits, %lu evictions, %lu entries, %lu bytes\r\n",
+        (hits + misses) ? hits * 100 / (hits + misses) : 0,
+        after.evictions - before.evictions,
+        after.cache_entries,
+        (uint32_t)after.cache_size);
+
+    compress_icon_free(compress_icon);
+
+    mu_assert(warm < cold, "cache does not speed up decoding");
+}
+
+MU_TEST_SUITE(compress_suite) {
+    MU_RUN_TEST(compress_icon_cache_test);
+    MU_RUN_TEST(compress_icon_cache_benchmark);
+}
+
+int run_minunit_test_compress() {
+    MU_RUN_SUITE(compress_suite);
+    return MU_EXIT_CODE;
+}
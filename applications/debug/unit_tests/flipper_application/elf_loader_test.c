@@ -0,0 +1,429 @@
+#include <stdio.h>
+#include <furi.h>
+#include <furi_hal.h>
+#include <toolbox/dir_walk.h>
+#include <loader/firmware_api/firmware_api.h>
+#include <flipper_application/elf/elf_file.h>
+#include <flipper_application/flipper_application.h>
+#include <flipper_application/application_manifest.h>
+#include <flipper_application/api_hashtable/api_hashtable.h>
+#include "../minunit.h"
+#include "../test_benchmark.h"
+
+#define TAG "ElfLoaderTest"
+
+#define ELF_LOADER_TEST_APPS_PATH EXT_PATH("apps")
+#define ELF_LOADER_TEST_FAP_MAX 8
+#define ELF_LOADER_TEST_RUNS 2
+#define ELF_LOADER_TEST_RESOLVER_ROUNDS 1000
+#define ELF_LOADER_TEST_LAZY_FAP_PATH EXT_PATH("apps/Debug/lazy_load_test.fap")
+#define ELF_LOADER_TEST_CACHE_FAP_PATH EXT_PATH("apps/Debug/relocation_cache_test.fap")
+#define ELF_LOADER_TEST_CACHE_FAP_COPY_PATH EXT_PATH("unit_tests/relocation_cache_test.fap")
+#define ELF_LOADER_TEST_CACHE_DIR CFG_PATH("fap_cache")
+#define ELF_LOADER_TEST_STALE_CACHE_PATH ELF_LOADER_TEST_CACHE_DIR "/00000000.rel"
+
+static const char* const elf_loader_test_api_symbols[] = {
+    "furi_delay_ms",
+    "furi_record_open",
+    "furi_record_close",
+    "furi_string_alloc",
+    "furi_string_free",
+    "storage_file_alloc",
+    "storage_file_open",
+    "storage_file_read",
+    "view_port_alloc",
+    "gui_add_view_port",
+    "canvas_draw_str",
+    "furi_message_queue_get",
+};
+
+typedef struct {
+    uint32_t open;
+    uint32_t section_table;
+    uint32_t sections;
+} ElfLoaderTestTimings;
+
+static bool elf_loader_test_read_manifest(File* file, size_t offset, size_t size, void* context) {
+    FlipperApplicationManifest* manifest = context;
+
+    if(size < sizeof(FlipperApplicationManifest)) {
+        return false;
+    }
+
+    return storage_file_seek(file, offset, true) &&
+           storage_file_read(file, manifest, sizeof(FlipperApplicationManifest)) ==
+               sizeof(FlipperApplicationManifest);
+}
+
+static bool elf_loader_test_is_compatible(ELFFile* elf) {
+    FlipperApplicationManifest manifest = {0};
+
+    return elf_process_section(elf, ".fapmeta", elf_loader_test_read_manifest, &manifest) ==
+               ElfProcessSectionResultSuccess &&
+           flipper_application_manifest_is_valid(&manifest) &&
+           flipper_application_manifest_is_target_compatible(&manifest) &&
+           flipper_application_manifest_is_compatible(&manifest, firmware_api_interface);
+}
+
+static void elf_loader_test_print_stats(
+    const char* path,
+    uint32_t run,
+    const ElfLoaderTestTimings* timings,
+    const ELFFileStats* stats) {
+    uint32_t lookups = stats->symbol_reads + stats->symbol_cache_hits;
+    uint32_t hit_rate = lookups ? stats->symbol_cache_hits * 100 / lookups : 0;
+
+    printf(
+        "  %s #%lu: open %lu us, section table %lu us, sections %lu us\r\n",
+        path,
+        run,
+        test_benchmark_cycles_to_us(timings->open),
+        test_benchmark_cycles_to_us(timings->section_table),
+        test_benchmark_cycles_to_us(timings->sections));
+    printf(
+        "    %lu sections, %lu of %lu bytes resident, %lu relocations, %lu fast%s\r\n",
+        stats->sections_loaded,
+        stats->sections_size,
+        stats->sections_total_size,
+        stats->relocations,
+        stats->fast_relocations,
+        stats->relocation_cache_used ? " (cached)" : "");
+    printf(
+        "    %lu symbol reads, symbol cache hits %lu%%, %lu resolver calls, %lu trampolines\r\n",
+        stats->symbol_reads,
+        hit_rate,
+        stats->resolver_calls,
+        stats->trampolines);
+    if(stats->lazy_sections) {
+        printf(
+            "    %lu lazy sections, %lu loaded, %lu stubs\r\n",
+            stats->lazy_sections,
+            stats->lazy_sections_loaded,
+            stats->lazy_stubs);
+    }
+}
+
+typedef enum {
+    ElfLoaderTestResultOk,
+    ElfLoaderTestResultSkipped,
+    ElfLoaderTestResultOpenError,
+    ElfLoaderTestResultSectionTableError,
+    ElfLoaderTestResultSectionsError,
+    ElfLoaderTestResultStatsError,
+} ElfLoaderTestResult;
+
+static ElfLoaderTestResult elf_loader_test_load(Storage* storage, const char* path, uint32_t run) {
+    ElfLoaderTestTimings timings = {0};
+    ELFFile* elf = elf_file_alloc(storage, firmware_api_interface);
+    ElfLoaderTestResult result = ElfLoaderTestResultOk;
+
+    do {
+        uint32_t cycles_start = test_benchmark_cycles();
+        bool opened = elf_file_open(elf, path);
+        timings.open = test_benchmark_cycles() - cycles_start;
+        if(!opened) {
+            result = ElfLoaderTestResultOpenError;
+            break;
+        }
+
+        if(!elf_loader_test_is_compatible(elf)) {
+            printf("  %s: skipped, not compatible with firmware\r\n", path);
+            result = ElfLoaderTestResultSkipped;
+            break;
+        }
+
+        cycles_start = test_benchmark_cycles();
+        bool section_table_loaded = elf_file_load_section_table(elf);
+        timings.section_table = test_benchmark_cycles() - cycles_start;
+        if(!section_table_loaded) {
+            result = ElfLoaderTestResultSectionTableError;
+            break;
+        }
+
+        cycles_start = test_benchmark_cycles();
+        ELFFileLoadStatus status = elf_file_load_sections(elf);
+        timings.sections = test_benchmark_cycles() - cycles_start;
+        if(status != ELFFileLoadStatusSuccess) {
+            result = ElfLoaderTestResultSectionsError;
+            break;
+        }
+
+        const ELFFileStats* stats = elf_file_get_stats(elf);
+        elf_loader_test_print_stats(path, run, &timings, stats);
+
+        if(stats->sections_loaded == 0 ||
+           stats->relocations != stats->symbol_reads + stats->symbol_cache_hits) {
+            result = ElfLoaderTestResultStatsError;
+        }
+    } while(false);
+
+    elf_file_free(elf);
+
+    return result;
+}
+
+MU_TEST(elf_loader_api_resolver_test) {
+    Elf32_Addr address = 0;
+
+    mu_assert(
+        firmware_api_interface->resolver_callback(
+            firmware_api_interface, elf_symbolname_hash("furi_delay_ms"), &address),
+        "furi_delay_ms is not resolved");
+    mu_assert(address == (Elf32_Addr)furi_delay_ms, "furi_delay_ms resolved to wrong address");
+
+    mu_assert(
+        !firmware_api_interface->resolver_callback(
+            firmware_api_interface, elf_symbolname_hash("elf_loader_test_no_symbol"), &address),
+        "unknown symbol is resolved");
+}
+
+MU_TEST(elf_loader_api_resolver_benchmark) {
+    uint32_t hashes[COUNT_OF(elf_loader_test_api_symbols)];
+    for(size_t i = 0; i < COUNT_OF(elf_loader_test_api_symbols); i++) {
+        hashes[i] = elf_symbolname_hash(elf_loader_test_api_symbols[i]);
+    }
+
+    size_t resolved = 0;
+    uint32_t cycles_start = test_benchmark_cycles();
+    for(size_t round = 0; round < ELF_LOADER_TEST_RESOLVER_ROUNDS; round++) {
+        for(size_t i = 0; i < COUNT_OF(hashes); i++) {
+            Elf32_Addr address = 0;
+            if(firmware_api_interface->resolver_callback(
+                   firmware_api_interface, hashes[i], &address)) {
+                resolved++;
+            }
+        }
+    }
+    uint32_t cycles = test_benchmark_cycles() - cycles_start;
+    size_t lookups = ELF_LOADER_TEST_RESOLVER_ROUNDS * COUNT_OF(hashes);
+
+    printf("  API resolver: %lu ns/lookup\r\n", test_benchmark_ns_per_item(cycles, lookups));
+    mu_assert_int_eq(lookups, resolved);
+}
+
+MU_TEST(elf_loader_fap_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    DirWalk* dir_walk = dir_walk_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    FileInfo fileinfo;
+    size_t loaded = 0;
+    ElfLoaderTestResult result = ElfLoaderTestResultOk;
+
+    dir_walk_set_recursive(dir_walk, true);
+
+    if(dir_walk_open(dir_walk, ELF_LOADER_TEST_APPS_PATH)) {
+        while(loaded < ELF_LOADER_TEST_FAP_MAX &&
+              dir_walk_read(dir_walk, path, &fileinfo) == DirWalkOK) {
+            if(file_info_is_dir(&fileinfo) || !furi_string_end_with_str(path, ".fap")) {
+                continue;
+            }
+
+            // Second run shows the effect of relocation cache
+            for(uint32_t run = 0; run < ELF_LOADER_TEST_RUNS; run++) {
+                result = elf_loader_test_load(storage, furi_string_get_cstr(path), run);
+                if(result != ElfLoaderTestResultOk) break;
+            }
+
+            if(result == ElfLoaderTestResultOk) {
+                loaded++;
+            } else if(result != ElfLoaderTestResultSkipped) {
+                break;
+            }
+        }
+    }
+
+    if(loaded == 0) {
+        printf("  no compatible FAPs found in " ELF_LOADER_TEST_APPS_PATH "\r\n");
+    }
+
+    dir_walk_close(dir_walk);
+    dir_walk_free(dir_walk);
+    furi_string_free(path);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(result != ElfLoaderTestResultOpenError, "elf_file_open failed");
+    mu_assert(
+        result != ElfLoaderTestResultSectionTableError, "elf_file_load_section_table failed");
+    mu_assert(result != ElfLoaderTestResultSectionsError, "elf_file_load_sections failed");
+    mu_assert(result != ElfLoaderTestResultStatsError, "inconsistent loader stats");
+}
+
+static void elf_loader_test_lazy_load(ELFFile* elf) {
+    mu_assert(elf_file_open(elf, ELF_LOADER_TEST_LAZY_FAP_PATH), "elf_file_open failed");
+    if(!elf_loader_test_is_compatible(elf)) {
+        printf("  " ELF_LOADER_TEST_LAZY_FAP_PATH ": skipped, not compatible with firmware\r\n");
+        return;
+    }
+    mu_assert(elf_file_load_section_table(elf), "elf_file_load_section_table failed");
+    mu_assert(
+        elf_file_load_sections(elf) == ELFFileLoadStatusSuccess, "elf_file_load_sections failed");
+
+    const ELFFileStats* stats = elf_file_get_stats(elf);
+    mu_assert(stats->lazy_sections > 0, "no lazy sections");
+    mu_assert_int_eq(0, stats->lazy_sections_loaded);
+    mu_assert(stats->lazy_stubs > 0, "no lazy stubs");
+    mu_assert(stats->sections_size < stats->sections_total_size, "lazy section is resident");
+
+    // Test app calls cold functions with stack and floating point arguments
+    elf_file_call_init(elf);
+    FlipperApplicationEntryPoint entry_point = elf_file_get_entry_point(elf);
+    int32_t result = entry_point(NULL);
+    elf_file_call_fini(elf);
+
+    mu_assert_int_eq(0, result);
+    mu_assert_int_eq(stats->lazy_sections, stats->lazy_sections_loaded);
+    mu_assert_int_eq(stats->sections_total_size, stats->sections_size);
+}
+
+MU_TEST(elf_loader_lazy_load_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    if(storage_file_exists(storage, ELF_LOADER_TEST_LAZY_FAP_PATH)) {
+        ELFFile* elf = elf_file_alloc(storage, firmware_api_interface);
+        elf_loader_test_lazy_load(elf);
+        elf_file_free(elf);
+    } else {
+        printf("  " ELF_LOADER_TEST_LAZY_FAP_PATH " not found, skipped\r\n");
+    }
+
+    furi_record_close(RECORD_STORAGE);
+}
+
+static bool elf_loader_test_resolve(
+    const ElfApiInterface* interface,
+    uint32_t hash,
+    Elf32_Addr* address) {
+    UNUSED(interface);
+    return firmware_api_interface->resolver_callback(firmware_api_interface, hash, address);
+}
+
+static bool elf_loader_test_find_section(File* file, size_t offset, size_t size, void* context) {
+    UNUSED(file);
+    size_t* end = context;
+    *end = offset + size;
+    return size > 0;
+}
+
+static bool elf_loader_test_cache_run(Storage* storage, const ElfApiInterface* api, bool* cached) {
+    ELFFile* elf = elf_file_alloc(storage, api);
+    bool result = false;
+
+    if(elf_file_open(elf, ELF_LOADER_TEST_CACHE_FAP_COPY_PATH) &&
+       elf_file_load_section_table(elf) &&
+       elf_file_load_sections(elf) == ELFFileLoadStatusSuccess) {
+        elf_file_call_init(elf);
+        FlipperApplicationEntryPoint entry_point = elf_file_get_entry_point(elf);
+        result = entry_point(NULL) == 0;
+        elf_file_call_fini(elf);
+    }
+
+    *cached = elf_file_get_stats(elf)->relocation_cache_used;
+    elf_file_free(elf);
+
+    return result;
+}
+
+// Changes the last byte of debug link CRC: FAP size and loaded code stay the same
+static bool elf_loader_test_cache_change_fap(Storage* storage) {
+    ELFFile* elf = elf_file_alloc(storage, firmware_api_interface);
+    size_t end = 0;
+    bool found = elf_file_open(elf, ELF_LOADER_TEST_CACHE_FAP_COPY_PATH) &&
+                 elf_process_section(elf, ".gnu_debuglink", elf_loader_test_find_section, &end) ==
+                     ElfProcessSectionResultSuccess;
+    elf_file_free(elf);
+
+    File* file = storage_file_alloc(storage);
+    uint8_t byte = 0;
+    bool result =
+        found &&
+        storage_file_open(
+            file, ELF_LOADER_TEST_CACHE_FAP_COPY_PATH, FSAM_READ_WRITE, FSOM_OPEN_EXISTING) &&
+        storage_file_seek(file, end - 1, true) && storage_file_read(file, &byte, 1) == 1;
+    byte ^= 0xFF;
+    result = result && storage_file_seek(file, end - 1, true) &&
+             storage_file_write(file, &byte, 1) == 1;
+    storage_file_free(file);
+
+    return result;
+}
+
+static void elf_loader_test_relocation_cache(Storage* storage) {
+    ElfApiInterface api = {
+        .api_version_major = firmware_api_interface->api_version_major,
+        .api_version_minor = firmware_api_interface->api_version_minor + 1,
+        .resolver_callback = elf_loader_test_resolve,
+    };
+    bool cached = true;
+
+    // Invalid cache files are pruned when cache of another FAP is built
+    File* file = storage_file_alloc(storage);
+    mu_assert(storage_simply_mkdir(storage, ELF_LOADER_TEST_CACHE_DIR), "mkdir failed");
+    mu_assert(
+        storage_file_open(
+            file, ELF_LOADER_TEST_STALE_CACHE_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+            storage_file_write(file, "stale", 5) == 5,
+        "stale cache write failed");
+    storage_file_free(file);
+
+    mu_assert(elf_loader_test_cache_run(storage, firmware_api_interface, &cached), "run failed");
+    mu_assert(!cached, "cache used on first launch");
+    mu_assert(!storage_file_exists(storage, ELF_LOADER_TEST_STALE_CACHE_PATH), "not pruned");
+
+    mu_assert(elf_loader_test_cache_run(storage, firmware_api_interface, &cached), "run failed");
+    mu_assert(cached, "cache not used on second launch");
+
+    // API version change
+    mu_assert(elf_loader_test_cache_run(storage, &api, &cached), "run failed");
+    mu_assert(!cached, "cache used with another API version");
+    mu_assert(elf_loader_test_cache_run(storage, &api, &cached), "run failed");
+    mu_assert(cached, "cache not rebuilt for another API version");
+    mu_assert(elf_loader_test_cache_run(storage, firmware_api_interface, &cached), "run failed");
+    mu_assert(!cached, "cache used with another API version");
+
+    // FAP change
+    mu_assert(elf_loader_test_cache_change_fap(storage), "FAP change failed");
+    mu_assert(elf_loader_test_cache_run(storage, firmware_api_interface, &cached), "run failed");
+    mu_assert(!cached, "cache used with changed FAP");
+    mu_assert(elf_loader_test_cache_run(storage, firmware_api_interface, &cached), "run failed");
+    mu_assert(cached, "cache not rebuilt for changed FAP");
+}
+
+MU_TEST(elf_loader_relocation_cache_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    ELFFile* elf = elf_file_alloc(storage, firmware_api_interface);
+    bool compatible = elf_file_open(elf, ELF_LOADER_TEST_CACHE_FAP_PATH) &&
+                      elf_loader_test_is_compatible(elf);
+    elf_file_free(elf);
+
+    if(compatible &&
+       storage_common_copy(
+           storage, ELF_LOADER_TEST_CACHE_FAP_PATH, ELF_LOADER_TEST_CACHE_FAP_COPY_PATH) ==
+           FSE_OK) {
+        elf_loader_test_relocation_cache(storage);
+    } else {
+        printf("  " ELF_LOADER_TEST_CACHE_FAP_PATH " not found or not compatible, skipped\r\n");
+    }
+
+    FuriString* cache_path = furi_string_alloc_printf(
+        ELF_LOADER_TEST_CACHE_DIR "/%08lX.rel",
+        elf_symbolname_hash(ELF_LOADER_TEST_CACHE_FAP_COPY_PATH));
+    storage_simply_remove(storage, furi_string_get_cstr(cache_path));
+    storage_simply_remove(storage, ELF_LOADER_TEST_CACHE_FAP_COPY_PATH);
+    storage_simply_remove(storage, ELF_LOADER_TEST_STALE_CACHE_PATH);
+    furi_string_free(cache_path);
+
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(elf_loader_suite) {
+    MU_RUN_TEST(elf_loader_api_resolver_test);
+    MU_RUN_TEST(elf_loader_api_resolver_benchmark);
+    MU_RUN_TEST(elf_loader_fap_test);
+    MU_RUN_TEST(elf_loader_lazy_load_test);
+    MU_RUN_TEST(elf_loader_relocation_cache_test);
+}
+
+int run_minunit_test_elf_loader() {
+    MU_RUN_SUITE(elf_loader_suite);
+    return MU_EXIT_CODE;
+}
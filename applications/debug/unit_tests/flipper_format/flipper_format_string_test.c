@@ -5,6 +5,8 @@
 #include <storage/storage.h>
 #include "../minunit.h"
 
+#define TAG "FlipperFormatTest"
+
 static const char* test_filetype = "Flipper Format test";
 static const uint32_t test_version = 666;
 
@@ -54,6 +56,19 @@ static const char* test_data_win = "Filetype: Flipper Format test\r\n"
                                    "Float data: 1.5 1000.0\r\n"
                                    "Hex data: DE AD BE";
 
+static const char* test_data_repeated = "Filetype: Flipper Format test\n"
+                                        "Version: 666\n"
+                                        "# This is comment\n"
+                                        "name: First\n"
+                                        "type: raw\n"
+                                        "data: 1 2 3\n"
+                                        "# name: Comment\n"
+                                        "name: Second\n"
+                                        "type: parsed\n"
+                                        "name: Third\n"
+                                        "type: raw\n"
+                                        "data: 4 5\n";
+
 #define ARRAY_W_COUNT(x) (x), (COUNT_OF(x))
 #define ARRAY_W_BSIZE(x) (x), (sizeof(x))
 
@@ -295,6 +310,126 @@ MU_TEST(flipper_format_string_test) {
     flipper_format_free(flipper_format);
 }
 
+MU_TEST(flipper_format_key_index_test) {
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    FuriString* value = furi_string_alloc();
+    uint32_t data[3];
+    uint32_t count;
+
+    flipper_format_set_key_index(flipper_format, true);
+
+    stream_write_cstring(stream, test_data_repeated);
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(flipper_format_read_string(flipper_format, "name", value));
+    mu_assert_string_eq("First", furi_string_get_cstr(value));
+    mu_check(flipper_format_read_string(flipper_format, "name", value));
+    mu_assert_string_eq("Second", furi_string_get_cstr(value));
+    mu_check(flipper_format_read_string(flipper_format, "type", value));
+    mu_assert_string_eq("parsed", furi_string_get_cstr(value));
+    mu_check(flipper_format_get_value_count(flipper_format, "data", &count));
+    mu_assert_int_eq(2, count);
+    mu_check(flipper_format_read_string(flipper_format, "name", value));
+    mu_assert_string_eq("Third", furi_string_get_cstr(value));
+    mu_check(flipper_format_read_uint32(flipper_format, "data", data, 2));
+    mu_assert_int_eq(4, data[0]);
+    mu_assert_int_eq(5, data[1]);
+    mu_check(!flipper_format_read_string(flipper_format, "name", value));
+
+    mu_check(flipper_format_key_exist(flipper_format, "type"));
+    mu_check(!flipper_format_key_exist(flipper_format, "# name"));
+    mu_check(!flipper_format_key_exist(flipper_format, "nonexistent"));
+
+    // Strict mode must not skip keys
+    flipper_format_set_strict_mode(flipper_format, true);
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(!flipper_format_read_string(flipper_format, "name", value));
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(flipper_format_read_string(flipper_format, "Filetype", value));
+    mu_check(flipper_format_read_string(flipper_format, "Version", value));
+    mu_check(flipper_format_read_string(flipper_format, "name", value));
+    mu_assert_string_eq("First", furi_string_get_cstr(value));
+    mu_check(!flipper_format_read_string(flipper_format, "data", value));
+    flipper_format_set_strict_mode(flipper_format, false);
+
+    // Updates drop the index
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(flipper_format_update_string_cstr(flipper_format, "name", "Renamed first"));
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(flipper_format_read_string(flipper_format, "name", value));
+    mu_assert_string_eq("Renamed first", furi_string_get_cstr(value));
+    mu_check(flipper_format_read_string(flipper_format, "data", value));
+    mu_assert_string_eq("1 2 3", furi_string_get_cstr(value));
+    mu_check(flipper_format_read_string(flipper_format, "name", value));
+    mu_assert_string_eq("Second", furi_string_get_cstr(value));
+
+    stream_clean(stream);
+    stream_write_cstring(stream, test_data_nix);
+    MU_RUN_TEST_1(flipper_format_read_and_update_test, flipper_format);
+
+    furi_string_free(value);
+    flipper_format_free(flipper_format);
+}
+
+static uint32_t flipper_format_key_index_walk(
+    FlipperFormat* flipper_format,
+    const char* path,
+    bool key_index,
+    uint32_t* signals) {
+    FuriString* value = furi_string_alloc();
+    uint32_t start = furi_get_tick();
+
+    flipper_format_set_key_index(flipper_format, key_index);
+    *signals = 0;
+    if(flipper_format_buffered_file_open_existing(flipper_format, path)) {
+        // Universal remote access pattern: walk signals and look up optional keys
+        while(flipper_format_read_string(flipper_format, "name", value)) {
+            if(!flipper_format_read_string(flipper_format, "type", value)) break;
+            flipper_format_key_exist(flipper_format, "missing");
+            (*signals)++;
+        }
+    }
+    flipper_format_buffered_file_close(flipper_format);
+
+    furi_string_free(value);
+    return furi_get_tick() - start;
+}
+
+MU_TEST(flipper_format_key_index_benchmark) {
+    const char* files[] = {
+        EXT_PATH("infrared/assets/tv.ir"),
+        EXT_PATH("infrared/assets/ac.ir"),
+        EXT_PATH("infrared/assets/audio.ir"),
+        EXT_PATH("infrared/assets/projectors.ir"),
+    };
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_buffered_file_alloc(storage);
+
+    for(size_t i = 0; i < COUNT_OF(files); i++) {
+        if(!storage_file_exists(storage, files[i])) continue;
+
+        uint32_t signals_scan;
+        uint32_t signals_index;
+        uint32_t time_scan =
+            flipper_format_key_index_walk(flipper_format, files[i], false, &signals_scan);
+        uint32_t time_index =
+            flipper_format_key_index_walk(flipper_format, files[i], true, &signals_index);
+        mu_assert_int_eq(signals_scan, signals_index);
+
+        FURI_LOG_I(
+            TAG,
+            "%s: %lu signals, scan %lums, index %lums",
+            files[i],
+            signals_scan,
+            time_scan,
+            time_index);
+    }
+
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST(flipper_format_file_test) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
@@ -328,6 +463,8 @@ MU_TEST(flipper_format_file_test) {
 
 MU_TEST_SUITE(flipper_format_string_suite) {
     MU_RUN_TEST(flipper_format_string_test);
+    MU_RUN_TEST(flipper_format_key_index_test);
+    MU_RUN_TEST(flipper_format_key_index_benchmark);
     MU_RUN_TEST(flipper_format_file_test);
 }
 
@@ -1,12 +1,15 @@
 #include <furi.h>
+#include <furi_hal.h>
 #include <flipper_format.h>
 #include <infrared.h>
 #include <common/infrared_common_i.h>
 #include "../minunit.h"
+#include "../test_benchmark.h"
 
 #define IR_TEST_FILES_DIR EXT_PATH("unit_tests/infrared/")
 #define IR_TEST_FILE_PREFIX "test_"
 #define IR_TEST_FILE_SUFFIX ".irtest"
+#define IR_TEST_BENCHMARK_PULSES 20000
 
 typedef struct {
     InfraredDecoderHandler* decoder_handler;
@@ -400,6 +403,44 @@ static void infrared_test_run_decoder(InfraredProtocol protocol, uint32_t test_i
     mu_assert(message_counter == messages_count, "decoded less than expected");
 }
 
+static void infrared_test_run_decoder_benchmark(InfraredProtocol protocol) {
+    uint32_t* timings;
+    uint32_t timings_count;
+
+    mu_assert(
+        infrared_test_prepare_file(infrared_get_protocol_name(protocol)),
+        "Failed to prepare test file");
+    mu_assert(
+        infrared_test_load_raw_signal(test->ff, "decoder_input1", &timings, &timings_count),
+        "Failed to load raw signal from file");
+    flipper_format_buffered_file_close(test->ff);
+
+    uint32_t pulses = 0;
+    uint32_t decoded = 0;
+    bool level = false;
+
+    infrared_reset_decoder(test->decoder_handler);
+    uint32_t cycles_start = test_benchmark_cycles();
+    while(pulses < IR_TEST_BENCHMARK_PULSES) {
+        for(uint32_t i = 0; i < timings_count; ++i) {
+            if(infrared_decode(test->decoder_handler, level, timings[i])) ++decoded;
+            level = !level;
+        }
+        pulses += timings_count;
+    }
+    uint64_t cycles = test_benchmark_cycles() - cycles_start;
+    infrared_reset_decoder(test->decoder_handler);
+
+    free(timings);
+
+    printf(
+        "  %-10s %6lu ns/pulse, %lu decoded\r\n",
+        infrared_get_protocol_name(protocol),
+        test_benchmark_ns_per_item(cycles, pulses),
+        decoded);
+    mu_assert(decoded, "nothing decoded");
+}
+
 MU_TEST(infrared_test_decoder_samsung32) {
     infrared_test_run_decoder(InfraredProtocolSamsung32, 1);
 }
@@ -522,6 +563,19 @@ MU_TEST(infrared_test_encoder_decoder_all) {
     infrared_test_run_encoder_decoder(InfraredProtocolRCA, 1);
 }
 
+MU_TEST(infrared_test_decoder_benchmark) {
+    printf("Infrared decode benchmark:\r\n");
+    infrared_test_run_decoder_benchmark(InfraredProtocolNEC);
+    infrared_test_run_decoder_benchmark(InfraredProtocolNECext);
+    infrared_test_run_decoder_benchmark(InfraredProtocolNEC42ext);
+    infrared_test_run_decoder_benchmark(InfraredProtocolSamsung32);
+    infrared_test_run_decoder_benchmark(InfraredProtocolRC5);
+    infrared_test_run_decoder_benchmark(InfraredProtocolRC6);
+    infrared_test_run_decoder_benchmark(InfraredProtocolSIRC);
+    infrared_test_run_decoder_benchmark(InfraredProtocolKaseikyo);
+    infrared_test_run_decoder_benchmark(InfraredProtocolRCA);
+}
+
 MU_TEST_SUITE(infrared_test) {
     MU_SUITE_CONFIGURE(&infrared_test_alloc, &infrared_test_free);
 
@@ -541,6 +595,7 @@ MU_TEST_SUITE(infrared_test) {
     MU_RUN_TEST(infrared_test_decoder_rca);
     MU_RUN_TEST(infrared_test_decoder_mixed);
     MU_RUN_TEST(infrared_test_encoder_decoder_all);
+    MU_RUN_TEST(infrared_test_decoder_benchmark);
 }
 
 int run_minunit_test_infrared() {
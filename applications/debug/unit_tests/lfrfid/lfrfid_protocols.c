@@ -1,10 +1,14 @@
 #include <furi.h>
+#include <furi_hal.h>
 #include "../minunit.h"
+#include "../test_benchmark.h"
 #include <toolbox/protocols/protocol_dict.h>
 #include <lfrfid/protocols/lfrfid_protocols.h>
 #include <toolbox/pulse_protocols/pulse_glue.h>
 
 #define LF_RFID_READ_TIMING_MULTIPLIER 8
+#define LF_RFID_BENCHMARK_FRAMES 4
+#define LF_RFID_BENCHMARK_REPEAT 10
 
 #define EM_TEST_DATA \
     { 0x58, 0x00, 0x85, 0x64, 0x02 }
@@ -445,6 +449,97 @@ MU_TEST(test_lfrfid_protocol_inadala26_emulate_simple) {
     protocol_dict_free(dict);
 }
 
+static size_t test_lfrfid_benchmark_glue(
+    PulseGlue* pulse_glue,
+    const int8_t* timings,
+    size_t timings_count,
+    uint32_t* durations) {
+    size_t count = 0;
+    for(size_t i = 0; i < timings_count * LF_RFID_BENCHMARK_FRAMES; i++) {
+        const int8_t timing = timings[i % timings_count];
+        bool pulse_pop =
+            pulse_glue_push(pulse_glue, timing >= 0, abs(timing) * LF_RFID_READ_TIMING_MULTIPLIER);
+
+        if(pulse_pop) {
+            uint32_t length, period;
+            pulse_glue_pop(pulse_glue, &length, &period);
+            durations[count++] = period;
+            durations[count++] = length - period;
+        }
+    }
+    return count;
+}
+
+MU_TEST(test_lfrfid_protocol_decoders_benchmark) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+
+    // Recorded card sequences as the reader sees them: high period, then low remainder
+    const size_t durations_max =
+        (EM_TEST_EMULATION_TIMINGS_COUNT + HID10301_TEST_EMULATION_TIMINGS_COUNT +
+         IOPROX_XSF_TEST_EMULATION_TIMINGS_COUNT) *
+        LF_RFID_BENCHMARK_FRAMES;
+    uint32_t* durations = malloc(sizeof(uint32_t) * durations_max);
+    size_t durations_count = 0;
+    durations_count += test_lfrfid_benchmark_glue(
+        pulse_glue, em_test_timings, EM_TEST_EMULATION_TIMINGS_COUNT, durations);
+    durations_count += test_lfrfid_benchmark_glue(
+        pulse_glue,
+        hid10301_test_timings,
+        HID10301_TEST_EMULATION_TIMINGS_COUNT,
+        durations + durations_count);
+    durations_count += test_lfrfid_benchmark_glue(
+        pulse_glue,
+        ioprox_xsf_test_timings,
+        IOPROX_XSF_TEST_EMULATION_TIMINGS_COUNT,
+        durations + durations_count);
+    pulse_glue_free(pulse_glue);
+
+    const uint32_t pulses = durations_count * LF_RFID_BENCHMARK_REPEAT;
+    printf("LFRFID decode benchmark, %lu pulses:\r\n", pulses);
+
+    for(size_t protocol = 0; protocol < LFRFIDProtocolMax; protocol++) {
+        protocol_dict_decoders_start(dict);
+        uint32_t decoded = 0;
+        uint32_t cycles_start = test_benchmark_cycles();
+        for(size_t repeat = 0; repeat < LF_RFID_BENCHMARK_REPEAT; repeat++) {
+            for(size_t i = 0; i < durations_count; i++) {
+                if(protocol_dict_decoders_feed_by_id(dict, protocol, !(i & 1), durations[i]) !=
+                   PROTOCOL_NO) {
+                    decoded++;
+                }
+            }
+        }
+        uint64_t cycles = test_benchmark_cycles() - cycles_start;
+        printf(
+            "  %-12s %6lu ns/pulse, %lu decoded\r\n",
+            protocol_dict_get_name(dict, protocol),
+            test_benchmark_ns_per_item(cycles, pulses),
+            decoded);
+    }
+
+    protocol_dict_decoders_start(dict);
+    uint32_t decoded = 0;
+    uint32_t cycles_start = test_benchmark_cycles();
+    for(size_t repeat = 0; repeat < LF_RFID_BENCHMARK_REPEAT; repeat++) {
+        for(size_t i = 0; i < durations_count; i++) {
+            if(protocol_dict_decoders_feed(dict, !(i & 1), durations[i]) != PROTOCOL_NO) {
+                decoded++;
+            }
+        }
+    }
+    uint64_t cycles = test_benchmark_cycles() - cycles_start;
+    printf(
+        "  %-12s %6lu ns/pulse, %lu decoded\r\n",
+        "All",
+        test_benchmark_ns_per_item(cycles, pulses),
+        decoded);
+    mu_check(decoded > 0);
+
+    free(durations);
+    protocol_dict_free(dict);
+}
+
 MU_TEST_SUITE(test_lfrfid_protocols_suite) {
     MU_RUN_TEST(test_lfrfid_protocol_em_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_em_emulate_simple);
@@ -456,6 +551,8 @@ MU_TEST_SUITE(test_lfrfid_protocols_suite) {
     MU_RUN_TEST(test_lfrfid_protocol_ioprox_xsf_emulate_simple);
 
     MU_RUN_TEST(test_lfrfid_protocol_inadala26_emulate_simple);
+
+    MU_RUN_TEST(test_lfrfid_protocol_decoders_benchmark);
 }
 
 int run_minunit_test_lfrfid_protocols() {
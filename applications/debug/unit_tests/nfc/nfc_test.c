@@ -5,6 +5,7 @@
 #include <lib/flipper_format/flipper_format.h>
 #include <lib/nfc/protocols/nfca.h>
 #include <lib/nfc/helpers/mf_classic_dict.h>
+#include <lib/nfc/protocols/nfc_util.h>
 #include <lib/digital_signal/digital_signal.h>
 #include <lib/pulse_reader/pulse_reader.h>
 #include <lib/nfc/nfc_device.h>
@@ -21,6 +22,9 @@
 #define NFC_TEST_SIGNAL_SHORT_FILE "nfc_nfca_signal_short.nfc"
 #define NFC_TEST_SIGNAL_LONG_FILE "nfc_nfca_signal_long.nfc"
 #define NFC_TEST_DICT_PATH EXT_PATH("unit_tests/mf_classic_dict.nfc")
+#define NFC_TEST_DICT_INDEX_PATH EXT_PATH("unit_tests/mf_classic_dict.idx")
+#define NFC_TEST_DICT_INDEX_KEYS (300)
+#define NFC_TEST_DICT_KEY_LEN (13)
 #define NFC_TEST_NFC_DEV_PATH EXT_PATH("unit_tests/nfc/nfc_dev_test.nfc")
 
 static const char* nfc_test_file_type = "Flipper NFC test";
@@ -485,6 +489,137 @@ MU_TEST(mf_classic_dict_load_test) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static uint64_t nfc_test_dict_index_key(uint32_t seed) {
+    // Every 7th key repeats one of the previous ones
+    if(seed % 7 == 6) seed /= 2;
+    return ((uint64_t)(seed * 2654435761UL) << 16 | (seed * 40503UL)) & 0xFFFFFFFFFFFFULL;
+}
+
+MU_TEST(mf_classic_dict_index_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, NFC_TEST_DICT_PATH);
+    storage_simply_remove(storage, NFC_TEST_DICT_INDEX_PATH);
+
+    // Create dict with comments, invalid lines and duplicates
+    Stream* file_stream = file_stream_alloc(storage);
+    mu_assert(
+        file_stream_open(file_stream, NFC_TEST_DICT_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS),
+        "file_stream_open == true assert failed\r\n");
+    stream_write_cstring(file_stream, "# Unit test dictionary\n");
+    for(uint32_t i = 0; i < NFC_TEST_DICT_INDEX_KEYS; i++) {
+        uint64_t key = nfc_test_dict_index_key(i);
+        stream_write_format(
+            file_stream, "%04lX%08lX\n", (uint32_t)(key >> 32), (uint32_t)(key & 0xFFFFFFFF));
+        if(i % 50 == 0) stream_write_cstring(file_stream, "# comment\nBAD\n");
+    }
+    mu_assert(file_stream_close(file_stream), "file_stream_close == true assert failed\r\n");
+    stream_free(file_stream);
+
+    MfClassicDict* instance = mf_classic_dict_alloc(MfClassicDictTypeUnitTest);
+    mu_assert(instance != NULL, "mf_classic_dict_alloc\r\n");
+    uint32_t total_keys = mf_classic_dict_get_total_keys(instance);
+    mu_assert(total_keys == NFC_TEST_DICT_INDEX_KEYS, "total_keys assert failed\r\n");
+
+    // Reference: keys in the order the text parser returns them
+    uint64_t* keys_ref = malloc(total_keys * sizeof(uint64_t));
+    uint32_t keys_read = 0;
+    while(keys_read < total_keys &&
+          mf_classic_dict_get_next_key(instance, &keys_ref[keys_read])) {
+        keys_read++;
+    }
+    mu_assert(keys_read == total_keys, "get_next_key count assert failed\r\n");
+
+    uint8_t key_bytes[6];
+    for(uint32_t i = 0; i < total_keys; i++) {
+        uint32_t first_ref = 0;
+        while(keys_ref[first_ref] != keys_ref[i]) first_ref++;
+
+        nfc_util_num2bytes(keys_ref[i], 6, key_bytes);
+        uint32_t index_dut = UINT32_MAX;
+        mu_assert(
+            mf_classic_dict_is_key_present(instance, key_bytes),
+            "is_key_present assert failed\r\n");
+        mu_assert(
+            mf_classic_dict_find_index(instance, key_bytes, &index_dut),
+            "find_index == true assert failed\r\n");
+        mu_assert(index_dut == first_ref, "find_index position assert failed\r\n");
+    }
+    mu_assert(
+        storage_file_exists(storage, NFC_TEST_DICT_INDEX_PATH), "index file assert failed\r\n");
+
+    // Keys that are not in the dictionary
+    for(uint32_t i = 0; i < 64; i++) {
+        uint64_t key = nfc_test_dict_index_key(NFC_TEST_DICT_INDEX_KEYS + i * 7 + 1) ^ 1;
+        bool present_ref = false;
+        for(uint32_t j = 0; j < total_keys; j++) {
+            present_ref |= keys_ref[j] == key;
+        }
+        nfc_util_num2bytes(key, 6, key_bytes);
+        mu_assert(
+            mf_classic_dict_is_key_present(instance, key_bytes) == present_ref,
+            "absent key assert failed\r\n");
+    }
+
+    // Modifications must invalidate the index
+    uint64_t new_key = 0xA0A1A2A3A4A5;
+    nfc_util_num2bytes(new_key, 6, key_bytes);
+    mu_assert(!mf_classic_dict_is_key_present(instance, key_bytes), "new key assert failed\r\n");
+    mu_assert(mf_classic_dict_add_key(instance, key_bytes), "add_key assert failed\r\n");
+    uint32_t index_dut = 0;
+    mu_assert(
+        mf_classic_dict_find_index(instance, key_bytes, &index_dut) && index_dut == total_keys,
+        "added key position assert failed\r\n");
+    mu_assert(mf_classic_dict_delete_index(instance, 0), "delete_index assert failed\r\n");
+    mu_assert(
+        mf_classic_dict_find_index(instance, key_bytes, &index_dut) &&
+            index_dut == total_keys - 1,
+        "position after delete assert failed\r\n");
+
+    mu_assert(mf_classic_dict_is_index_rebuilt(instance), "index rebuilt assert failed\r\n");
+
+    free(keys_ref);
+    mf_classic_dict_free(instance);
+
+    // Index of unchanged dictionary must be reused after reopen
+    instance = mf_classic_dict_alloc(MfClassicDictTypeUnitTest);
+    mu_assert(instance != NULL, "mf_classic_dict_alloc\r\n");
+    mu_assert(
+        mf_classic_dict_find_index(instance, key_bytes, &index_dut) &&
+            index_dut == total_keys - 1,
+        "position after reopen assert failed\r\n");
+    mu_assert(!mf_classic_dict_is_index_rebuilt(instance), "index reused assert failed\r\n");
+    mf_classic_dict_free(instance);
+
+    // Same size, different content: index must be rebuilt
+    file_stream = file_stream_alloc(storage);
+    mu_assert(
+        file_stream_open(file_stream, NFC_TEST_DICT_PATH, FSAM_READ_WRITE, FSOM_OPEN_EXISTING),
+        "file_stream_open == true assert failed\r\n");
+    mu_assert(
+        stream_seek(file_stream, -NFC_TEST_DICT_KEY_LEN, StreamOffsetFromEnd),
+        "stream_seek == true assert failed\r\n");
+    stream_write_cstring(file_stream, "B0B1B2B3B4B5");
+    mu_assert(file_stream_close(file_stream), "file_stream_close == true assert failed\r\n");
+    stream_free(file_stream);
+
+    instance = mf_classic_dict_alloc(MfClassicDictTypeUnitTest);
+    mu_assert(instance != NULL, "mf_classic_dict_alloc\r\n");
+    mu_assert(
+        !mf_classic_dict_is_key_present(instance, key_bytes), "replaced key assert failed\r\n");
+    mu_assert(mf_classic_dict_is_index_rebuilt(instance), "index rebuilt assert failed\r\n");
+    nfc_util_num2bytes(0xB0B1B2B3B4B5, 6, key_bytes);
+    mu_assert(
+        mf_classic_dict_find_index(instance, key_bytes, &index_dut) &&
+            index_dut == total_keys - 1,
+        "replacing key position assert failed\r\n");
+    mf_classic_dict_free(instance);
+
+    mu_assert(
+        storage_simply_remove(storage, NFC_TEST_DICT_PATH), "remove == true assert failed\r\n");
+    storage_simply_remove(storage, NFC_TEST_DICT_INDEX_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST(nfca_file_test) {
     NfcDevice* nfc = nfc_device_alloc();
     mu_assert(nfc != NULL, "nfc_device_data != NULL assert failed\r\n");
@@ -715,6 +850,7 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(nfc_digital_signal_test);
     MU_RUN_TEST(mf_classic_dict_test);
     MU_RUN_TEST(mf_classic_dict_load_test);
+    MU_RUN_TEST(mf_classic_dict_index_test);
 
     nfc_test_free();
 }
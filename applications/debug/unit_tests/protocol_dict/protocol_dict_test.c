@@ -9,6 +9,11 @@ typedef enum {
     TestDictProtocolMax,
 } TestDictProtocols;
 
+typedef enum {
+    TestDictFeatureCommon = 1 << 0,
+    TestDictFeature1 = 1 << 1,
+} TestDictFeatures;
+
 /*********************** PROTOCOL 0 START ***********************/
 
 typedef struct {
@@ -104,6 +109,7 @@ static const ProtocolBase protocol_0 = {
     .name = "Protocol 0",
     .manufacturer = "Manufacturer 0",
     .data_size = 4,
+    .features = TestDictFeatureCommon,
     .alloc = (ProtocolAlloc)protocol_0_alloc,
     .free = (ProtocolFree)protocol_0_free,
     .get_data = (ProtocolGetData)protocol_0_get_data,
@@ -123,6 +129,7 @@ static const ProtocolBase protocol_1 = {
     .name = "Protocol 1",
     .manufacturer = "Manufacturer 1",
     .data_size = 8,
+    .features = TestDictFeatureCommon | TestDictFeature1,
     .alloc = (ProtocolAlloc)protocol_1_alloc,
     .free = (ProtocolFree)protocol_1_free,
     .get_data = (ProtocolGetData)protocol_1_get_data,
@@ -212,8 +219,42 @@ MU_TEST(test_protocol_dict) {
     free(data);
 }
 
+MU_TEST(test_protocol_dict_prune) {
+    ProtocolDict* dict = protocol_dict_alloc(test_protocols_base, TestDictProtocolMax);
+
+    protocol_dict_decoders_start(dict);
+    mu_assert_int_eq(TestDictProtocolMax, protocol_dict_decoders_get_active_count(dict));
+
+    protocol_dict_decoders_keep_by_feature(dict, TestDictFeatureCommon);
+    mu_assert_int_eq(TestDictProtocolMax, protocol_dict_decoders_get_active_count(dict));
+
+    // drop protocol 1
+    protocol_dict_decoders_drop_by_feature(dict, TestDictFeature1);
+    mu_assert_int_eq(1, protocol_dict_decoders_get_active_count(dict));
+    mu_assert_int_eq(PROTOCOL_NO, protocol_dict_decoders_feed(dict, true, 543));
+    mu_assert_int_eq(
+        PROTOCOL_NO,
+        protocol_dict_decoders_feed_by_feature(dict, TestDictFeatureCommon, true, 543));
+    mu_assert_int_eq(TestDictProtocol0, protocol_dict_decoders_feed(dict, true, 666));
+
+    // start re-arms protocol 1
+    protocol_dict_decoders_start(dict);
+    mu_assert_int_eq(TestDictProtocolMax, protocol_dict_decoders_get_active_count(dict));
+    mu_assert_int_eq(TestDictProtocol1, protocol_dict_decoders_feed(dict, true, 543));
+
+    // keep protocol 1 only
+    protocol_dict_decoders_start(dict);
+    protocol_dict_decoders_keep_by_feature(dict, TestDictFeature1);
+    mu_assert_int_eq(1, protocol_dict_decoders_get_active_count(dict));
+    mu_assert_int_eq(PROTOCOL_NO, protocol_dict_decoders_feed(dict, true, 666));
+    mu_assert_int_eq(TestDictProtocol1, protocol_dict_decoders_feed(dict, true, 543));
+
+    protocol_dict_free(dict);
+}
+
 MU_TEST_SUITE(test_protocol_dict_suite) {
     MU_RUN_TEST(test_protocol_dict);
+    MU_RUN_TEST(test_protocol_dict_prune);
 }
 
 int run_minunit_test_protocol_dict() {
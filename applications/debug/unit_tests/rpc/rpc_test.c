@@ -16,6 +16,8 @@
 #include <lib/toolbox/md5.h>
 #include <lib/toolbox/path.h>
 #include <cli/cli.h>
+#include <gui/gui.h>
+#include <gui/view_port.h>
 #include <loader/loader.h>
 #include <protobuf_version.h>
 #include <semphr.h>
@@ -44,11 +46,17 @@ static RpcSessionContext rpc_session[TEST_RPC_SESSIONS];
 #define TAG "UnitTestsRpc"
 #define MAX_RECEIVE_OUTPUT_TIMEOUT 3000
 #define MAX_NAME_LENGTH 255
-#define MAX_DATA_SIZE 512u // have to be exact as in rpc_storage.c
+#define MAX_DATA_SIZE RPC_BLOCK_SIZE_DEFAULT // session default block size
+#define BENCHMARK_FILE TEST_DIR "benchmark.bin"
+#define BENCHMARK_FILE_SIZE (64 * 1024)
 #define TEST_DIR TEST_DIR_NAME "/"
 #define TEST_DIR_NAME EXT_PATH("unit_tests_tmp")
 #define MD5SUM_SIZE 16
 
+#define GUI_FRAME_PAGE_SIZE 128
+#define GUI_FRAME_TYPE_KEY 0
+#define GUI_FRAME_TYPE_DELTA 1
+
 #define PING_REQUEST 0
 #define PING_RESPONSE 1
 #define WRITE_REQUEST 0
@@ -724,6 +732,7 @@ static void test_rpc_add_read_to_list_by_reading_real_file(
     File* file = storage_file_alloc(fs_api);
 
     bool result = false;
+    const size_t block_size = rpc_session_get_block_size(rpc_session[0].session);
 
     if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
         size_t size_left = storage_file_size(file);
@@ -737,10 +746,10 @@ static void test_rpc_add_read_to_list_by_reading_real_file(
             response->content.storage_read_response.has_file = true;
 
             response->content.storage_read_response.file.data =
-                malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(MIN(size_left, MAX_DATA_SIZE)));
+                malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(MIN(size_left, block_size)));
             uint8_t* buffer = response->content.storage_read_response.file.data->bytes;
             uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
-            size_t read_size = MIN(size_left, MAX_DATA_SIZE);
+            size_t read_size = MIN(size_left, block_size);
             *read_size_msg = storage_file_read(file, buffer, read_size);
             size_left -= read_size;
             result = (*read_size_msg == read_size);
@@ -924,6 +933,104 @@ MU_TEST(test_storage_read) {
     test_storage_read_run(TEST_DIR "file4.txt", ++command_id);
 }
 
+MU_TEST(test_storage_read_block_size) {
+    test_create_file(TEST_DIR "file1.txt", RPC_BLOCK_SIZE_MAX - 1);
+    test_create_file(TEST_DIR "file2.txt", (RPC_BLOCK_SIZE_MAX * 2) + 1);
+
+    rpc_session_set_block_size(rpc_session[0].session, RPC_BLOCK_SIZE_MAX);
+    test_storage_read_run(TEST_DIR "file1.txt", ++command_id);
+    test_storage_read_run(TEST_DIR "file2.txt", ++command_id);
+
+    rpc_session_set_block_size(rpc_session[0].session, 100);
+    test_storage_read_run(TEST_DIR "file2.txt", ++command_id);
+
+    rpc_session_set_block_size(rpc_session[0].session, RPC_BLOCK_SIZE_DEFAULT);
+}
+
+static void test_storage_benchmark_write(size_t frame_size) {
+    MsgList_t expected_msg_list;
+    MsgList_init(expected_msg_list);
+    test_rpc_add_empty_to_list(expected_msg_list, PB_CommandStatus_OK, ++command_id);
+
+    uint32_t start = furi_get_tick();
+    size_t size_left = BENCHMARK_FILE_SIZE;
+    while(size_left) {
+        size_t data_size = MIN(size_left, frame_size);
+        size_left -= data_size;
+
+        PB_Main request = {
+            .command_id = command_id,
+            .command_status = PB_CommandStatus_OK,
+            .has_next = (size_left > 0),
+            .which_content = PB_Main_storage_write_request_tag,
+        };
+        PB_Storage_WriteRequest* write_request = &request.content.storage_write_request;
+        write_request->path = strdup(BENCHMARK_FILE);
+        write_request->has_file = true;
+        write_request->file.data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(data_size));
+        write_request->file.data->size = data_size;
+        memset(write_request->file.data->bytes, 0x5A, data_size);
+
+        test_rpc_encode_and_feed_one(&request, 0);
+        pb_release(&PB_Main_msg, &request);
+    }
+    test_rpc_decode_and_compare(expected_msg_list, 0);
+    uint32_t time = MAX(furi_get_tick() - start, 1UL);
+
+    printf(
+        "RPC write %zu B frames: %lu KiB/s\r\n",
+        frame_size,
+        (BENCHMARK_FILE_SIZE * 1000UL / 1024) / time);
+
+    test_rpc_free_msg_list(expected_msg_list);
+}
+
+static void test_storage_benchmark_read(size_t block_size) {
+    rpc_session_set_block_size(rpc_session[0].session, block_size);
+
+    PB_Main request;
+    test_rpc_create_simple_message(
+        &request, PB_Main_storage_read_request_tag, BENCHMARK_FILE, ++command_id);
+
+    uint32_t start = furi_get_tick();
+    test_rpc_encode_and_feed_one(&request, 0);
+
+    rpc_session[0].timeout = xTaskGetTickCount() + MAX_RECEIVE_OUTPUT_TIMEOUT;
+    pb_istream_t istream = {
+        .callback = test_rpc_pb_stream_read,
+        .state = &rpc_session[0],
+        .errmsg = NULL,
+        .bytes_left = 0x7FFFFFFF,
+    };
+    PB_Main result = {.cb_content.funcs.decode = NULL};
+
+    size_t bytes_read = 0;
+    bool has_next = true;
+    while(has_next && pb_decode_ex(&istream, &PB_Main_msg, &result, PB_DECODE_DELIMITED)) {
+        mu_assert_int_eq(PB_Main_storage_read_response_tag, result.which_content);
+        bytes_read += result.content.storage_read_response.file.data->size;
+        has_next = result.has_next;
+        pb_release(&PB_Main_msg, &result);
+    }
+    uint32_t time = MAX(furi_get_tick() - start, 1UL);
+    mu_assert_int_eq(BENCHMARK_FILE_SIZE, bytes_read);
+
+    printf(
+        "RPC read %zu B blocks: %lu KiB/s\r\n",
+        block_size,
+        (BENCHMARK_FILE_SIZE * 1000UL / 1024) / time);
+
+    pb_release(&PB_Main_msg, &request);
+    rpc_session_set_block_size(rpc_session[0].session, RPC_BLOCK_SIZE_DEFAULT);
+}
+
+MU_TEST(test_storage_benchmark) {
+    test_storage_benchmark_write(RPC_BLOCK_SIZE_DEFAULT);
+    test_storage_benchmark_write(RPC_BLOCK_SIZE_MAX);
+    test_storage_benchmark_read(RPC_BLOCK_SIZE_DEFAULT);
+    test_storage_benchmark_read(RPC_BLOCK_SIZE_MAX);
+}
+
 static void test_storage_write_run(
     const char* path,
     size_t write_size,
@@ -1394,6 +1501,39 @@ MU_TEST(test_ping) {
     test_rpc_free_msg_list(expected_msg_list);
 }
 
+MU_TEST(test_ping_large) {
+    MsgList_t expected_msg_list;
+    MsgList_init(expected_msg_list);
+
+    RpcSessionStats stats_before;
+    rpc_session_get_stats(rpc_session[0].session, &stats_before);
+
+    /* Response is bigger than session TX buffer and must be sent in chunks */
+    const size_t data_size = 2500;
+    PB_Main request;
+    test_rpc_add_ping_to_list(expected_msg_list, PING_RESPONSE, ++command_id);
+    request.command_id = command_id;
+    request.command_status = PB_CommandStatus_OK;
+    request.cb_content.funcs.decode = NULL;
+    request.has_next = false;
+    request.which_content = PB_Main_system_ping_request_tag;
+    request.content.system_ping_request.data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(data_size));
+    request.content.system_ping_request.data->size = data_size;
+    memset(request.content.system_ping_request.data->bytes, 0xA5, data_size);
+
+    test_rpc_encode_and_feed_one(&request, 0);
+    pb_release(&PB_Main_msg, &request);
+    test_rpc_decode_and_compare(expected_msg_list, 0);
+
+    RpcSessionStats stats_after;
+    rpc_session_get_stats(rpc_session[0].session, &stats_after);
+    mu_assert_int_eq(1, stats_after.messages - stats_before.messages);
+    mu_check((stats_after.bytes - stats_before.bytes) > data_size);
+    mu_check((stats_after.chunks - stats_before.chunks) > 1);
+
+    test_rpc_free_msg_list(expected_msg_list);
+}
+
 MU_TEST(test_system_protobuf_version) {
     MsgList_t expected_msg_list;
     MsgList_init(expected_msg_list);
@@ -1420,13 +1560,241 @@ MU_TEST(test_system_protobuf_version) {
     test_rpc_free_msg_list(expected_msg_list);
 }
 
+typedef enum {
+    TestRpcGuiPatternBlank,
+    TestRpcGuiPatternBox,
+    TestRpcGuiPatternFilled,
+    TestRpcGuiPatternFilledBox,
+} TestRpcGuiPattern;
+
+typedef struct {
+    FuriMutex* mutex;
+    uint8_t* framebuffer; // last frame committed by gui
+    uint8_t* frame; // frame decoded from stream
+    size_t size;
+    TestRpcGuiPattern pattern;
+    uint32_t keyframes;
+    uint32_t deltas;
+} TestRpcGuiStream;
+
+static void test_rpc_gui_draw_callback(Canvas* canvas, void* context) {
+    TestRpcGuiStream* stream = context;
+    canvas_clear(canvas);
+    canvas_set_color(canvas, ColorBlack);
+
+    switch(stream->pattern) {
+    case TestRpcGuiPatternBox:
+        canvas_draw_box(canvas, 10, 10, 5, 5);
+        break;
+    case TestRpcGuiPatternFilled:
+        // Every byte changes, delta is bigger than keyframe
+        canvas_draw_box(canvas, 0, 0, canvas_width(canvas), canvas_height(canvas));
+        break;
+    case TestRpcGuiPatternFilledBox:
+        canvas_draw_box(canvas, 0, 0, canvas_width(canvas), canvas_height(canvas));
+        canvas_set_color(canvas, ColorWhite);
+        canvas_draw_box(canvas, 20, 20, 8, 8);
+        break;
+    default:
+        break;
+    }
+}
+
+static void test_rpc_gui_framebuffer_callback(
+    uint8_t* data,
+    size_t size,
+    CanvasOrientation orientation,
+    void* context) {
+    UNUSED(orientation);
+    TestRpcGuiStream* stream = context;
+    furi_check(size == stream->size);
+
+    furi_mutex_acquire(stream->mutex, FuriWaitForever);
+    memcpy(stream->framebuffer, data, size);
+    furi_mutex_release(stream->mutex);
+}
+
+/* Client side of delta encoded screen stream, see rpc_gui.c for the format */
+static bool test_rpc_gui_apply_frame(TestRpcGuiStream* stream, const pb_bytes_array_t* data) {
+    if(!data || data->size < 1) return false;
+
+    if(data->bytes[0] == GUI_FRAME_TYPE_KEY) {
+        if(data->size != stream->size + 1) return false;
+        memcpy(stream->frame, &data->bytes[1], stream->size);
+        stream->keyframes++;
+        return true;
+    }
+
+    // Delta is useless without keyframe to apply it to
+    if(data->bytes[0] != GUI_FRAME_TYPE_DELTA || data->size < 2 || !stream->keyframes) {
+        return false;
+    }
+
+    size_t position = 2;
+    for(size_t page = 0; page < stream->size / GUI_FRAME_PAGE_SIZE; page++) {
+        if(!(data->bytes[1] & (1 << page))) continue;
+
+        uint8_t* out = &stream->frame[page * GUI_FRAME_PAGE_SIZE];
+        size_t i = 0;
+        while(i < GUI_FRAME_PAGE_SIZE) {
+            if(position >= data->size) return false;
+            uint8_t control = data->bytes[position++];
+            size_t run = (control & 0x7F) + 1;
+            if(i + run > GUI_FRAME_PAGE_SIZE) return false;
+            if(!(control & 0x80)) {
+                if(position + run > data->size) return false;
+                for(size_t j = 0; j < run; j++) {
+                    out[i + j] ^= data->bytes[position++];
+                }
+            }
+            i += run;
+        }
+    }
+    stream->deltas++;
+
+    return position == data->size;
+}
+
+static pb_istream_t test_rpc_gui_istream(void) {
+    rpc_session[0].timeout = xTaskGetTickCount() + MAX_RECEIVE_OUTPUT_TIMEOUT;
+    pb_istream_t istream = {
+        .callback = test_rpc_pb_stream_read,
+        .state = &rpc_session[0],
+        .errmsg = NULL,
+        .bytes_left = 0x7FFFFFFF,
+    };
+    return istream;
+}
+
+/* Receives frames until decoded frame is the same as gui framebuffer */
+static bool test_rpc_gui_receive_frames(TestRpcGuiStream* stream) {
+    pb_istream_t istream = test_rpc_gui_istream();
+    PB_Main result = {.cb_content.funcs.decode = NULL};
+    bool synced = false;
+
+    while(!synced && pb_decode_ex(&istream, &PB_Main_msg, &result, PB_DECODE_DELIMITED)) {
+        bool applied = (result.which_content == PB_Main_gui_screen_frame_tag) &&
+                       test_rpc_gui_apply_frame(stream, result.content.gui_screen_frame.data);
+        pb_release(&PB_Main_msg, &result);
+        if(!applied) break;
+
+        furi_mutex_acquire(stream->mutex, FuriWaitForever);
+        synced = memcmp(stream->frame, stream->framebuffer, stream->size) == 0;
+        furi_mutex_release(stream->mutex);
+    }
+
+    return synced;
+}
+
+/* Skips frames sent before response */
+static PB_CommandStatus test_rpc_gui_receive_response(uint32_t command_id) {
+    pb_istream_t istream = test_rpc_gui_istream();
+    PB_Main result = {.cb_content.funcs.decode = NULL};
+    PB_CommandStatus status = PB_CommandStatus_ERROR;
+
+    while(pb_decode_ex(&istream, &PB_Main_msg, &result, PB_DECODE_DELIMITED)) {
+        bool is_response = (result.which_content != PB_Main_gui_screen_frame_tag) &&
+                           (result.command_id == command_id);
+        status = result.command_status;
+        pb_release(&PB_Main_msg, &result);
+        if(is_response) return status;
+    }
+
+    return PB_CommandStatus_ERROR;
+}
+
+static void test_rpc_gui_send_request(uint16_t tag) {
+    PB_Main request = {
+        .command_id = ++command_id,
+        .command_status = PB_CommandStatus_OK,
+        .cb_content.funcs.decode = NULL,
+        .has_next = false,
+        .which_content = tag,
+    };
+    test_rpc_encode_and_feed_one(&request, 0);
+}
+
+static bool
+    test_rpc_gui_show(TestRpcGuiStream* stream, ViewPort* view_port, TestRpcGuiPattern pattern) {
+    stream->pattern = pattern;
+    view_port_update(view_port);
+    return test_rpc_gui_receive_frames(stream);
+}
+
+static void test_rpc_gui_stream_run(TestRpcGuiStream* stream, ViewPort* view_port) {
+    const char* sync_error = "decoded frame differs from framebuffer";
+
+    test_rpc_gui_send_request(PB_Main_gui_start_screen_stream_request_tag);
+    mu_assert_int_eq(PB_CommandStatus_OK, test_rpc_gui_receive_response(command_id));
+
+    // Stream starts with keyframe
+    mu_assert(test_rpc_gui_show(stream, view_port, TestRpcGuiPatternBlank), sync_error);
+    mu_assert_int_eq(1, stream->keyframes);
+
+    mu_assert(test_rpc_gui_show(stream, view_port, TestRpcGuiPatternBox), sync_error);
+    mu_assert_int_eq(1, stream->keyframes);
+    mu_assert(stream->deltas > 0, "no delta frame");
+
+    // Delta is not smaller than keyframe, keyframe is sent instead
+    mu_assert(test_rpc_gui_show(stream, view_port, TestRpcGuiPatternFilled), sync_error);
+    mu_assert_int_eq(2, stream->keyframes);
+
+    uint32_t deltas = stream->deltas;
+    mu_assert(test_rpc_gui_show(stream, view_port, TestRpcGuiPatternFilledBox), sync_error);
+    mu_assert_int_eq(2, stream->keyframes);
+    mu_assert(stream->deltas > deltas, "no delta frame after keyframe");
+}
+
+MU_TEST(test_gui_screen_stream_delta) {
+    Gui* gui = furi_record_open(RECORD_GUI);
+    TestRpcGuiStream* stream = malloc(sizeof(TestRpcGuiStream));
+    stream->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    stream->size = gui_get_framebuffer_size(gui);
+    stream->framebuffer = malloc(stream->size);
+    stream->frame = malloc(stream->size);
+    stream->pattern = TestRpcGuiPatternBlank;
+
+    // Fullscreen view port owns the whole framebuffer
+    ViewPort* view_port = view_port_alloc();
+    view_port_draw_callback_set(view_port, test_rpc_gui_draw_callback, stream);
+    gui_add_view_port(gui, view_port, GuiLayerFullscreen);
+    gui_add_framebuffer_callback(gui, test_rpc_gui_framebuffer_callback, stream);
+
+    rpc_session_set_options(rpc_session[0].session, RpcSessionOptionScreenStreamDelta);
+    test_rpc_gui_stream_run(stream, view_port);
+
+    // Cleanup runs on failures too, so later tests get gui and session back
+    test_rpc_gui_send_request(PB_Main_gui_stop_screen_stream_request_tag);
+    PB_CommandStatus stop_status = test_rpc_gui_receive_response(command_id);
+    rpc_session_set_options(rpc_session[0].session, 0);
+
+    gui_remove_framebuffer_callback(gui, test_rpc_gui_framebuffer_callback, stream);
+    gui_remove_view_port(gui, view_port);
+    view_port_free(view_port);
+    furi_record_close(RECORD_GUI);
+
+    furi_mutex_free(stream->mutex);
+    free(stream->framebuffer);
+    free(stream->frame);
+    free(stream);
+
+    mu_assert_int_eq(PB_CommandStatus_OK, stop_status);
+}
+
 MU_TEST_SUITE(test_rpc_system) {
     MU_SUITE_CONFIGURE(&test_rpc_setup, &test_rpc_teardown);
 
     MU_RUN_TEST(test_ping);
+    MU_RUN_TEST(test_ping_large);
     MU_RUN_TEST(test_system_protobuf_version);
 }
 
+MU_TEST_SUITE(test_rpc_gui) {
+    MU_SUITE_CONFIGURE(&test_rpc_setup, &test_rpc_teardown);
+
+    MU_RUN_TEST(test_gui_screen_stream_delta);
+}
+
 MU_TEST_SUITE(test_rpc_storage) {
     MU_SUITE_CONFIGURE(&test_rpc_storage_setup, &test_rpc_storage_teardown);
 
@@ -1434,6 +1802,7 @@ MU_TEST_SUITE(test_rpc_storage) {
     MU_RUN_TEST(test_storage_stat);
     MU_RUN_TEST(test_storage_list);
     MU_RUN_TEST(test_storage_read);
+    MU_RUN_TEST(test_storage_read_block_size);
     MU_RUN_TEST(test_storage_write_read);
     MU_RUN_TEST(test_storage_write);
     MU_RUN_TEST(test_storage_delete);
@@ -1441,6 +1810,7 @@ MU_TEST_SUITE(test_rpc_storage) {
     MU_RUN_TEST(test_storage_mkdir);
     MU_RUN_TEST(test_storage_md5sum);
     MU_RUN_TEST(test_storage_rename);
+    MU_RUN_TEST(test_storage_benchmark);
 
     DISABLE_TEST(MU_RUN_TEST(test_storage_interrupt_continuous_same_system););
     MU_RUN_TEST(test_storage_interrupt_continuous_another_system);
@@ -1785,6 +2155,7 @@ int run_minunit_test_rpc() {
     }
     furi_record_close(RECORD_STORAGE);
     MU_RUN_SUITE(test_rpc_system);
+    MU_RUN_SUITE(test_rpc_gui);
     MU_RUN_SUITE(test_rpc_app);
     MU_RUN_SUITE(test_rpc_session);
 
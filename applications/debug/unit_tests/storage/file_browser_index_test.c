@@ -0,0 +1,335 @@
+#include "../minunit.h"
+#include <furi.h>
+#include <storage/storage.h>
+#include <gui/modules/file_browser_index.h>
+
+#define BROWSER_INDEX_TEST_DIR EXT_PATH("unit_tests/browser_index")
+#define BROWSER_INDEX_TEST_KEY BROWSER_INDEX_TEST_DIR "|.txt|001"
+#define BROWSER_INDEX_TEST_KEY_ALT BROWSER_INDEX_TEST_DIR "|.txt|000"
+#define BROWSER_INDEX_TEST_KEY_MISSING BROWSER_INDEX_TEST_DIR "/missing|.txt|001"
+
+typedef struct {
+    const char* name;
+    bool is_folder;
+} BrowserIndexTestEntry;
+
+static const BrowserIndexTestEntry browser_index_test_entries[] = {
+    {"beta.txt", false},
+    {"Alpha.txt", false},
+    {"gamma", true},
+    {"alpha.txt", false},
+    {"Delta", true},
+    {"charlie.txt", false},
+};
+
+// Folders first, names compared case-insensitively, then by case
+static const BrowserIndexTestEntry browser_index_test_dirs_first[] = {
+    {"Delta", true},
+    {"gamma", true},
+    {"Alpha.txt", false},
+    {"alpha.txt", false},
+    {"beta.txt", false},
+    {"charlie.txt", false},
+};
+
+static const BrowserIndexTestEntry browser_index_test_mixed[] = {
+    {"Alpha.txt", false},
+    {"alpha.txt", false},
+    {"beta.txt", false},
+    {"charlie.txt", false},
+    {"Delta", true},
+    {"gamma", true},
+};
+
+// browser_index_test_dirs_first with beta.txt removed and alpha.txt renamed to zulu.txt
+static const BrowserIndexTestEntry browser_index_test_updated[] = {
+    {"Delta", true},
+    {"gamma", true},
+    {"Alpha.txt", false},
+    {"charlie.txt", false},
+    {"zulu.txt", false},
+};
+
+static uint32_t
+    browser_index_test_fingerprint(const BrowserIndexTestEntry* entries, size_t count) {
+    uint32_t fingerprint = 0;
+    for(size_t i = 0; i < count; i++) {
+        fingerprint += browser_index_entry_hash(entries[i].name, entries[i].is_folder);
+    }
+    return fingerprint;
+}
+
+// Index file name is FNV-1a hash of the key
+static void browser_index_test_get_path(FuriString* path, const char* key) {
+    uint32_t hash = 2166136261UL;
+    for(size_t i = 0; key[i]; i++) {
+        hash ^= (uint8_t)key[i];
+        hash *= 16777619UL;
+    }
+    furi_string_printf(path, "%s/%08lX.idx", BROWSER_INDEX_DIR, hash);
+}
+
+static bool browser_index_test_save(Storage* storage, const char* key, bool dirs_first) {
+    BrowserIndexBuilder* builder = browser_index_builder_alloc();
+    bool result = true;
+    for(size_t i = 0; result && (i < COUNT_OF(browser_index_test_entries)); i++) {
+        result = browser_index_builder_add(
+            builder, browser_index_test_entries[i].name, browser_index_test_entries[i].is_folder);
+    }
+    result = result && browser_index_builder_save(builder, storage, key, dirs_first);
+    browser_index_builder_free(builder);
+    return result;
+}
+
+static void browser_index_test_check_order(
+    BrowserIndex* index,
+    uint32_t offset,
+    const BrowserIndexTestEntry* expected,
+    size_t count) {
+    FuriString* name = furi_string_alloc();
+    bool is_folder = false;
+
+    mu_check(browser_index_seek(index, offset));
+    for(size_t i = offset; i < count; i++) {
+        mu_assert(browser_index_read_next(index, name, &is_folder), "entry read failed");
+        mu_assert_string_eq(expected[i].name, furi_string_get_cstr(name));
+        mu_assert_int_eq(expected[i].is_folder, is_folder);
+    }
+    mu_assert(!browser_index_read_next(index, name, &is_folder), "read past last entry");
+
+    furi_string_free(name);
+}
+
+MU_TEST_1(browser_index_test_build_reopen, Storage* storage) {
+    mu_check(browser_index_test_save(storage, BROWSER_INDEX_TEST_KEY, true));
+
+    BrowserIndex* index = browser_index_alloc(storage);
+    mu_check(browser_index_open(index, BROWSER_INDEX_TEST_KEY, true));
+    mu_check(browser_index_is_open(index));
+    mu_assert_int_eq(COUNT_OF(browser_index_test_entries), browser_index_get_count(index));
+    mu_assert_int_eq(
+        browser_index_test_fingerprint(
+            browser_index_test_entries, COUNT_OF(browser_index_test_entries)),
+        browser_index_get_fingerprint(index));
+    browser_index_free(index);
+
+    // Saved index is reused by a new reader
+    index = browser_index_alloc(storage);
+    mu_check(browser_index_open(index, BROWSER_INDEX_TEST_KEY, true));
+    mu_assert_int_eq(COUNT_OF(browser_index_test_entries), browser_index_get_count(index));
+    browser_index_close(index);
+    mu_check(!browser_index_is_open(index));
+    mu_assert_int_eq(0, browser_index_get_count(index));
+    browser_index_free(index);
+}
+
+MU_TEST_1(browser_index_test_seek_read, Storage* storage) {
+    BrowserIndex* index = browser_index_alloc(storage);
+    size_t count = COUNT_OF(browser_index_test_entries);
+
+    mu_check(browser_index_test_save(storage, BROWSER_INDEX_TEST_KEY, true));
+    mu_check(browser_index_open(index, BROWSER_INDEX_TEST_KEY, true));
+    browser_index_test_check_order(index, 0, browser_index_test_dirs_first, count);
+    browser_index_test_check_order(index, 3, browser_index_test_dirs_first, count);
+    browser_index_test_check_order(index, count, browser_index_test_dirs_first, count);
+    mu_check(!browser_index_seek(index, count + 1));
+
+    mu_check(browser_index_test_save(storage, BROWSER_INDEX_TEST_KEY_ALT, false));
+    mu_check(browser_index_open(index, BROWSER_INDEX_TEST_KEY_ALT, false));
+    browser_index_test_check_order(index, 0, browser_index_test_mixed, count);
+
+    browser_index_free(index);
+}
+
+MU_TEST_1(browser_index_test_find, Storage* storage) {
+    BrowserIndex* index = browser_index_alloc(storage);
+
+    mu_check(browser_index_test_save(storage, BROWSER_INDEX_TEST_KEY, true));
+    mu_check(browser_index_open(index, BROWSER_INDEX_TEST_KEY, true));
+    for(size_t i = 0; i < COUNT_OF(browser_index_test_dirs_first); i++) {
+        mu_assert_int_eq(
+            i,
+            browser_index_find(
+                index,
+                browser_index_test_dirs_first[i].name,
+                browser_index_test_dirs_first[i].is_folder));
+    }
+    mu_assert_int_eq(-1, browser_index_find(index, "gamma", false));
+    mu_assert_int_eq(-1, browser_index_find(index, "beta.txt", true));
+    mu_assert_int_eq(-1, browser_index_find(index, "ALPHA.txt", false));
+    mu_assert_int_eq(-1, browser_index_find(index, "omega.txt", false));
+
+    mu_check(browser_index_test_save(storage, BROWSER_INDEX_TEST_KEY_ALT, false));
+    mu_check(browser_index_open(index, BROWSER_INDEX_TEST_KEY_ALT, false));
+    for(size_t i = 0; i < COUNT_OF(browser_index_test_mixed); i++) {
+        mu_assert_int_eq(
+            i,
+            browser_index_find(
+                index, browser_index_test_mixed[i].name, browser_index_test_mixed[i].is_folder));
+    }
+
+    browser_index_close(index);
+    mu_assert_int_eq(-1, browser_index_find(index, "gamma", true));
+    browser_index_free(index);
+}
+
+MU_TEST_1(browser_index_test_mismatch, Storage* storage) {
+    BrowserIndex* index = browser_index_alloc(storage);
+
+    mu_check(browser_index_test_save(storage, BROWSER_INDEX_TEST_KEY, true));
+    browser_index_remove(storage, BROWSER_INDEX_TEST_KEY_ALT);
+    mu_check(!browser_index_open(index, BROWSER_INDEX_TEST_KEY_ALT, true));
+    mu_check(!browser_index_open(index, BROWSER_INDEX_TEST_DIR, true));
+    mu_check(!browser_index_is_open(index));
+
+    // Worker rebuilds index when folder fingerprint differs
+    mu_check(browser_index_open(index, BROWSER_INDEX_TEST_KEY, true));
+    uint32_t fingerprint = browser_index_get_fingerprint(index);
+    mu_check(
+        fingerprint != browser_index_test_fingerprint(
+                           browser_index_test_updated, COUNT_OF(browser_index_test_updated)));
+    mu_check(
+        browser_index_entry_hash("gamma", true) != browser_index_entry_hash("gamma", false));
+    mu_check(
+        browser_index_entry_hash("beta.txt", false) !=
+        browser_index_entry_hash("Beta.txt", false));
+
+    // Overflowed builder never replaces index
+    BrowserIndexBuilder* builder = browser_index_builder_alloc();
+    char name[300];
+    memset(name, 'a', sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    mu_check(!browser_index_builder_add(builder, name, false));
+    mu_check(!browser_index_builder_add(builder, "delta.txt", false));
+    mu_check(!browser_index_builder_save(builder, storage, BROWSER_INDEX_TEST_KEY_ALT, true));
+    browser_index_builder_free(builder);
+    mu_check(!browser_index_open(index, BROWSER_INDEX_TEST_KEY_ALT, true));
+
+    browser_index_remove(storage, BROWSER_INDEX_TEST_KEY);
+    mu_check(!browser_index_open(index, BROWSER_INDEX_TEST_KEY, true));
+
+    browser_index_free(index);
+}
+
+MU_TEST_1(browser_index_test_foreign_file, Storage* storage) {
+    BrowserIndex* index = browser_index_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    FuriString* path_alt = furi_string_alloc();
+    browser_index_test_get_path(path, BROWSER_INDEX_TEST_KEY);
+    browser_index_test_get_path(path_alt, BROWSER_INDEX_TEST_KEY_ALT);
+
+    // Index of another key of the same length, as on file name collision
+    browser_index_remove(storage, BROWSER_INDEX_TEST_KEY);
+    mu_check(browser_index_test_save(storage, BROWSER_INDEX_TEST_KEY_ALT, true));
+    mu_check(browser_index_open(index, BROWSER_INDEX_TEST_KEY_ALT, true));
+    browser_index_close(index);
+    mu_assert_int_eq(
+        FSE_OK,
+        storage_common_rename(
+            storage, furi_string_get_cstr(path_alt), furi_string_get_cstr(path)));
+    mu_check(!browser_index_open(index, BROWSER_INDEX_TEST_KEY, true));
+    mu_check(!browser_index_is_open(index));
+
+    // Unknown format
+    File* file = storage_file_alloc(storage);
+    mu_check(
+        storage_file_open(file, furi_string_get_cstr(path), FSAM_READ_WRITE, FSOM_OPEN_EXISTING));
+    mu_check(storage_file_write(file, "XXXX", 4) == 4);
+    storage_file_close(file);
+    storage_file_free(file);
+    mu_check(!browser_index_open(index, BROWSER_INDEX_TEST_KEY, true));
+    browser_index_prune(storage, NULL);
+    mu_check(!storage_file_exists(storage, furi_string_get_cstr(path)));
+
+    furi_string_free(path_alt);
+    furi_string_free(path);
+    browser_index_free(index);
+}
+
+MU_TEST_1(browser_index_test_update, Storage* storage) {
+    BrowserIndex* index = browser_index_alloc(storage);
+    BrowserIndexBuilder* builder = browser_index_builder_alloc();
+
+    mu_check(browser_index_test_save(storage, BROWSER_INDEX_TEST_KEY, true));
+    mu_check(browser_index_open(index, BROWSER_INDEX_TEST_KEY, true));
+
+    // Remove, the way worker applies file operations to open index
+    mu_check(browser_index_builder_add_index(builder, index, "beta.txt"));
+    browser_index_close(index);
+    mu_check(browser_index_builder_save(builder, storage, BROWSER_INDEX_TEST_KEY, true));
+    browser_index_builder_free(builder);
+    mu_check(browser_index_open(index, BROWSER_INDEX_TEST_KEY, true));
+    mu_assert_int_eq(COUNT_OF(browser_index_test_entries) - 1, browser_index_get_count(index));
+    mu_assert_int_eq(-1, browser_index_find(index, "beta.txt", false));
+
+    // Rename
+    builder = browser_index_builder_alloc();
+    mu_check(browser_index_builder_add_index(builder, index, "alpha.txt"));
+    mu_check(browser_index_builder_add(builder, "zulu.txt", false));
+    browser_index_close(index);
+    mu_check(browser_index_builder_save(builder, storage, BROWSER_INDEX_TEST_KEY, true));
+    browser_index_builder_free(builder);
+
+    mu_check(browser_index_open(index, BROWSER_INDEX_TEST_KEY, true));
+    size_t count = COUNT_OF(browser_index_test_updated);
+    mu_assert_int_eq(count, browser_index_get_count(index));
+    mu_assert_int_eq(
+        browser_index_test_fingerprint(browser_index_test_updated, count),
+        browser_index_get_fingerprint(index));
+    browser_index_test_check_order(index, 0, browser_index_test_updated, count);
+    mu_assert_int_eq(count - 1, browser_index_find(index, "zulu.txt", false));
+    mu_assert_int_eq(-1, browser_index_find(index, "alpha.txt", false));
+
+    browser_index_free(index);
+}
+
+MU_TEST_1(browser_index_test_prune, Storage* storage) {
+    BrowserIndex* index = browser_index_alloc(storage);
+
+    mu_check(browser_index_test_save(storage, BROWSER_INDEX_TEST_KEY, true));
+    mu_check(browser_index_test_save(storage, BROWSER_INDEX_TEST_KEY_MISSING, true));
+
+    // Index being built is kept even if its folder is missing
+    browser_index_prune(storage, BROWSER_INDEX_TEST_KEY_MISSING);
+    mu_check(browser_index_open(index, BROWSER_INDEX_TEST_KEY, true));
+    mu_check(browser_index_open(index, BROWSER_INDEX_TEST_KEY_MISSING, true));
+    browser_index_close(index);
+
+    browser_index_prune(storage, NULL);
+    mu_check(browser_index_open(index, BROWSER_INDEX_TEST_KEY, true));
+    mu_check(!browser_index_open(index, BROWSER_INDEX_TEST_KEY_MISSING, true));
+
+    // Index of removed folder is pruned
+    browser_index_close(index);
+    mu_check(storage_simply_remove_recursive(storage, BROWSER_INDEX_TEST_DIR));
+    browser_index_prune(storage, NULL);
+    mu_check(!browser_index_open(index, BROWSER_INDEX_TEST_KEY, true));
+    mu_check(storage_simply_mkdir(storage, BROWSER_INDEX_TEST_DIR));
+
+    browser_index_free(index);
+}
+
+MU_TEST_SUITE(test_file_browser_index_suite) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_mkdir(storage, EXT_PATH("unit_tests"));
+    storage_simply_mkdir(storage, BROWSER_INDEX_TEST_DIR);
+
+    MU_RUN_TEST_1(browser_index_test_build_reopen, storage);
+    MU_RUN_TEST_1(browser_index_test_seek_read, storage);
+    MU_RUN_TEST_1(browser_index_test_find, storage);
+    MU_RUN_TEST_1(browser_index_test_mismatch, storage);
+    MU_RUN_TEST_1(browser_index_test_foreign_file, storage);
+    MU_RUN_TEST_1(browser_index_test_update, storage);
+    MU_RUN_TEST_1(browser_index_test_prune, storage);
+
+    browser_index_remove(storage, BROWSER_INDEX_TEST_KEY);
+    browser_index_remove(storage, BROWSER_INDEX_TEST_KEY_ALT);
+    browser_index_remove(storage, BROWSER_INDEX_TEST_KEY_MISSING);
+    storage_simply_remove_recursive(storage, BROWSER_INDEX_TEST_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
+int run_minunit_test_file_browser_index() {
+    MU_RUN_SUITE(test_file_browser_index_suite);
+    return MU_EXIT_CODE;
+}
@@ -115,11 +115,88 @@ MU_TEST(storage_file_open_close) {
     furi_record_close(RECORD_STORAGE);
 }
 
+#define STORAGE_BUFFERED_FILE EXT_PATH("buffered_file.test")
+#define STORAGE_BUFFERED_FILE_SIZE 5000
+#define STORAGE_BUFFERED_WRITE_CHUNK 10
+#define STORAGE_BUFFERED_READ_CHUNK 7
+
+static uint8_t storage_buffered_byte(size_t position) {
+    return (position * 31 + position / 256) & 0xFF;
+}
+
+MU_TEST(storage_file_buffered_io) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    uint8_t data[STORAGE_BUFFERED_WRITE_CHUNK];
+    StorageIoStats stats_before, stats_after;
+
+    storage_simply_remove(storage, STORAGE_BUFFERED_FILE);
+    mu_check(storage_common_io_stats(storage, STORAGE_EXT_PATH_PREFIX, &stats_before) == FSE_OK);
+
+    // Small sequential writes, position and size must account pending data
+    mu_check(storage_file_open(file, STORAGE_BUFFERED_FILE, FSAM_READ_WRITE, FSOM_CREATE_NEW));
+    for(size_t position = 0; position < STORAGE_BUFFERED_FILE_SIZE; position += sizeof(data)) {
+        for(size_t i = 0; i < sizeof(data); i++) {
+            data[i] = storage_buffered_byte(position + i);
+        }
+        mu_assert_int_eq(sizeof(data), storage_file_write(file, data, sizeof(data)));
+        mu_assert_int_eq(position + sizeof(data), storage_file_tell(file));
+    }
+    mu_assert_int_eq(STORAGE_BUFFERED_FILE_SIZE, storage_file_size(file));
+    mu_check(storage_file_sync(file));
+
+    // Small sequential reads with skips inside and outside of read ahead data
+    mu_check(storage_file_seek(file, 0, true));
+    size_t position = 0;
+    for(size_t reads = 1; position < STORAGE_BUFFERED_FILE_SIZE; reads++) {
+        uint16_t read = storage_file_read(file, data, STORAGE_BUFFERED_READ_CHUNK);
+        mu_check(read > 0);
+        for(size_t i = 0; i < read; i++) {
+            mu_assert_int_eq(storage_buffered_byte(position + i), data[i]);
+        }
+        position += read;
+
+        if(reads % 50 == 0) {
+            uint32_t skip = (reads % 100) ? 3 : 500;
+            mu_check(storage_file_seek(file, skip, false));
+            position += skip;
+        }
+        mu_assert_int_eq(position, storage_file_tell(file));
+    }
+    mu_check(storage_file_eof(file));
+
+    // Write after read ahead goes to the client position
+    mu_check(storage_file_seek(file, 100, true));
+    for(size_t i = 0; i < 3; i++) {
+        mu_assert_int_eq(
+            STORAGE_BUFFERED_READ_CHUNK,
+            storage_file_read(file, data, STORAGE_BUFFERED_READ_CHUNK));
+    }
+    mu_assert_int_eq(1, storage_file_write(file, "X", 1));
+    mu_check(storage_file_seek(file, 100 + STORAGE_BUFFERED_READ_CHUNK * 3, true));
+    mu_assert_int_eq(1, storage_file_read(file, data, 1));
+    mu_assert_int_eq('X', data[0]);
+
+    mu_check(storage_file_close(file));
+    mu_check(storage_common_io_stats(storage, STORAGE_EXT_PATH_PREFIX, &stats_after) == FSE_OK);
+
+    uint32_t requests = stats_after.read_requests - stats_before.read_requests +
+                        stats_after.write_requests - stats_before.write_requests;
+    uint32_t transactions = stats_after.read_transactions - stats_before.read_transactions +
+                            stats_after.write_transactions - stats_before.write_transactions;
+    mu_check(transactions < requests / 4);
+
+    storage_file_free(file);
+    mu_check(storage_simply_remove(storage, STORAGE_BUFFERED_FILE));
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(storage_file) {
     storage_file_open_lock_setup();
     MU_RUN_TEST(storage_file_open_close);
     MU_RUN_TEST(storage_file_open_lock);
     storage_file_open_lock_teardown();
+    MU_RUN_TEST(storage_file_buffered_io);
 }
 
 MU_TEST(storage_dir_open_close) {
@@ -194,10 +271,98 @@ MU_TEST(storage_dir_exists_test) {
     furi_record_close(RECORD_STORAGE);
 }
 
+MU_TEST(storage_dir_read_batch_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* dir = storage_file_alloc(storage);
+
+    mu_assert_int_eq(FSE_OK, storage_common_mkdir(storage, STORAGE_TEST_DIR));
+    mu_assert_int_eq(FSE_OK, storage_common_mkdir(storage, STORAGE_TEST_DIR "/folder"));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/1.sub", "1"));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/2.nfc", "2"));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/3.sub", "3"));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/4.sub.bak", "4"));
+
+    char names[2][32];
+    StorageDirEntry entries[2] = {{.name = names[0]}, {.name = names[1]}};
+
+    // Unfiltered, last batch is incomplete
+    mu_check(storage_dir_open(dir, STORAGE_TEST_DIR));
+    mu_assert_int_eq(2, storage_dir_read_batch(dir, entries, 2, sizeof(names[0]), NULL));
+    mu_assert_int_eq(FSE_OK, storage_file_get_error(dir));
+    mu_assert_int_eq(2, storage_dir_read_batch(dir, entries, 2, sizeof(names[0]), NULL));
+    mu_assert_int_eq(1, storage_dir_read_batch(dir, entries, 2, sizeof(names[0]), NULL));
+    mu_assert_int_eq(FSE_NOT_EXIST, storage_file_get_error(dir));
+    mu_assert_int_eq(0, storage_dir_read_batch(dir, entries, 2, sizeof(names[0]), NULL));
+    storage_dir_close(dir);
+
+    // Filtered by extension, folders are kept
+    size_t total = 0;
+    size_t read_count = 0;
+    mu_check(storage_dir_open(dir, STORAGE_TEST_DIR));
+    do {
+        read_count = storage_dir_read_batch(dir, entries, 2, sizeof(names[0]), ".sub");
+        for(size_t i = 0; i < read_count; i++) {
+            mu_check(
+                file_info_is_dir(&entries[i].fileinfo) ||
+                (strcmp(entries[i].name, "1.sub") == 0) ||
+                (strcmp(entries[i].name, "3.sub") == 0));
+        }
+        total += read_count;
+    } while(read_count == 2);
+    mu_assert_int_eq(FSE_NOT_EXIST, storage_file_get_error(dir));
+    mu_assert_int_eq(3, total);
+    storage_dir_close(dir);
+
+    storage_file_free(dir);
+    storage_simply_remove_recursive(storage, STORAGE_TEST_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_dir_tell_seek_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* dir = storage_file_alloc(storage);
+
+    mu_assert_int_eq(FSE_OK, storage_common_mkdir(storage, STORAGE_TEST_DIR));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/1", "1"));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/2", "2"));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/3", "3"));
+
+    char name[32];
+    char name_after_tell[32];
+
+    mu_check(storage_dir_open(dir, STORAGE_TEST_DIR));
+    mu_check(storage_dir_read(dir, NULL, name, sizeof(name)));
+    uint32_t position = storage_dir_tell(dir);
+    mu_assert_int_eq(FSE_OK, storage_file_get_error(dir));
+    mu_check(storage_dir_read(dir, NULL, name_after_tell, sizeof(name_after_tell)));
+    mu_check(storage_dir_read(dir, NULL, name, sizeof(name)));
+
+    // Seek back returns the same entry again
+    mu_check(storage_dir_seek(dir, position));
+    mu_check(storage_dir_read(dir, NULL, name, sizeof(name)));
+    mu_assert_string_eq(name_after_tell, name);
+
+    // Position at the end stays at the end
+    while(storage_dir_read(dir, NULL, name, sizeof(name)))
+        ;
+    position = storage_dir_tell(dir);
+    mu_check(storage_dir_rewind(dir));
+    mu_check(storage_dir_seek(dir, position));
+    mu_check(!storage_dir_read(dir, NULL, name, sizeof(name)));
+    mu_assert_int_eq(FSE_NOT_EXIST, storage_file_get_error(dir));
+    storage_dir_close(dir);
+
+    storage_file_free(dir);
+    storage_simply_remove_recursive(storage, STORAGE_TEST_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(storage_dir) {
     MU_RUN_TEST(storage_dir_open_close);
     MU_RUN_TEST(storage_dir_open_lock);
     MU_RUN_TEST(storage_dir_exists_test);
+    MU_RUN_TEST(storage_dir_read_batch_test);
+    MU_RUN_TEST(storage_dir_tell_seek_test);
 }
 
 static const char* const storage_copy_test_paths[] = {
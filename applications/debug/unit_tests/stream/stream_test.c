@@ -3,6 +3,7 @@
 #include <toolbox/stream/string_stream.h>
 #include <toolbox/stream/file_stream.h>
 #include <toolbox/stream/buffered_file_stream.h>
+#include <toolbox/stream/memory_stream.h>
 #include <storage/storage.h>
 #include "../minunit.h"
 
@@ -518,12 +519,81 @@ MU_TEST(stream_buffered_large_file_test) {
     furi_string_free(output_data);
 }
 
+MU_TEST(stream_memory_test) {
+    const char* data = "first line\r\nsecond line\n\nlast line";
+    const size_t data_size = strlen(data);
+    FuriString* line = furi_string_alloc();
+    char buf[16] = {0};
+
+    Stream* stream = memory_stream_alloc(data, data_size);
+    mu_assert_int_eq(data_size, stream_size(stream));
+
+    // same line splitting as other streams, CR is dropped
+    mu_check(stream_read_line(stream, line));
+    mu_assert_string_eq("first line\n", furi_string_get_cstr(line));
+    mu_check(stream_read_line(stream, line));
+    mu_assert_string_eq("second line\n", furi_string_get_cstr(line));
+    mu_check(stream_read_line(stream, line));
+    mu_assert_string_eq("\n", furi_string_get_cstr(line));
+    mu_check(stream_read_line(stream, line));
+    mu_assert_string_eq("last line", furi_string_get_cstr(line));
+    mu_check(stream_eof(stream));
+    mu_check(!stream_read_line(stream, line));
+
+    // seeks are clamped to the data
+    mu_check(stream_seek(stream, -4, StreamOffsetFromEnd));
+    mu_assert_int_eq(4, stream_read(stream, (uint8_t*)buf, sizeof(buf)));
+    mu_assert_string_eq("line", buf);
+    mu_check(!stream_seek(stream, 1, StreamOffsetFromCurrent));
+    mu_assert_int_eq(data_size, stream_tell(stream));
+    mu_check(!stream_seek(stream, -1, StreamOffsetFromStart));
+    mu_assert_int_eq(0, stream_tell(stream));
+
+    // read-only
+    mu_assert_int_eq(0, stream_write_cstring(stream, "test"));
+    mu_assert_int_eq(data_size, stream_size(stream));
+    stream_free(stream);
+
+    // file contents read line by line must match the buffered file stream
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* file_stream = buffered_file_stream_alloc(storage);
+    mu_check(buffered_file_stream_open(
+        file_stream, EXT_PATH("filestream.str"), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    for(size_t i = 0; i < 64; i++) {
+        stream_write_format(file_stream, "%s\r\n", stream_test_data);
+    }
+    mu_check(buffered_file_stream_close(file_stream));
+
+    stream = memory_stream_alloc_from_file(storage, EXT_PATH("filestream.str"));
+    mu_check(stream != NULL);
+    mu_check(buffered_file_stream_open(
+        file_stream, EXT_PATH("filestream.str"), FSAM_READ, FSOM_OPEN_EXISTING));
+    mu_assert_int_eq(stream_size(file_stream), stream_size(stream));
+
+    FuriString* file_line = furi_string_alloc();
+    size_t line_count = 0;
+    while(stream_read_line(file_stream, file_line)) {
+        mu_check(stream_read_line(stream, line));
+        mu_check(furi_string_equal(file_line, line));
+        line_count++;
+    }
+    mu_assert_int_eq(64, line_count);
+    mu_check(!stream_read_line(stream, line));
+
+    furi_string_free(file_line);
+    stream_free(stream);
+    stream_free(file_stream);
+    furi_record_close(RECORD_STORAGE);
+    furi_string_free(line);
+}
+
 MU_TEST_SUITE(stream_suite) {
     MU_RUN_TEST(stream_write_read_save_load_test);
     MU_RUN_TEST(stream_composite_test);
     MU_RUN_TEST(stream_split_test);
     MU_RUN_TEST(stream_buffered_write_after_read_test);
     MU_RUN_TEST(stream_buffered_large_file_test);
+    MU_RUN_TEST(stream_memory_test);
 }
 
 int run_minunit_test_stream() {
@@ -1,10 +1,12 @@
 #include <furi.h>
 #include <furi_hal.h>
 #include "../minunit.h"
+#include "../test_benchmark.h"
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_file_decoder.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
@@ -18,6 +20,7 @@
 #define TEST_RANDOM_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw.sub")
 #define TEST_RANDOM_COUNT_PARSE 329
 #define TEST_TIMEOUT 10000
+#define TEST_DISPATCH_CHUNK_SIZE 512
 
 static SubGhzEnvironment* environment_handler;
 static SubGhzReceiver* receiver_handler;
@@ -148,6 +151,251 @@ static bool subghz_decode_random_test(const char* path) {
     }
 }
 
+typedef struct {
+    SubGhzProtocolDecoderBase** decoders;
+    size_t count;
+    uint16_t decoded;
+} SubGhzTestFanOut;
+
+static void subghz_test_fan_out_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
+    UNUSED(decoder_base);
+    SubGhzTestFanOut* fan_out = context;
+    // Same as subghz_test_rx_callback: reset every decoder after a packet
+    for(size_t i = 0; i < fan_out->count; i++) {
+        fan_out->decoders[i]->protocol->decoder->reset(fan_out->decoders[i]);
+    }
+    fan_out->decoded++;
+}
+
+static bool subghz_receiver_dispatch_compare(const char* path) {
+    subghz_test_decoder_count = 0;
+    subghz_receiver_reset(receiver_handler);
+
+    // Reference: every decodable protocol gets every pulse
+    const SubGhzProtocolRegistry* registry = &subghz_protocol_registry;
+    SubGhzTestFanOut fan_out = {0};
+    fan_out.decoders =
+        malloc(sizeof(SubGhzProtocolDecoderBase*) * subghz_protocol_registry_count(registry));
+    for(size_t i = 0; i < subghz_protocol_registry_count(registry); i++) {
+        const SubGhzProtocol* protocol = subghz_protocol_registry_get_by_index(registry, i);
+        if(protocol->decoder && protocol->decoder->alloc &&
+           (protocol->flag & SubGhzProtocolFlag_Decodable)) {
+            SubGhzProtocolDecoderBase* decoder = protocol->decoder->alloc(environment_handler);
+            subghz_protocol_decoder_base_set_decoder_callback(
+                decoder, subghz_test_fan_out_callback, &fan_out);
+            fan_out.decoders[fan_out.count++] = decoder;
+        }
+    }
+
+    int32_t* chunk = malloc(sizeof(int32_t) * TEST_DISPATCH_CHUNK_SIZE);
+    uint32_t pulses = 0;
+    uint64_t receiver_cycles = 0;
+    uint64_t fan_out_cycles = 0;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* fff_data_file = flipper_format_file_alloc(storage);
+    bool file_read = false;
+    if(flipper_format_file_open_existing(fff_data_file, path)) {
+        uint32_t count = 0;
+        while(flipper_format_get_value_count(fff_data_file, "RAW_Data", &count)) {
+            count = MIN(count, (uint32_t)TEST_DISPATCH_CHUNK_SIZE);
+            if(!flipper_format_read_int32(fff_data_file, "RAW_Data", chunk, count)) break;
+
+            uint32_t cycles_start = test_benchmark_cycles();
+            for(uint32_t i = 0; i < count; i++) {
+                subghz_receiver_decode(receiver_handler, chunk[i] > 0, abs(chunk[i]));
+            }
+            receiver_cycles += test_benchmark_cycles() - cycles_start;
+
+            cycles_start = test_benchmark_cycles();
+            for(uint32_t i = 0; i < count; i++) {
+                for(size_t j = 0; j < fan_out.count; j++) {
+                    fan_out.decoders[j]->protocol->decoder->feed(
+                        fan_out.decoders[j], chunk[i] > 0, abs(chunk[i]));
+                }
+            }
+            fan_out_cycles += test_benchmark_cycles() - cycles_start;
+
+            pulses += count;
+            file_read = true;
+        }
+    }
+    flipper_format_free(fff_data_file);
+    furi_record_close(RECORD_STORAGE);
+
+    uint32_t receiver_us = test_benchmark_cycles_to_us(receiver_cycles);
+    uint32_t fan_out_us = test_benchmark_cycles_to_us(fan_out_cycles);
+    printf(
+        "Receiver dispatch: %lu pulses, %lu pulses/s, full fan-out %lu pulses/s\r\n",
+        pulses,
+        receiver_us ? (uint32_t)((uint64_t)pulses * 1000000 / receiver_us) : 0,
+        fan_out_us ? (uint32_t)((uint64_t)pulses * 1000000 / fan_out_us) : 0);
+    FURI_LOG_D(
+        TAG,
+        "Decoded: receiver %d, full fan-out %d",
+        subghz_test_decoder_count,
+        fan_out.decoded);
+
+    for(size_t i = 0; i < fan_out.count; i++) {
+        fan_out.decoders[i]->protocol->decoder->free(fan_out.decoders[i]);
+    }
+    free(fan_out.decoders);
+    free(chunk);
+
+    return file_read && (subghz_test_decoder_count == fan_out.decoded) &&
+           (fan_out.decoded == TEST_RANDOM_COUNT_PARSE);
+}
+
+typedef struct {
+    SubGhzProtocolDecoderBase* decoder;
+    uint64_t cycles;
+    uint16_t decoded;
+} SubGhzTestBenchmark;
+
+static void
+    subghz_test_benchmark_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
+    UNUSED(decoder_base);
+    SubGhzTestBenchmark* benchmark = context;
+    benchmark->decoded++;
+}
+
+static bool subghz_decoder_benchmark(const char* path) {
+    const SubGhzProtocolRegistry* registry = &subghz_protocol_registry;
+    SubGhzTestBenchmark* benchmarks =
+        malloc(sizeof(SubGhzTestBenchmark) * subghz_protocol_registry_count(registry));
+    size_t benchmarks_count = 0;
+
+    for(size_t i = 0; i < subghz_protocol_registry_count(registry); i++) {
+        const SubGhzProtocol* protocol = subghz_protocol_registry_get_by_index(registry, i);
+        if(protocol->decoder && protocol->decoder->alloc &&
+           (protocol->flag & SubGhzProtocolFlag_Decodable)) {
+            SubGhzTestBenchmark* benchmark = &benchmarks[benchmarks_count++];
+            benchmark->decoder = protocol->decoder->alloc(environment_handler);
+            benchmark->cycles = 0;
+            benchmark->decoded = 0;
+            subghz_protocol_decoder_base_set_decoder_callback(
+                benchmark->decoder, subghz_test_benchmark_callback, benchmark);
+        }
+    }
+
+    int32_t* chunk = malloc(sizeof(int32_t) * TEST_DISPATCH_CHUNK_SIZE);
+    uint32_t pulses = 0;
+    uint64_t receiver_cycles = 0;
+
+    subghz_test_decoder_count = 0;
+    subghz_receiver_reset(receiver_handler);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* fff_data_file = flipper_format_file_alloc(storage);
+    if(flipper_format_file_open_existing(fff_data_file, path)) {
+        uint32_t count = 0;
+        while(flipper_format_get_value_count(fff_data_file, "RAW_Data", &count)) {
+            count = MIN(count, (uint32_t)TEST_DISPATCH_CHUNK_SIZE);
+            if(!flipper_format_read_int32(fff_data_file, "RAW_Data", chunk, count)) break;
+
+            // Each decoder gets the chunk in a tight loop of its own
+            for(size_t j = 0; j < benchmarks_count; j++) {
+                SubGhzProtocolDecoderBase* decoder = benchmarks[j].decoder;
+                uint32_t cycles_start = test_benchmark_cycles();
+                for(uint32_t i = 0; i < count; i++) {
+                    decoder->protocol->decoder->feed(decoder, chunk[i] > 0, abs(chunk[i]));
+                }
+                benchmarks[j].cycles += test_benchmark_cycles() - cycles_start;
+            }
+
+            uint32_t cycles_start = test_benchmark_cycles();
+            for(uint32_t i = 0; i < count; i++) {
+                subghz_receiver_decode(receiver_handler, chunk[i] > 0, abs(chunk[i]));
+            }
+            receiver_cycles += test_benchmark_cycles() - cycles_start;
+
+            pulses += count;
+        }
+    }
+    flipper_format_free(fff_data_file);
+    furi_record_close(RECORD_STORAGE);
+
+    printf("SubGhz decode benchmark, %lu pulses:\r\n", pulses);
+    for(size_t j = 0; j < benchmarks_count; j++) {
+        printf(
+            "  %-20s %6lu ns/pulse, %u decoded\r\n",
+            benchmarks[j].decoder->protocol->name,
+            test_benchmark_ns_per_item(benchmarks[j].cycles, pulses),
+            benchmarks[j].decoded);
+        benchmarks[j].decoder->protocol->decoder->free(benchmarks[j].decoder);
+    }
+    printf(
+        "  %-20s %6lu ns/pulse, %u decoded\r\n",
+        "Receiver",
+        test_benchmark_ns_per_item(receiver_cycles, pulses),
+        subghz_test_decoder_count);
+
+    free(benchmarks);
+    free(chunk);
+
+    return pulses && (subghz_test_decoder_count == TEST_RANDOM_COUNT_PARSE);
+}
+
+static bool subghz_file_decoder_random_test(const char* path) {
+    SubGhzFileDecoder* file_decoder = subghz_file_decoder_alloc(environment_handler);
+    uint32_t packet_count = 0;
+
+    uint32_t test_start = furi_get_tick();
+    if(subghz_file_decoder_start(file_decoder, path)) {
+        while(subghz_file_decoder_process(file_decoder)) {
+        }
+        packet_count = subghz_file_decoder_get_packet_count(file_decoder);
+        subghz_file_decoder_stop(file_decoder);
+    }
+    FURI_LOG_I(
+        TAG,
+        "File decoder: %lu packets in %lu ms",
+        packet_count,
+        furi_get_tick() - test_start);
+
+    subghz_file_decoder_free(file_decoder);
+    return packet_count == TEST_RANDOM_COUNT_PARSE;
+}
+
+static void
+    subghz_test_file_decoder_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
+    UNUSED(context);
+    // Manufacture key lookup is done when the parcel is rendered
+    FuriString* text = furi_string_alloc();
+    subghz_protocol_decoder_base_get_string(decoder_base, text);
+    furi_string_free(text);
+}
+
+static bool subghz_keystore_kl_cache_compare(const char* path) {
+    SubGhzKeystore* keystore = subghz_environment_get_keystore(environment_handler);
+    SubGhzFileDecoder* file_decoder = subghz_file_decoder_alloc(environment_handler);
+    subghz_file_decoder_set_callback(file_decoder, subghz_test_file_decoder_callback, NULL);
+    SubGhzKeystoreKlStats pass[2] = {0};
+
+    for(size_t i = 0; i < COUNT_OF(pass); i++) {
+        subghz_keystore_reset_kl_stats(keystore);
+        if(subghz_file_decoder_start(file_decoder, path)) {
+            while(subghz_file_decoder_process(file_decoder)) {
+            }
+            subghz_file_decoder_stop(file_decoder);
+        }
+        pass[i] = *subghz_keystore_get_kl_stats(keystore);
+        FURI_LOG_I(
+            TAG,
+            "KeeLoq pass %zu: %lu packets, %lu attempts, %lu max, %lu cache hits",
+            i,
+            pass[i].packets,
+            pass[i].attempts,
+            pass[i].attempts_max,
+            pass[i].cache_hits);
+    }
+
+    subghz_file_decoder_free(file_decoder);
+    // Same parcels again, known serial numbers must be resolved by the cache
+    return pass[0].packets && pass[1].packets == pass[0].packets && pass[1].cache_hits &&
+           pass[1].attempts <= pass[0].attempts;
+}
+
 static bool subghz_encoder_test(const char* path) {
     subghz_test_decoder_count = 0;
     uint32_t test_start = furi_get_tick();
@@ -811,6 +1059,27 @@ MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
 }
 
+MU_TEST(subghz_receiver_dispatch_test) {
+    mu_assert(
+        subghz_receiver_dispatch_compare(TEST_RANDOM_DIR_NAME),
+        "Test receiver dispatch error\r\n");
+}
+
+MU_TEST(subghz_decoder_benchmark_test) {
+    mu_assert(subghz_decoder_benchmark(TEST_RANDOM_DIR_NAME), "Decoder benchmark error\r\n");
+}
+
+MU_TEST(subghz_keystore_kl_cache_test) {
+    mu_assert(
+        subghz_keystore_kl_cache_compare(EXT_PATH("unit_tests/subghz/doorhan_raw.sub")),
+        "Test keystore KeeLoq cache error\r\n");
+}
+
+MU_TEST(subghz_file_decoder_test) {
+    mu_assert(
+        subghz_file_decoder_random_test(TEST_RANDOM_DIR_NAME), "Test file decoder error\r\n");
+}
+
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
@@ -886,6 +1155,10 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_encoder_dooya_test);
 
     MU_RUN_TEST(subghz_random_test);
+    MU_RUN_TEST(subghz_receiver_dispatch_test);
+    MU_RUN_TEST(subghz_decoder_benchmark_test);
+    MU_RUN_TEST(subghz_file_decoder_test);
+    MU_RUN_TEST(subghz_keystore_kl_cache_test);
     subghz_test_deinit();
 }
 
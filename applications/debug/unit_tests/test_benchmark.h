@@ -0,0 +1,23 @@
+#pragma once
+
+#include <furi_hal.h>
+
+/*
+ * Benchmark helpers, time is measured with the DWT cycle counter
+ */
+
+/** Get current value of the cycle counter */
+static inline uint32_t test_benchmark_cycles(void) {
+    return DWT->CYCCNT;
+}
+
+/** Convert cycles to microseconds */
+static inline uint32_t test_benchmark_cycles_to_us(uint64_t cycles) {
+    return cycles / furi_hal_cortex_instructions_per_microsecond();
+}
+
+/** Convert cycles spent on a number of items (pulses, lookups, draws) to nanoseconds per item */
+static inline uint32_t test_benchmark_ns_per_item(uint64_t cycles, uint32_t items) {
+    uint64_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    return items ? (uint32_t)(cycles * 1000 / cycles_per_us / items) : 0;
+}
@@ -20,6 +20,7 @@ int run_minunit_test_stream();
 int run_minunit_test_storage();
 int run_minunit_test_subghz();
 int run_minunit_test_dirwalk();
+int run_minunit_test_file_browser_index();
 int run_minunit_test_power();
 int run_minunit_test_protocol_dict();
 int run_minunit_test_lfrfid_protocols();
@@ -28,6 +29,9 @@ int run_minunit_test_bit_lib();
 int run_minunit_test_float_tools();
 int run_minunit_test_bt();
 int run_minunit_test_dialogs_file_browser_options();
+int run_minunit_test_elf_loader();
+int run_minunit_test_compress();
+int run_minunit_test_bad_usb();
 
 typedef int (*UnitTestEntry)();
 
@@ -43,6 +47,7 @@ const UnitTest unit_tests[] = {
     {.name = "storage", .entry = run_minunit_test_storage},
     {.name = "stream", .entry = run_minunit_test_stream},
     {.name = "dirwalk", .entry = run_minunit_test_dirwalk},
+    {.name = "file_browser_index", .entry = run_minunit_test_file_browser_index},
     {.name = "manifest", .entry = run_minunit_test_manifest},
     {.name = "flipper_format", .entry = run_minunit_test_flipper_format},
     {.name = "flipper_format_string", .entry = run_minunit_test_flipper_format_string},
@@ -58,6 +63,9 @@ const UnitTest unit_tests[] = {
     {.name = "bt", .entry = run_minunit_test_bt},
     {.name = "dialogs_file_browser_options",
      .entry = run_minunit_test_dialogs_file_browser_options},
+    {.name = "elf_loader", .entry = run_minunit_test_elf_loader},
+    {.name = "compress", .entry = run_minunit_test_compress},
+    {.name = "bad_usb", .entry = run_minunit_test_bad_usb},
 };
 
 void minunit_print_progress() {
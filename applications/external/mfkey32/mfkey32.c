@@ -31,7 +31,7 @@
 #define TAG "Mfkey32"
 #define NFC_MF_CLASSIC_KEY_LEN (13)
 
-#define MIN_RAM 115632
+#define MIN_RAM 120752
 #define LF_POLY_ODD (0x29CE5C)
 #define LF_POLY_EVEN (0x870804)
 #define CONST_M1_1 (LF_POLY_EVEN << 1 | 1)
@@ -49,6 +49,11 @@ static int eta_total_time = 900;
 // MSB_LIMIT: Chunk size (out of 256)
 static int MSB_LIMIT = 16;
 
+#define RADIX_SORT_INSERTION_LIMIT (32)
+#define RADIX_SORT_BUFFER_SIZE (1280)
+static unsigned int* radix_sort_buffer;
+static uint16_t radix_sort_count[256];
+
 struct Crypto1State {
     uint32_t odd, even;
 };
@@ -128,16 +133,6 @@ struct MfClassicDict {
     uint32_t total_keys;
 };
 
-static const uint8_t table[256] = {
-    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3,
-    4, 4, 5, 1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5, 2, 3, 3, 4, 3, 4, 4, 5, 3, 4,
-    4, 5, 4, 5, 5, 6, 1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5, 2, 3, 3, 4, 3, 4, 4,
-    5, 3, 4, 4, 5, 4, 5, 5, 6, 2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6, 3, 4, 4, 5,
-    4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7, 1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5, 2,
-    3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6, 2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5,
-    5, 6, 3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7, 2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4,
-    5, 4, 5, 5, 6, 3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7, 3, 4, 4, 5, 4, 5, 5, 6,
-    4, 5, 5, 6, 5, 6, 6, 7, 4, 5, 5, 6, 5, 6, 6, 7, 5, 6, 6, 7, 6, 7, 7, 8};
 static const uint8_t lookup1[256] = {
     0, 0,  16, 16, 0,  16, 0,  0,  0, 16, 0,  0,  16, 16, 16, 16, 0, 0,  16, 16, 0,  16, 0,  0,
     0, 16, 0,  0,  16, 16, 16, 16, 0, 0,  16, 16, 0,  16, 0,  0,  0, 16, 0,  0,  16, 16, 16, 16,
@@ -175,13 +170,7 @@ static inline int filter(uint32_t const x) {
 }
 
 static inline uint8_t evenparity32(uint32_t x) {
-    if((table[x & 0xff] + table[(x >> 8) & 0xff] + table[(x >> 16) & 0xff] + table[x >> 24]) % 2 ==
-       0) {
-        return 0;
-    } else {
-        return 1;
-    }
-    //return ((table[x & 0xff] + table[(x >> 8) & 0xff] + table[(x >> 16) & 0xff] + table[x >> 24]) % 2) & 0xFF;
+    return __builtin_parity(x);
 }
 
 static inline void update_contribution(unsigned int data[], int item, int mask1, int mask2) {
@@ -334,35 +323,56 @@ int binsearch(unsigned int data[], int start, int stop) {
     }
     return start;
 }
-void quicksort(unsigned int array[], int low, int high) {
-    //if (SIZEOF(array) == 0)
-    //    return;
-    if(low >= high) return;
-    int middle = low + (high - low) / 2;
-    unsigned int pivot = array[middle];
-    int i = low, j = high;
-    while(i <= j) {
-        while(array[i] < pivot) {
-            i++;
-        }
-        while(array[j] > pivot) {
-            j--;
-        }
-        if(i <= j) { // swap
-            int temp = array[i];
-            array[i] = array[j];
-            array[j] = temp;
-            i++;
+static inline void insertion_sort(unsigned int array[], int low, int high) {
+    for(int i = low + 1; i <= high; i++) {
+        unsigned int value = array[i];
+        int j = i - 1;
+        while(j >= low && array[j] > value) {
+            array[j + 1] = array[j];
             j--;
         }
+        array[j + 1] = value;
+    }
+}
+
+// LSD radix sort of array[low..high], byte passes shared by all elements are skipped
+void radix_sort(unsigned int array[], int low, int high) {
+    int size = high - low + 1;
+    if(size <= RADIX_SORT_INSERTION_LIMIT) {
+        insertion_sort(array, low, high);
+        return;
     }
-    if(low < j) {
-        quicksort(array, low, j);
+    furi_assert(size <= RADIX_SORT_BUFFER_SIZE);
+
+    unsigned int* src = &array[low];
+    unsigned int* dst = radix_sort_buffer;
+    for(int shift = 0; shift < 32; shift += 8) {
+        memset(radix_sort_count, 0, sizeof(radix_sort_count));
+        for(int i = 0; i < size; i++) {
+            radix_sort_count[src[i] >> shift & 0xff]++;
+        }
+        if(radix_sort_count[src[0] >> shift & 0xff] == size) continue;
+
+        uint16_t offset = 0;
+        for(int i = 0; i < 256; i++) {
+            uint16_t count = radix_sort_count[i];
+            radix_sort_count[i] = offset;
+            offset += count;
+        }
+        for(int i = 0; i < size; i++) {
+            dst[radix_sort_count[src[i] >> shift & 0xff]++] = src[i];
+        }
+
+        unsigned int* t = src;
+        src = dst;
+        dst = t;
     }
-    if(high > i) {
-        quicksort(array, i, high);
+
+    if(src != &array[low]) {
+        memcpy(&array[low], src, size * sizeof(unsigned int));
     }
 }
+
 int extend_table(unsigned int data[], int tbl, int end, int bit, int m1, int m2) {
     for(data[tbl] <<= 1; tbl <= end; data[++tbl] <<= 1) {
         if((filter(data[tbl]) ^ filter(data[tbl] | 1)) != 0) {
@@ -422,8 +432,8 @@ int old_recover(
         }
     }
     first_run = 0;
-    quicksort(odd, o_head, o_tail);
-    quicksort(even, e_head, e_tail);
+    radix_sort(odd, o_head, o_tail);
+    radix_sort(even, e_head, e_tail);
     while(o_tail >= o_head && e_tail >= e_head) {
         if(((odd[o_tail] ^ even[e_tail]) >> 24) == 0) {
             o_tail = binsearch(odd, o_head, o = o_tail);
@@ -570,6 +580,7 @@ bool recover(struct Crypto1Params* p, int ks2, ProgramState* program_state) {
     struct Msb* even_msbs = (struct Msb*)malloc(MSB_LIMIT * sizeof(struct Msb));
     unsigned int* temp_states_odd = malloc(sizeof(unsigned int) * (1280));
     unsigned int* temp_states_even = malloc(sizeof(unsigned int) * (1280));
+    radix_sort_buffer = malloc(sizeof(unsigned int) * RADIX_SORT_BUFFER_SIZE);
     int oks = 0, eks = 0;
     int i = 0, msb = 0;
     for(i = 31; i >= 0; i -= 2) {
@@ -610,6 +621,8 @@ bool recover(struct Crypto1Params* p, int ks2, ProgramState* program_state) {
     free(even_msbs);
     free(temp_states_odd);
     free(temp_states_even);
+    free(radix_sort_buffer);
+    radix_sort_buffer = NULL;
     return found;
 }
 
@@ -113,6 +113,7 @@ static void archive_file_browser_set_path(
         file_browser_worker_set_list_callback(browser->worker, archive_list_load_cb);
         file_browser_worker_set_item_callback(browser->worker, archive_list_item_cb);
         file_browser_worker_set_long_load_callback(browser->worker, archive_long_load_cb);
+        file_browser_worker_set_index_enabled(browser->worker, true);
         browser->worker_running = true;
     } else {
         furi_assert(browser->worker);
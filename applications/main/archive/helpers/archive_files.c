@@ -109,6 +109,10 @@ void archive_delete_file(void* context, const char* format, ...) {
     }
 
     if(res) {
+        if(browser->worker_running) {
+            file_browser_worker_index_remove(
+                browser->worker, furi_string_get_cstr(filename), file_info_is_dir(&fileinfo));
+        }
         archive_file_array_rm_selected(browser);
     }
 
@@ -139,6 +143,11 @@ FS_Error archive_rename_file_or_dir(void* context, const char* src_path, const c
         archive_favorites_rename(src_path, dst_path);
     }
 
+    if((error == FSE_OK) && browser->worker_running) {
+        file_browser_worker_index_rename(
+            browser->worker, src_path, dst_path, file_info_is_dir(&fileinfo));
+    }
+
     if(error == FSE_OK || error == FSE_EXIST) {
         FURI_LOG_I(TAG, "Rename from %s to %s is DONE", src_path, dst_path);
         archive_refresh_dir(browser);
@@ -3,6 +3,12 @@
 #include <gui/gui.h>
 #include <input/input.h>
 #include <lib/toolbox/args.h>
+#include <lib/toolbox/crc32_calc.h>
+#include <lib/toolbox/path.h>
+#include <lib/toolbox/stream/buffered_file_stream.h>
+#include <lib/toolbox/stream/file_stream.h>
+#include <lib/toolbox/stream/memory_stream.h>
+#include <lib/toolbox/stream/string_stream.h>
 #include <furi_hal_usb_hid.h>
 #include <storage/storage.h>
 #include "ducky_script.h"
@@ -12,8 +18,12 @@
 #define TAG "BadUSB"
 #define WORKER_TAG TAG "Worker"
 
-#define BADUSB_ASCII_TO_KEY(script, x) \
-    (((uint8_t)x < 128) ? (script->layout[(uint8_t)x]) : HID_KEYBOARD_NONE)
+/*
+ * Compiled script is cached next to the script as a hidden file, it is valid while
+ * script size and CRC match. Keycodes of named keys and numbers are resolved by
+ * compiler, so execution doesn't parse text.
+ */
+#define BADUSB_PROGRAM_EXTENSION ".bdc"
 
 typedef enum {
     WorkerEvtStartStop = (1 << 0),
@@ -38,39 +48,6 @@ static const uint8_t numpad_keys[10] = {
     HID_KEYPAD_9,
 };
 
-uint32_t ducky_get_command_len(const char* line) {
-    uint32_t len = strlen(line);
-    for(uint32_t i = 0; i < len; i++) {
-        if(line[i] == ' ') return i;
-    }
-    return 0;
-}
-
-bool ducky_is_line_end(const char chr) {
-    return ((chr == ' ') || (chr == '\0') || (chr == '\r') || (chr == '\n'));
-}
-
-uint16_t ducky_get_keycode(BadUsbScript* bad_usb, const char* param, bool accept_chars) {
-    uint16_t keycode = ducky_get_keycode_by_name(param);
-    if(keycode != HID_KEYBOARD_NONE) {
-        return keycode;
-    }
-
-    if((accept_chars) && (strlen(param) > 0)) {
-        return (BADUSB_ASCII_TO_KEY(bad_usb, param[0]) & 0xFF);
-    }
-    return 0;
-}
-
-bool ducky_get_number(const char* param, uint32_t* val) {
-    uint32_t value = 0;
-    if(sscanf(param, "%lu", &value) == 1) {
-        *val = value;
-        return true;
-    }
-    return false;
-}
-
 void ducky_numlock_on() {
     if((furi_hal_hid_get_led_state() & HID_KB_LED_NUM) == 0) {
         furi_hal_hid_kb_press(HID_KEYBOARD_LOCK_NUM_LOCK);
@@ -133,7 +110,32 @@ int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...) {
     return SCRIPT_STATE_ERROR;
 }
 
+static void ducky_string_batch(BadUsbScript* bad_usb, const char* param) {
+    DuckyHidReport prev = {0};
+    DuckyHidReport report;
+
+    while(*param != '\0') {
+        param += ducky_string_plan_report(bad_usb->layout, param, &prev, &report);
+        if(report.keys_nb == 0) break;
+
+        if(report.release) {
+            furi_hal_hid_kb_release_all();
+        }
+        furi_hal_hid_kb_set_report(report.mods, report.keys, report.keys_nb);
+        prev = report;
+    }
+
+    furi_hal_hid_kb_release_all();
+}
+
 bool ducky_string(BadUsbScript* bad_usb, const char* param) {
+    // Batched reports replace all pressed keys, so keys from HOLD are typed one by one
+    if(bad_usb->string_batch && bad_usb->key_hold_nb == 0) {
+        ducky_string_batch(bad_usb, param);
+        bad_usb->stringdelay = 0;
+        return true;
+    }
+
     uint32_t i = 0;
 
     while(param[i] != '\0') {
@@ -176,40 +178,6 @@ static bool ducky_string_next(BadUsbScript* bad_usb) {
     return false;
 }
 
-static int32_t ducky_parse_line(BadUsbScript* bad_usb, FuriString* line) {
-    uint32_t line_len = furi_string_size(line);
-    const char* line_tmp = furi_string_get_cstr(line);
-
-    if(line_len == 0) {
-        return SCRIPT_STATE_NEXT_LINE; // Skip empty lines
-    }
-    FURI_LOG_D(WORKER_TAG, "line:%s", line_tmp);
-
-    // Ducky Lang Functions
-    int32_t cmd_result = ducky_execute_cmd(bad_usb, line_tmp);
-    if(cmd_result != SCRIPT_STATE_CMD_UNKNOWN) {
-        return cmd_result;
-    }
-
-    // Special keys + modifiers
-    uint16_t key = ducky_get_keycode(bad_usb, line_tmp, false);
-    if(key == HID_KEYBOARD_NONE) {
-        return ducky_error(bad_usb, "No keycode defined for %s", line_tmp);
-    }
-    if((key & 0xFF00) != 0) {
-        // It's a modifier key
-        uint32_t offset = ducky_get_command_len(line_tmp) + 1;
-        // ducky_get_command_len() returns 0 without space, so check for != 1
-        if(offset != 1 && line_len > offset) {
-            // It's also a key combination
-            key |= ducky_get_keycode(bad_usb, line_tmp + offset, true);
-        }
-    }
-    furi_hal_hid_kb_press(key);
-    furi_hal_hid_kb_release(key);
-    return 0;
-}
-
 static bool ducky_set_usb_id(BadUsbScript* bad_usb, const char* line) {
     if(sscanf(line, "%lX:%lX", &bad_usb->hid_cfg.vid, &bad_usb->hid_cfg.pid) == 2) {
         bad_usb->hid_cfg.manuf[0] = '\0';
@@ -235,57 +203,184 @@ static bool ducky_set_usb_id(BadUsbScript* bad_usb, const char* line) {
     return false;
 }
 
-static bool ducky_script_preload(BadUsbScript* bad_usb, File* script_file) {
-    uint8_t ret = 0;
-    uint32_t line_len = 0;
+static void ducky_script_get_program_path(const char* script_path, FuriString* program_path) {
+    FuriString* name = furi_string_alloc();
+    path_extract_dirname(script_path, program_path);
+    path_extract_filename_no_ext(script_path, name);
+    furi_string_cat_printf(
+        program_path, "/.%s%s", furi_string_get_cstr(name), BADUSB_PROGRAM_EXTENSION);
+    furi_string_free(name);
+}
+
+static bool ducky_script_compile(
+    Storage* storage,
+    const char* script_path,
+    Stream* program,
+    DuckyProgramHeader* header) {
+    Stream* script = buffered_file_stream_alloc(storage);
+    bool success = false;
+
+    if(buffered_file_stream_open(script, script_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        success = ducky_program_compile(script, program, header);
+    }
+
+    stream_free(script);
+    return success;
+}
+
+static bool ducky_script_compile_to_file(
+    Storage* storage,
+    const char* script_path,
+    const char* program_path,
+    const DuckyProgramHeader* script_header) {
+    Stream* program = file_stream_alloc(storage);
+    DuckyProgramHeader header = *script_header;
+    bool success = false;
+
+    if(file_stream_open(program, program_path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+        success = ducky_script_compile(storage, script_path, program, &header);
+    }
 
-    furi_string_reset(bad_usb->line);
+    file_stream_close(program);
+    if(!success) {
+        FURI_LOG_W(WORKER_TAG, "Failed to save compiled %s", script_path);
+        storage_simply_remove(storage, program_path);
+    }
+
+    stream_free(program);
+    return success;
+}
+
+// Used when compiled script can't be saved, e.g. SD card is full or write protected
+static Stream* ducky_script_compile_to_memory(
+    Storage* storage,
+    const char* script_path,
+    DuckyProgramHeader* header) {
+    Stream* program = string_stream_alloc();
+
+    if(!ducky_script_compile(storage, script_path, program, header)) {
+        FURI_LOG_E(WORKER_TAG, "Failed to compile %s", script_path);
+        stream_free(program);
+        return NULL;
+    }
+
+    return program;
+}
+
+static bool ducky_script_get_info(
+    Storage* storage,
+    const char* script_path,
+    DuckyProgramHeader* header) {
+    File* file = storage_file_alloc(storage);
+    bool success = false;
+
+    if(storage_file_open(file, script_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        header->script_size = storage_file_size(file);
+        header->script_crc = crc32_calc_file(file, NULL, NULL);
+        success = true;
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+    return success;
+}
+
+static Stream* ducky_script_program_open(
+    Storage* storage,
+    const char* program_path,
+    const DuckyProgramHeader* script_header,
+    DuckyProgramHeader* header) {
+    // Program is replayed from memory, unless it is too big for that
+    Stream* program = memory_stream_alloc_from_file(storage, program_path);
+    if(!program) {
+        program = buffered_file_stream_alloc(storage);
+        if(!buffered_file_stream_open(program, program_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            stream_free(program);
+            return NULL;
+        }
+    }
+
+    if(stream_read(program, (uint8_t*)header, sizeof(DuckyProgramHeader)) !=
+           sizeof(DuckyProgramHeader) ||
+       header->magic != DUCKY_PROGRAM_MAGIC || header->version != script_header->version ||
+       header->script_size != script_header->script_size ||
+       header->script_crc != script_header->script_crc) {
+        FURI_LOG_I(WORKER_TAG, "Program %s is outdated", program_path);
+        stream_free(program);
+        return NULL;
+    }
+
+    return program;
+}
+
+static bool ducky_script_load(BadUsbScript* bad_usb) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* program_path = furi_string_alloc();
+    const char* script_path = furi_string_get_cstr(bad_usb->file_path);
+    ducky_script_get_program_path(script_path, program_path);
+
+    DuckyProgramHeader script_header = {.version = DUCKY_PROGRAM_VERSION};
+    DuckyProgramHeader header;
+    bool success = false;
 
     do {
-        ret = storage_file_read(script_file, bad_usb->file_buf, FILE_BUFFER_LEN);
-        for(uint16_t i = 0; i < ret; i++) {
-            if(bad_usb->file_buf[i] == '\n' && line_len > 0) {
-                bad_usb->st.line_nb++;
-                line_len = 0;
-            } else {
-                if(bad_usb->st.line_nb == 0) { // Save first line
-                    furi_string_push_back(bad_usb->line, bad_usb->file_buf[i]);
-                }
-                line_len++;
+        if(!ducky_script_get_info(storage, script_path, &script_header)) break;
+
+        Stream* stream = ducky_script_program_open(
+            storage, furi_string_get_cstr(program_path), &script_header, &header);
+        if(!stream) {
+            // Script is new or changed since it was compiled
+            if(ducky_script_compile_to_file(
+                   storage, script_path, furi_string_get_cstr(program_path), &script_header)) {
+                stream = ducky_script_program_open(
+                    storage, furi_string_get_cstr(program_path), &script_header, &header);
             }
         }
-        if(storage_file_eof(script_file)) {
-            if(line_len > 0) {
-                bad_usb->st.line_nb++;
-                break;
-            }
+        if(!stream) {
+            header = script_header;
+            stream = ducky_script_compile_to_memory(storage, script_path, &header);
+            if(!stream) break;
         }
-    } while(ret > 0);
 
-    const char* line_tmp = furi_string_get_cstr(bad_usb->line);
-    bool id_set = false; // Looking for ID command at first line
-    if(strncmp(line_tmp, ducky_cmd_id, strlen(ducky_cmd_id)) == 0) {
-        id_set = ducky_set_usb_id(bad_usb, &line_tmp[strlen(ducky_cmd_id) + 1]);
-    }
+        bad_usb->program = ducky_program_alloc(stream, &header);
+        bad_usb->st.line_nb = header.line_nb;
 
-    if(id_set) {
-        furi_check(furi_hal_usb_set_config(&usb_hid, &bad_usb->hid_cfg));
-    } else {
-        furi_check(furi_hal_usb_set_config(&usb_hid, NULL));
-    }
+        // Looking for ID command at first line
+        bool id_set = false;
+        DuckyInstruction instruction;
+        if(header.line_nb > 0 && ducky_program_next(bad_usb->program, &instruction) &&
+           instruction.opcode == DuckyOpId) {
+            id_set = ducky_set_usb_id(bad_usb, bad_usb->program->text);
+        }
+        ducky_program_rewind(bad_usb->program);
+
+        if(id_set) {
+            furi_check(furi_hal_usb_set_config(&usb_hid, &bad_usb->hid_cfg));
+        } else {
+            furi_check(furi_hal_usb_set_config(&usb_hid, NULL));
+        }
 
-    storage_file_seek(script_file, 0, true);
-    furi_string_reset(bad_usb->line);
+        success = true;
+    } while(false);
 
-    return true;
+    furi_string_free(program_path);
+    furi_record_close(RECORD_STORAGE);
+    return success;
 }
 
-static int32_t ducky_script_execute_next(BadUsbScript* bad_usb, File* script_file) {
+static int32_t ducky_script_execute_next(BadUsbScript* bad_usb) {
     int32_t delay_val = 0;
+    DuckyInstruction instruction;
 
     if(bad_usb->repeat_cnt > 0) {
         bad_usb->repeat_cnt--;
-        delay_val = ducky_parse_line(bad_usb, bad_usb->line_prev);
+        if(!bad_usb->program->prev) { // Nothing to repeat
+            return 0;
+        }
+        if(!ducky_program_previous(bad_usb->program, &instruction)) {
+            return ducky_error(bad_usb, "Program read error");
+        }
+        delay_val = ducky_execute_instruction(bad_usb, &instruction, bad_usb->program->text);
         if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
             return 0;
         } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
@@ -301,52 +396,30 @@ static int32_t ducky_script_execute_next(BadUsbScript* bad_usb, File* script_fil
         }
     }
 
-    furi_string_set(bad_usb->line_prev, bad_usb->line);
-    furi_string_reset(bad_usb->line);
-
-    while(1) {
-        if(bad_usb->buf_len == 0) {
-            bad_usb->buf_len = storage_file_read(script_file, bad_usb->file_buf, FILE_BUFFER_LEN);
-            if(storage_file_eof(script_file)) {
-                if((bad_usb->buf_len < FILE_BUFFER_LEN) && (bad_usb->file_end == false)) {
-                    bad_usb->file_buf[bad_usb->buf_len] = '\n';
-                    bad_usb->buf_len++;
-                    bad_usb->file_end = true;
-                }
-            }
-
-            bad_usb->buf_start = 0;
-            if(bad_usb->buf_len == 0) return SCRIPT_STATE_END;
-        }
-        for(uint8_t i = bad_usb->buf_start; i < (bad_usb->buf_start + bad_usb->buf_len); i++) {
-            if(bad_usb->file_buf[i] == '\n' && furi_string_size(bad_usb->line) > 0) {
-                bad_usb->st.line_cur++;
-                bad_usb->buf_len = bad_usb->buf_len + bad_usb->buf_start - (i + 1);
-                bad_usb->buf_start = i + 1;
-                furi_string_trim(bad_usb->line);
-                delay_val = ducky_parse_line(bad_usb, bad_usb->line);
-                if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
-                    return 0;
-                } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
-                    return delay_val;
-                } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
-                    return delay_val;
-                } else if(delay_val < 0) {
-                    bad_usb->st.error_line = bad_usb->st.line_cur;
-                    FURI_LOG_E(WORKER_TAG, "Unknown command at line %u", bad_usb->st.line_cur);
-                    return SCRIPT_STATE_ERROR;
-                } else {
-                    return (delay_val + bad_usb->defdelay);
-                }
-            } else {
-                furi_string_push_back(bad_usb->line, bad_usb->file_buf[i]);
-            }
-        }
-        bad_usb->buf_len = 0;
-        if(bad_usb->file_end) return SCRIPT_STATE_END;
+    if(bad_usb->st.line_cur >= bad_usb->st.line_nb) {
+        return SCRIPT_STATE_END;
     }
 
-    return 0;
+    if(!ducky_program_next(bad_usb->program, &instruction)) {
+        bad_usb->st.error_line = bad_usb->st.line_cur + 1;
+        return ducky_error(bad_usb, "Program read error");
+    }
+    bad_usb->st.line_cur++;
+
+    delay_val = ducky_execute_instruction(bad_usb, &instruction, bad_usb->program->text);
+    if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
+        return 0;
+    } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
+        return delay_val;
+    } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
+        return delay_val;
+    } else if(delay_val < 0) {
+        bad_usb->st.error_line = bad_usb->st.line_cur;
+        FURI_LOG_E(WORKER_TAG, "Unknown command at line %u", bad_usb->st.line_cur);
+        return SCRIPT_STATE_ERROR;
+    } else {
+        return (delay_val + bad_usb->defdelay);
+    }
 }
 
 static void bad_usb_hid_state_callback(bool state, void* context) {
@@ -381,31 +454,24 @@ static int32_t bad_usb_worker(void* context) {
     int32_t delay_val = 0;
 
     FURI_LOG_I(WORKER_TAG, "Init");
-    File* script_file = storage_file_alloc(furi_record_open(RECORD_STORAGE));
-    bad_usb->line = furi_string_alloc();
-    bad_usb->line_prev = furi_string_alloc();
     bad_usb->string_print = furi_string_alloc();
 
     furi_hal_hid_set_state_callback(bad_usb_hid_state_callback, bad_usb);
 
     while(1) {
         if(worker_state == BadUsbStateInit) { // State: initialization
-            if(storage_file_open(
-                   script_file,
-                   furi_string_get_cstr(bad_usb->file_path),
-                   FSAM_READ,
-                   FSOM_OPEN_EXISTING)) {
-                if((ducky_script_preload(bad_usb, script_file)) && (bad_usb->st.line_nb > 0)) {
+            if(ducky_script_load(bad_usb)) {
+                if(bad_usb->st.line_nb > 0) {
                     if(furi_hal_hid_is_connected()) {
                         worker_state = BadUsbStateIdle; // Ready to run
                     } else {
                         worker_state = BadUsbStateNotConnected; // USB not connected
                     }
                 } else {
-                    worker_state = BadUsbStateScriptError; // Script preload error
+                    worker_state = BadUsbStateScriptError; // Empty script
                 }
             } else {
-                FURI_LOG_E(WORKER_TAG, "File open error");
+                FURI_LOG_E(WORKER_TAG, "Script load error");
                 worker_state = BadUsbStateFileError; // File open error
             }
             bad_usb->st.state = worker_state;
@@ -432,14 +498,13 @@ static int32_t bad_usb_worker(void* context) {
             } else if(flags & WorkerEvtStartStop) { // Start executing script
                 dolphin_deed(DolphinDeedBadUsbPlayScript);
                 delay_val = 0;
-                bad_usb->buf_len = 0;
+                ducky_program_rewind(bad_usb->program);
                 bad_usb->st.line_cur = 0;
                 bad_usb->defdelay = 0;
                 bad_usb->stringdelay = 0;
+                bad_usb->string_batch = false;
                 bad_usb->repeat_cnt = 0;
                 bad_usb->key_hold_nb = 0;
-                bad_usb->file_end = false;
-                storage_file_seek(script_file, 0, true);
                 worker_state = BadUsbStateRunning;
             } else if(flags & WorkerEvtDisconnect) {
                 worker_state = BadUsbStateNotConnected; // USB disconnected
@@ -455,13 +520,12 @@ static int32_t bad_usb_worker(void* context) {
             } else if(flags & WorkerEvtConnect) { // Start executing script
                 dolphin_deed(DolphinDeedBadUsbPlayScript);
                 delay_val = 0;
-                bad_usb->buf_len = 0;
+                ducky_program_rewind(bad_usb->program);
                 bad_usb->st.line_cur = 0;
                 bad_usb->defdelay = 0;
                 bad_usb->stringdelay = 0;
+                bad_usb->string_batch = false;
                 bad_usb->repeat_cnt = 0;
-                bad_usb->file_end = false;
-                storage_file_seek(script_file, 0, true);
                 // extra time for PC to recognize Flipper as keyboard
                 flags = furi_thread_flags_wait(
                     WorkerEvtEnd | WorkerEvtDisconnect | WorkerEvtStartStop,
@@ -510,7 +574,7 @@ static int32_t bad_usb_worker(void* context) {
                     continue;
                 }
                 bad_usb->st.state = BadUsbStateRunning;
-                delay_val = ducky_script_execute_next(bad_usb, script_file);
+                delay_val = ducky_script_execute_next(bad_usb);
                 if(delay_val == SCRIPT_STATE_ERROR) { // Script error
                     delay_val = 0;
                     worker_state = BadUsbStateScriptError;
@@ -630,10 +694,9 @@ static int32_t bad_usb_worker(void* context) {
 
     furi_hal_hid_set_state_callback(NULL, NULL);
 
-    storage_file_close(script_file);
-    storage_file_free(script_file);
-    furi_string_free(bad_usb->line);
-    furi_string_free(bad_usb->line_prev);
+    if(bad_usb->program) {
+        ducky_program_free(bad_usb->program);
+    }
     furi_string_free(bad_usb->string_print);
 
     FURI_LOG_I(WORKER_TAG, "End");
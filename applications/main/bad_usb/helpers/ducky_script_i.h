@@ -6,6 +6,8 @@ extern "C" {
 
 #include <furi.h>
 #include <furi_hal.h>
+#include <toolbox/stream/stream.h>
+#include <ducky_script/ducky_script_program.h>
 #include "ducky_script.h"
 
 #define SCRIPT_STATE_ERROR (-1)
@@ -15,7 +17,8 @@ extern "C" {
 #define SCRIPT_STATE_STRING_START (-5)
 #define SCRIPT_STATE_WAIT_FOR_BTN (-6)
 
-#define FILE_BUFFER_LEN 16
+#define BADUSB_ASCII_TO_KEY(script, x) \
+    (((uint8_t)x < 128) ? (script->layout[(uint8_t)x]) : HID_KEYBOARD_NONE)
 
 struct BadUsbScript {
     FuriHalUsbHidConfig hid_cfg;
@@ -23,17 +26,13 @@ struct BadUsbScript {
     BadUsbState st;
 
     FuriString* file_path;
-    uint8_t file_buf[FILE_BUFFER_LEN + 1];
-    uint8_t buf_start;
-    uint8_t buf_len;
-    bool file_end;
+    DuckyProgram* program;
 
     uint32_t defdelay;
     uint32_t stringdelay;
+    bool string_batch;
     uint16_t layout[128];
 
-    FuriString* line;
-    FuriString* line_prev;
     uint32_t repeat_cnt;
     uint8_t key_hold_nb;
 
@@ -41,16 +40,6 @@ struct BadUsbScript {
     size_t string_print_pos;
 };
 
-uint16_t ducky_get_keycode(BadUsbScript* bad_usb, const char* param, bool accept_chars);
-
-uint32_t ducky_get_command_len(const char* line);
-
-bool ducky_is_line_end(const char chr);
-
-uint16_t ducky_get_keycode_by_name(const char* param);
-
-bool ducky_get_number(const char* param, uint32_t* val);
-
 void ducky_numlock_on(void);
 
 bool ducky_numpad_press(const char num);
@@ -61,7 +50,10 @@ bool ducky_altstring(const char* param);
 
 bool ducky_string(BadUsbScript* bad_usb, const char* param);
 
-int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line);
+int32_t ducky_execute_instruction(
+    BadUsbScript* bad_usb,
+    const DuckyInstruction* instruction,
+    const char* text);
 
 int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...);
 
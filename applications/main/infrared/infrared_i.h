@@ -22,10 +22,10 @@
 #include <notification/notification_messages.h>
 
 #include <infrared_worker.h>
+#include <infraredsrv/infrared_brute_force.h>
 
 #include "infrared.h"
 #include "infrared_remote.h"
-#include "infrared_brute_force.h"
 #include "infrared_custom_event.h"
 
 #include "scenes/infrared_scene.h"
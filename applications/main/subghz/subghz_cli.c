@@ -8,7 +8,7 @@
 
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
-#include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_file_decoder.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <applications/drivers/subghz/cc1101_ext/cc1101_ext_interconnect.h>
 #include <lib/subghz/devices/cc1101_int/cc1101_int_interconnect.h>
@@ -464,116 +464,182 @@ void subghz_cli_command_rx_raw(Cli* cli, FuriString* args, void* context) {
     free(instance);
 }
 
-void subghz_cli_command_decode_raw(Cli* cli, FuriString* args, void* context) {
-    UNUSED(context);
-    FuriString* file_name = furi_string_alloc();
-    furi_string_set(file_name, ANY_PATH("subghz/test.sub"));
+// decode_raw prints one JSON object per line, so output can be parsed by scripts
+static void subghz_cli_json_cat_string(FuriString* json, const char* str) {
+    furi_string_push_back(json, '"');
+    for(; *str; str++) {
+        if(*str == '"' || *str == '\\') {
+            furi_string_push_back(json, '\\');
+            furi_string_push_back(json, *str);
+        } else if(*str == '\r') {
+            furi_string_cat_str(json, "\\r");
+        } else if(*str == '\n') {
+            furi_string_cat_str(json, "\\n");
+        } else if((uint8_t)*str < 0x20) {
+            furi_string_cat_printf(json, "\\u%04X", (uint8_t)*str);
+        } else {
+            furi_string_push_back(json, *str);
+        }
+    }
+    furi_string_push_back(json, '"');
+}
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    FlipperFormat* fff_data_file = flipper_format_file_alloc(storage);
-    FuriString* temp_str = furi_string_alloc();
-    uint32_t temp_data32;
-    bool check_file = false;
+static void subghz_cli_json_print_error(const char* file_name, const char* error) {
+    FuriString* json = furi_string_alloc_set("{\"file\":");
+    subghz_cli_json_cat_string(json, file_name);
+    furi_string_cat_printf(json, ",\"error\":\"%s\"}\r\n", error);
+    printf("%s", furi_string_get_cstr(json));
+    furi_string_free(json);
+}
 
-    do {
-        if(furi_string_size(args)) {
-            if(!args_read_string_and_trim(args, file_name)) {
-                cli_print_usage(
-                    "subghz decode_raw", "<file_name: path_RAW_file>", furi_string_get_cstr(args));
-                break;
-            }
-        }
+static void subghz_cli_command_decode_raw_callback(
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    FuriString* file_name = context;
+    FuriString* text = furi_string_alloc();
+    subghz_protocol_decoder_base_get_string(decoder_base, text);
+    furi_string_trim(text);
+
+    FuriString* json = furi_string_alloc_set("{\"file\":");
+    subghz_cli_json_cat_string(json, furi_string_get_cstr(file_name));
+    furi_string_cat_str(json, ",\"protocol\":");
+    subghz_cli_json_cat_string(json, decoder_base->protocol->name);
+    furi_string_cat_str(json, ",\"data\":");
+    subghz_cli_json_cat_string(json, furi_string_get_cstr(text));
+    furi_string_cat_str(json, "}\r\n");
+    printf("%s", furi_string_get_cstr(json));
+
+    furi_string_free(json);
+    furi_string_free(text);
+}
 
-        if(!flipper_format_file_open_existing(fff_data_file, furi_string_get_cstr(file_name))) {
-            printf(
-                "subghz decode_raw \033[0;31mError open file\033[0m %s\r\n",
-                furi_string_get_cstr(file_name));
-            break;
-        }
+static bool subghz_cli_command_decode_raw_file(
+    Cli* cli,
+    SubGhzFileDecoder* file_decoder,
+    SubGhzKeystore* keystore,
+    FuriString* file_name) {
+    if(!subghz_file_decoder_start(file_decoder, furi_string_get_cstr(file_name))) {
+        subghz_cli_json_print_error(furi_string_get_cstr(file_name), "not a RAW file");
+        return true;
+    }
 
-        if(!flipper_format_read_header(fff_data_file, temp_str, &temp_data32)) {
-            printf("subghz decode_raw \033[0;31mMissing or incorrect header\033[0m\r\n");
-            break;
-        }
+    subghz_keystore_reset_kl_stats(keystore);
 
-        if(!strcmp(furi_string_get_cstr(temp_str), SUBGHZ_RAW_FILE_TYPE) &&
-           temp_data32 == SUBGHZ_KEY_FILE_VERSION) {
-        } else {
-            printf("subghz decode_raw \033[0;31mType or version mismatch\033[0m\r\n");
+    bool is_interrupted = false;
+    uint32_t start = furi_get_tick();
+    while(subghz_file_decoder_process(file_decoder)) {
+        if(cli_cmd_interrupt_received(cli)) {
+            is_interrupted = true;
             break;
         }
+    }
+    uint32_t elapsed = furi_get_tick() - start;
+    subghz_file_decoder_stop(file_decoder);
+
+    // Summary of the file follows its packets
+    FuriString* json = furi_string_alloc_set("{\"file\":");
+    subghz_cli_json_cat_string(json, furi_string_get_cstr(file_name));
+    furi_string_cat_printf(
+        json,
+        ",\"packets\":%lu,\"pulses\":%lu,\"time_ms\":%lu",
+        subghz_file_decoder_get_packet_count(file_decoder),
+        subghz_file_decoder_get_pulse_count(file_decoder),
+        furi_kernel_get_tick_frequency() ? elapsed * 1000 / furi_kernel_get_tick_frequency() :
+                                           elapsed);
+
+    const SubGhzKeystoreKlStats* kl_stats = subghz_keystore_get_kl_stats(keystore);
+    if(kl_stats->packets) {
+        furi_string_cat_printf(
+            json,
+            ",\"keeloq\":{\"packets\":%lu,\"attempts\":%lu,\"attempts_max\":%lu,"
+            "\"cache_hits\":%lu}",
+            kl_stats->packets,
+            kl_stats->attempts,
+            kl_stats->attempts_max,
+            kl_stats->cache_hits);
+    }
+    if(is_interrupted) {
+        furi_string_cat_str(json, ",\"interrupted\":true");
+    }
+    furi_string_cat_str(json, "}\r\n");
+    printf("%s", furi_string_get_cstr(json));
+    furi_string_free(json);
 
-        check_file = true;
-    } while(false);
-
-    furi_string_free(temp_str);
-    flipper_format_free(fff_data_file);
-    furi_record_close(RECORD_STORAGE);
+    return !is_interrupted;
+}
 
-    if(check_file) {
-        // Allocate context
-        SubGhzCliCommandRx* instance = malloc(sizeof(SubGhzCliCommandRx));
+void subghz_cli_command_decode_raw(Cli* cli, FuriString* args, void* context) {
+    UNUSED(context);
+    FuriString* file_name = furi_string_alloc();
+    furi_string_set(file_name, ANY_PATH("subghz/test.sub"));
 
-        SubGhzEnvironment* environment = subghz_environment_alloc();
-        if(subghz_environment_load_keystore(environment, SUBGHZ_KEYSTORE_DIR_NAME)) {
-            printf("SubGhz decode_raw: Load_keystore keeloq_mfcodes \033[0;32mOK\033[0m\r\n");
-        } else {
-            printf("SubGhz decode_raw: Load_keystore keeloq_mfcodes \033[0;31mERROR\033[0m\r\n");
-        }
-        if(subghz_environment_load_keystore(environment, SUBGHZ_KEYSTORE_DIR_USER_NAME)) {
-            printf("SubGhz decode_raw: Load_keystore keeloq_mfcodes_user \033[0;32mOK\033[0m\r\n");
-        } else {
-            printf(
-                "SubGhz decode_raw: Load_keystore keeloq_mfcodes_user \033[0;31mERROR\033[0m\r\n");
+    if(furi_string_size(args)) {
+        if(!args_read_string_and_trim(args, file_name)) {
+            cli_print_usage(
+                "subghz decode_raw",
+                "<file_name: path_RAW_file or directory>",
+                furi_string_get_cstr(args));
+            furi_string_free(file_name);
+            return;
         }
-        subghz_environment_set_came_atomo_rainbow_table_file_name(
-            environment, SUBGHZ_CAME_ATOMO_DIR_NAME);
-        subghz_environment_set_alutech_at_4n_rainbow_table_file_name(
-            environment, SUBGHZ_ALUTECH_AT_4N_DIR_NAME);
-        subghz_environment_set_nice_flor_s_rainbow_table_file_name(
-            environment, SUBGHZ_NICE_FLOR_S_DIR_NAME);
-        subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
-
-        SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
-        subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
-        subghz_receiver_set_rx_callback(receiver, subghz_cli_command_rx_callback, instance);
+    }
 
-        SubGhzFileEncoderWorker* file_worker_encoder = subghz_file_encoder_worker_alloc();
-        if(subghz_file_encoder_worker_start(
-               file_worker_encoder, furi_string_get_cstr(file_name), NULL)) {
-            //the worker needs a file in order to open and read part of the file
-            furi_delay_ms(100);
-        }
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FileInfo file_info;
+    if(storage_common_stat(storage, furi_string_get_cstr(file_name), &file_info) != FSE_OK) {
+        subghz_cli_json_print_error(furi_string_get_cstr(file_name), "can't open");
+        furi_record_close(RECORD_STORAGE);
+        furi_string_free(file_name);
+        return;
+    }
 
-        printf(
-            "Listening at %s.\r\n\r\nPress CTRL+C to stop\r\n\r\n",
-            furi_string_get_cstr(file_name));
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    bool keystore_loaded = subghz_environment_load_keystore(environment, SUBGHZ_KEYSTORE_DIR_NAME);
+    bool keystore_user_loaded =
+        subghz_environment_load_keystore(environment, SUBGHZ_KEYSTORE_DIR_USER_NAME);
+    printf(
+        "{\"keystore\":%s,\"keystore_user\":%s}\r\n",
+        keystore_loaded ? "true" : "false",
+        keystore_user_loaded ? "true" : "false");
+    subghz_environment_set_came_atomo_rainbow_table_file_name(
+        environment, SUBGHZ_CAME_ATOMO_DIR_NAME);
+    subghz_environment_set_alutech_at_4n_rainbow_table_file_name(
+        environment, SUBGHZ_ALUTECH_AT_4N_DIR_NAME);
+    subghz_environment_set_nice_flor_s_rainbow_table_file_name(
+        environment, SUBGHZ_NICE_FLOR_S_DIR_NAME);
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
 
-        LevelDuration level_duration;
-        while(!cli_cmd_interrupt_received(cli)) {
-            furi_delay_us(500); //you need to have time to read from the file from the SD card
-            level_duration = subghz_file_encoder_worker_get_level_duration(file_worker_encoder);
-            if(!level_duration_is_reset(level_duration)) {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-                subghz_receiver_decode(receiver, level, duration);
-            } else {
-                break;
+    SubGhzKeystore* keystore = subghz_environment_get_keystore(environment);
+    SubGhzFileDecoder* file_decoder = subghz_file_decoder_alloc(environment);
+    FuriString* path = furi_string_alloc();
+    subghz_file_decoder_set_callback(file_decoder, subghz_cli_command_decode_raw_callback, path);
+
+    if(file_info_is_dir(&file_info)) {
+        // Decode every RAW file of the directory one after another
+        File* dir = storage_file_alloc(storage);
+        char name[256];
+        if(storage_dir_open(dir, furi_string_get_cstr(file_name))) {
+            while(storage_dir_read(dir, &file_info, name, sizeof(name))) {
+                if(file_info_is_dir(&file_info)) continue;
+                furi_string_printf(path, "%s/%s", furi_string_get_cstr(file_name), name);
+                if(!furi_string_end_with_str(path, SUBGHZ_APP_EXTENSION)) continue;
+                if(!subghz_cli_command_decode_raw_file(cli, file_decoder, keystore, path)) {
+                    break;
+                }
             }
         }
-
-        printf("\r\nPackets received \033[0;32m%u\033[0m\r\n", instance->packet_count);
-
-        // Cleanup
-        subghz_receiver_free(receiver);
-        subghz_environment_free(environment);
-
-        if(subghz_file_encoder_worker_is_running(file_worker_encoder)) {
-            subghz_file_encoder_worker_stop(file_worker_encoder);
-        }
-        subghz_file_encoder_worker_free(file_worker_encoder);
-        free(instance);
+        storage_dir_close(dir);
+        storage_file_free(dir);
+    } else {
+        furi_string_set(path, file_name);
+        subghz_cli_command_decode_raw_file(cli, file_decoder, keystore, path);
     }
+
+    // Cleanup
+    furi_string_free(path);
+    subghz_file_decoder_free(file_decoder);
+    subghz_environment_free(environment);
+    furi_record_close(RECORD_STORAGE);
     furi_string_free(file_name);
 }
 
@@ -588,7 +654,8 @@ static void subghz_cli_command_print_usage() {
         "\ttx <3 byte Key: in hex> <frequency: in Hz> <te: us> <repeat: count> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Transmitting key\r\n");
     printf("\trx <frequency:in Hz> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Receive\r\n");
     printf("\trx_raw <frequency:in Hz>\t - Receive RAW\r\n");
-    printf("\tdecode_raw <file_name: path_RAW_file>\t - Testing\r\n");
+    printf(
+        "\tdecode_raw <file_name: path_RAW_file or directory>\t - Decode RAW files to JSON lines\r\n");
 
     if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
         printf("\r\n");
@@ -23,6 +23,7 @@ Canvas* canvas_init() {
 
     // Setup u8g2
     u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
+    canvas->sent_buffer = malloc(canvas_get_buffer_size(canvas));
     canvas->orientation = CanvasOrientationHorizontal;
     // Initialize display
     u8g2_InitDisplay(&canvas->fb);
@@ -39,6 +40,7 @@ Canvas* canvas_init() {
 void canvas_free(Canvas* canvas) {
     furi_assert(canvas);
     compress_icon_free(canvas->compress_icon);
+    free(canvas->sent_buffer);
     free(canvas);
 }
 
@@ -54,7 +56,42 @@ void canvas_reset(Canvas* canvas) {
 
 void canvas_commit(Canvas* canvas) {
     furi_assert(canvas);
-    u8g2_SendBuffer(&canvas->fb);
+    uint8_t* buffer = u8g2_GetBufferPtr(&canvas->fb);
+
+    if(!canvas->sent_buffer_valid) {
+        u8g2_SendBuffer(&canvas->fb);
+        memcpy(canvas->sent_buffer, buffer, canvas_get_buffer_size(canvas));
+        canvas->sent_buffer_valid = true;
+        return;
+    }
+
+    // Send only changed tiles of every page, usually most of the frame stays the same
+    const uint8_t tile_width = u8g2_GetBufferTileWidth(&canvas->fb);
+    const uint8_t tile_height = u8g2_GetBufferTileHeight(&canvas->fb);
+    const size_t page_size = tile_width * 8;
+    for(uint8_t page = 0; page < tile_height; page++) {
+        uint8_t* current = buffer + page * page_size;
+        uint8_t* sent = canvas->sent_buffer + page * page_size;
+
+        uint8_t first = 0;
+        while(first < tile_width && memcmp(&current[first * 8], &sent[first * 8], 8) == 0) {
+            first++;
+        }
+        if(first == tile_width) continue;
+
+        uint8_t last = tile_width - 1;
+        while(last > first && memcmp(&current[last * 8], &sent[last * 8], 8) == 0) {
+            last--;
+        }
+
+        u8g2_UpdateDisplayArea(&canvas->fb, first, page, last - first + 1, 1);
+        memcpy(&sent[first * 8], &current[first * 8], (last - first + 1) * 8);
+    }
+}
+
+void canvas_invalidate(Canvas* canvas) {
+    furi_assert(canvas);
+    canvas->sent_buffer_valid = false;
 }
 
 uint8_t* canvas_get_buffer(Canvas* canvas) {
@@ -80,6 +117,32 @@ void canvas_frame_set(
     canvas->height = height;
 }
 
+void canvas_clip_set(Canvas* canvas, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    furi_assert(canvas);
+    canvas->clip = true;
+    canvas->clip_x = x;
+    canvas->clip_y = y;
+    canvas->clip_width = width;
+    canvas->clip_height = height;
+    u8g2_SetClipWindow(&canvas->fb, x, y, x + width, y + height);
+}
+
+void canvas_clip_reset(Canvas* canvas) {
+    furi_assert(canvas);
+    canvas->clip = false;
+    u8g2_SetMaxClipWindow(&canvas->fb);
+}
+
+bool canvas_frame_is_visible(const Canvas* canvas) {
+    furi_assert(canvas);
+    if(!canvas->clip) return true;
+
+    return canvas->offset_x < canvas->clip_x + canvas->clip_width &&
+           canvas->clip_x < canvas->offset_x + canvas->width &&
+           canvas->offset_y < canvas->clip_y + canvas->clip_height &&
+           canvas->clip_y < canvas->offset_y + canvas->height;
+}
+
 uint8_t canvas_width(const Canvas* canvas) {
     furi_assert(canvas);
     return canvas->width;
@@ -114,7 +177,18 @@ const CanvasFontParameters* canvas_get_font_params(const Canvas* canvas, Font fo
 
 void canvas_clear(Canvas* canvas) {
     furi_assert(canvas);
-    if(CFW_SETTINGS()->dark_mode) {
+    if(canvas->clip) {
+        // Partial redraw: keep everything outside of the redraw area
+        uint8_t color = u8g2_GetDrawColor(&canvas->fb);
+        u8g2_SetDrawColor(&canvas->fb, CFW_SETTINGS()->dark_mode ? ColorBlack : ColorWhite);
+        u8g2_DrawBox(
+            &canvas->fb,
+            canvas->clip_x,
+            canvas->clip_y,
+            canvas->clip_width,
+            canvas->clip_height);
+        u8g2_SetDrawColor(&canvas->fb, color);
+    } else if(CFW_SETTINGS()->dark_mode) {
         u8g2_FillBuffer(&canvas->fb);
     } else {
         u8g2_ClearBuffer(&canvas->fb);
@@ -23,6 +23,15 @@ struct Canvas {
     uint8_t width;
     uint8_t height;
     CompressIcon* compress_icon;
+    // Redraw area, drawing outside of it is discarded
+    bool clip;
+    uint8_t clip_x;
+    uint8_t clip_y;
+    uint8_t clip_width;
+    uint8_t clip_height;
+    // Copy of the frame sent to display, only changed pages are sent on commit
+    uint8_t* sent_buffer;
+    bool sent_buffer_valid;
 };
 
 /** Allocate memory and initialize canvas
@@ -68,6 +77,42 @@ void canvas_frame_set(
     uint8_t width,
     uint8_t height);
 
+/** Restrict drawing to screen area
+ *
+ * Used for partial redraw: canvas_clear only clears this area and everything
+ * drawn outside of it is discarded. Coordinates are in horizontal orientation.
+ *
+ * @param      canvas  Canvas instance
+ * @param      x       x coordinate
+ * @param      y       y coordinate
+ * @param      width   width
+ * @param      height  height
+ */
+void canvas_clip_set(Canvas* canvas, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+/** Remove drawing area restriction set by canvas_clip_set
+ *
+ * @param      canvas  Canvas instance
+ */
+void canvas_clip_reset(Canvas* canvas);
+
+/** Check if current drawing region intersects drawing area
+ *
+ * @param      canvas  Canvas instance
+ *
+ * @return     true if something drawn in current region can be visible
+ */
+bool canvas_frame_is_visible(const Canvas* canvas);
+
+/** Forget display contents, next commit sends the whole buffer
+ *
+ * Must be called when display RAM was changed bypassing canvas_commit,
+ * for example after display controller reinitialization.
+ *
+ * @param      canvas  Canvas instance
+ */
+void canvas_invalidate(Canvas* canvas);
+
 /** Set canvas orientation
  *
  * @param      canvas       Canvas instance
@@ -41,9 +41,53 @@ uint8_t gui_get_count_of_enabled_view_port_in_layer(Gui* gui, GuiLayer layer) {
 
 void gui_update(Gui* gui) {
     furi_assert(gui);
+    gui->damage_full = true;
     if(!gui->direct_draw) furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_DRAW);
 }
 
+void gui_update_view_port(
+    Gui* gui,
+    ViewPort* view_port,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height) {
+    furi_assert(gui);
+    furi_assert(view_port);
+    bool damaged = false;
+
+    FURI_CRITICAL_ENTER();
+    if(view_port->drawn_generation != gui->redraw_generation) {
+        // Not on screen, will be drawn with the next full redraw if it becomes visible
+    } else if(!view_port->drawn_horizontal) {
+        // Damage is tracked in horizontal coordinates only
+        gui->damage_full = true;
+        damaged = true;
+    } else if(x < view_port->drawn_width && y < view_port->drawn_height) {
+        uint8_t x0 = view_port->drawn_x + x;
+        uint8_t y0 = view_port->drawn_y + y;
+        uint8_t x1 = view_port->drawn_x + MIN(x + width, view_port->drawn_width);
+        uint8_t y1 = view_port->drawn_y + MIN(y + height, view_port->drawn_height);
+        if(gui->damage_x0 >= gui->damage_x1 || gui->damage_y0 >= gui->damage_y1) {
+            gui->damage_x0 = x0;
+            gui->damage_y0 = y0;
+            gui->damage_x1 = x1;
+            gui->damage_y1 = y1;
+        } else {
+            gui->damage_x0 = MIN(gui->damage_x0, x0);
+            gui->damage_y0 = MIN(gui->damage_y0, y0);
+            gui->damage_x1 = MAX(gui->damage_x1, x1);
+            gui->damage_y1 = MAX(gui->damage_y1, y1);
+        }
+        damaged = true;
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(damaged && !gui->direct_draw) {
+        furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_DRAW);
+    }
+}
+
 void gui_input_events_callback(const void* value, void* ctx) {
     furi_assert(value);
     furi_assert(ctx);
@@ -339,6 +383,33 @@ static void gui_redraw(Gui* gui) {
     do {
         if(gui->direct_draw) break;
 
+        // Take accumulated damage
+        FURI_CRITICAL_ENTER();
+        bool partial = !gui->damage_full;
+        uint8_t x0 = gui->damage_x0;
+        uint8_t y0 = gui->damage_y0;
+        uint8_t x1 = MIN(gui->damage_x1, GUI_DISPLAY_WIDTH);
+        uint8_t y1 = MIN(gui->damage_y1, GUI_DISPLAY_HEIGHT);
+        gui->damage_full = false;
+        gui->damage_x0 = gui->damage_y0 = gui->damage_x1 = gui->damage_y1 = 0;
+        FURI_CRITICAL_EXIT();
+
+        if(partial) {
+            // Already drawn by previous redraw
+            if(x0 >= x1 || y0 >= y1) break;
+            // Status bar is drawn flipped, damage is in horizontal coordinates
+            if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagHandOrient)) partial = false;
+            if(x1 - x0 == GUI_DISPLAY_WIDTH && y1 - y0 == GUI_DISPLAY_HEIGHT) partial = false;
+        }
+
+        if(partial) {
+            // Only ViewPorts intersecting damaged area are drawn
+            canvas_clip_set(gui->canvas, x0, y0, x1 - x0, y1 - y0);
+        } else {
+            // ViewPorts drawn by full redraw are the ones visible on screen
+            gui->redraw_generation++;
+        }
+
         canvas_reset(gui->canvas);
 
         if(gui->lockdown) {
@@ -356,6 +427,8 @@ static void gui_redraw(Gui* gui) {
             }
         }
 
+        if(partial) canvas_clip_reset(gui->canvas);
+
         canvas_commit(gui->canvas);
         for
             M_EACH(p, gui->canvas_callback_pair, CanvasCallbackPairArray_t) {
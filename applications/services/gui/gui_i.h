@@ -69,6 +69,14 @@ struct Gui {
     Canvas* canvas;
     CanvasCallbackPairArray_t canvas_callback_pair;
 
+    // Damaged screen area, accumulated between redraws
+    uint32_t redraw_generation;
+    bool damage_full;
+    uint8_t damage_x0;
+    uint8_t damage_y0;
+    uint8_t damage_x1;
+    uint8_t damage_y1;
+
     // Input
     FuriMessageQueue* input_queue;
     FuriPubSub* input_events;
@@ -84,6 +92,26 @@ ViewPort* gui_view_port_find_enabled(ViewPortArray_t array);
  */
 void gui_update(Gui* gui);
 
+/** Update GUI, request redraw of ViewPort area
+ *
+ * Area is clipped to the ViewPort frame of the last redraw. Updates of
+ * ViewPorts that were not visible on the last redraw are ignored.
+ *
+ * @param      gui        Gui instance
+ * @param      view_port  ViewPort instance
+ * @param      x          x coordinate in ViewPort frame
+ * @param      y          y coordinate in ViewPort frame
+ * @param      width      area width
+ * @param      height     area height
+ */
+void gui_update_view_port(
+    Gui* gui,
+    ViewPort* view_port,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height);
+
 void gui_input_events_callback(const void* value, void* ctx);
 
 void gui_lock(Gui* gui);
@@ -0,0 +1,550 @@
+#include "file_browser_index.h"
+
+#include <m-array.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define TAG "BrowserIndex"
+
+#define BROWSER_INDEX_MAGIC (0x58444942UL) // "BIDX"
+#define BROWSER_INDEX_VERSION (1)
+
+#define BROWSER_INDEX_NAME_LEN_MAX 255
+#define BROWSER_INDEX_FILE_NAME_LEN 32
+#define BROWSER_INDEX_KEY_SEPARATOR '|'
+#define BROWSER_INDEX_WRITE_BUFFER_SIZE 512
+// Builder keeps all names in RAM to sort them
+#define BROWSER_INDEX_BUILDER_SIZE_MAX (48 * 1024)
+#define BROWSER_INDEX_BUILDER_HEAP_RESERVE (16 * 1024)
+#define BROWSER_INDEX_BUILDER_CHUNK (1024)
+
+#define BROWSER_INDEX_FLAG_FOLDER (1 << 0)
+// Set only in builder RAM, entries with this flag are sorted after others
+#define BROWSER_INDEX_FLAG_SORT_LAST (1 << 1)
+
+/* Index file layout:
+ * BrowserIndexHeader
+ * key, key_length bytes
+ * uint32_t offsets[count + 1], record offsets from the first record
+ * records: uint8_t flags, uint8_t name_length, name without terminator
+ */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t key_length;
+    uint32_t count;
+    uint32_t fingerprint;
+} BrowserIndexHeader;
+
+struct BrowserIndex {
+    Storage* storage;
+    File* file;
+    FuriString* path;
+    BrowserIndexHeader header;
+    bool is_open;
+    bool dirs_first;
+    uint32_t offsets_start;
+    uint32_t records_start;
+    uint32_t position;
+    char name[BROWSER_INDEX_NAME_LEN_MAX + 1];
+};
+
+ARRAY_DEF(browser_index_offsets, uint32_t, M_POD_OPLIST)
+
+struct BrowserIndexBuilder {
+    // Entries are stored as flags byte followed by zero terminated name
+    char* data;
+    size_t data_size;
+    size_t data_capacity;
+    browser_index_offsets_t offsets;
+    uint32_t fingerprint;
+    bool overflow;
+};
+
+static uint32_t browser_index_hash(const char* data, size_t size, uint32_t hash) {
+    // FNV-1a
+    for(size_t i = 0; i < size; i++) {
+        hash ^= (uint8_t)data[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+uint32_t browser_index_entry_hash(const char* name, bool is_folder) {
+    const char flags = is_folder ? BROWSER_INDEX_FLAG_FOLDER : 0;
+    uint32_t hash = browser_index_hash(&flags, 1, 2166136261UL);
+    return browser_index_hash(name, strlen(name), hash);
+}
+
+static void browser_index_get_path(FuriString* path, const char* key) {
+    furi_string_printf(
+        path,
+        "%s/%08lX.idx",
+        BROWSER_INDEX_DIR,
+        browser_index_hash(key, strlen(key), 2166136261UL));
+}
+
+static int browser_index_compare(
+    const char* name_a,
+    bool is_folder_a,
+    const char* name_b,
+    bool is_folder_b,
+    bool dirs_first) {
+    if(dirs_first && (is_folder_a != is_folder_b)) {
+        return is_folder_a ? -1 : 1;
+    }
+    int result = strcasecmp(name_a, name_b);
+    // Keep order stable for names different only in case
+    return (result != 0) ? result : strcmp(name_a, name_b);
+}
+
+BrowserIndex* browser_index_alloc(Storage* storage) {
+    furi_assert(storage);
+    BrowserIndex* index = malloc(sizeof(BrowserIndex));
+    index->storage = storage;
+    index->file = storage_file_alloc(storage);
+    index->path = furi_string_alloc();
+    return index;
+}
+
+void browser_index_free(BrowserIndex* index) {
+    furi_assert(index);
+    browser_index_close(index);
+    storage_file_free(index->file);
+    furi_string_free(index->path);
+    free(index);
+}
+
+bool browser_index_open(BrowserIndex* index, const char* key, bool dirs_first) {
+    furi_assert(index);
+    furi_assert(key);
+
+    browser_index_close(index);
+    browser_index_get_path(index->path, key);
+
+    bool result = false;
+    char* file_key = NULL;
+    do {
+        if(!storage_file_open(
+               index->file, furi_string_get_cstr(index->path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+            break;
+        }
+        index->is_open = true;
+
+        BrowserIndexHeader* header = &index->header;
+        if(storage_file_read(index->file, header, sizeof(BrowserIndexHeader)) !=
+           sizeof(BrowserIndexHeader)) {
+            break;
+        }
+        if((header->magic != BROWSER_INDEX_MAGIC) || (header->version != BROWSER_INDEX_VERSION)) {
+            break;
+        }
+
+        // Different keys may have the same file name
+        size_t key_length = strlen(key);
+        if(header->key_length != key_length) {
+            break;
+        }
+        file_key = malloc(key_length);
+        if(storage_file_read(index->file, file_key, key_length) != key_length) {
+            break;
+        }
+        if(memcmp(file_key, key, key_length) != 0) {
+            break;
+        }
+
+        index->dirs_first = dirs_first;
+        index->offsets_start = sizeof(BrowserIndexHeader) + key_length;
+        index->records_start = index->offsets_start + (header->count + 1) * sizeof(uint32_t);
+        index->position = header->count;
+        result = true;
+    } while(false);
+
+    free(file_key);
+    if(!result) {
+        browser_index_close(index);
+    }
+
+    return result;
+}
+
+void browser_index_close(BrowserIndex* index) {
+    furi_assert(index);
+    if(index->is_open) {
+        storage_file_close(index->file);
+        index->is_open = false;
+    }
+    memset(&index->header, 0, sizeof(BrowserIndexHeader));
+}
+
+bool browser_index_is_open(BrowserIndex* index) {
+    furi_assert(index);
+    return index->is_open;
+}
+
+uint32_t browser_index_get_count(BrowserIndex* index) {
+    furi_assert(index);
+    return index->header.count;
+}
+
+uint32_t browser_index_get_fingerprint(BrowserIndex* index) {
+    furi_assert(index);
+    return index->header.fingerprint;
+}
+
+bool browser_index_seek(BrowserIndex* index, uint32_t offset) {
+    furi_assert(index);
+
+    bool result = false;
+    do {
+        if(!index->is_open || (offset > index->header.count)) break;
+
+        uint32_t record_offset = 0;
+        if(!storage_file_seek(
+               index->file, index->offsets_start + offset * sizeof(uint32_t), true)) {
+            break;
+        }
+        if(storage_file_read(index->file, &record_offset, sizeof(uint32_t)) !=
+           sizeof(uint32_t)) {
+            break;
+        }
+        if(!storage_file_seek(index->file, index->records_start + record_offset, true)) {
+            break;
+        }
+
+        index->position = offset;
+        result = true;
+    } while(false);
+
+    return result;
+}
+
+bool browser_index_read_next(BrowserIndex* index, FuriString* name, bool* is_folder) {
+    furi_assert(index);
+
+    if(!index->is_open || (index->position >= index->header.count)) {
+        return false;
+    }
+
+    uint8_t record[2];
+    if(storage_file_read(index->file, record, sizeof(record)) != sizeof(record)) {
+        return false;
+    }
+    if(storage_file_read(index->file, index->name, record[1]) != record[1]) {
+        return false;
+    }
+    index->name[record[1]] = '\0';
+    index->position++;
+
+    if(name) {
+        furi_string_set(name, index->name);
+    }
+    if(is_folder) {
+        *is_folder = (record[0] & BROWSER_INDEX_FLAG_FOLDER);
+    }
+
+    return true;
+}
+
+int32_t browser_index_find(BrowserIndex* index, const char* name, bool is_folder) {
+    furi_assert(index);
+    furi_assert(name);
+
+    if(!index->is_open) {
+        return -1;
+    }
+
+    // Entries are sorted, so only log2(count) records are read
+    uint32_t low = 0;
+    uint32_t high = index->header.count;
+    while(low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        bool mid_is_folder = false;
+        if(!browser_index_seek(index, mid) ||
+           !browser_index_read_next(index, NULL, &mid_is_folder)) {
+            break;
+        }
+
+        int result =
+            browser_index_compare(index->name, mid_is_folder, name, is_folder, index->dirs_first);
+        if(result == 0) {
+            return mid;
+        } else if(result < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return -1;
+}
+
+void browser_index_remove(Storage* storage, const char* key) {
+    furi_assert(storage);
+    furi_assert(key);
+
+    FuriString* path = furi_string_alloc();
+    browser_index_get_path(path, key);
+    storage_common_remove(storage, furi_string_get_cstr(path));
+    furi_string_free(path);
+}
+
+static bool browser_index_is_stale(Storage* storage, const char* path) {
+    File* file = storage_file_alloc(storage);
+    BrowserIndexHeader header;
+    bool stale = true;
+
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+       (storage_file_read(file, &header, sizeof(header)) == sizeof(header)) &&
+       (header.magic == BROWSER_INDEX_MAGIC) && (header.version == BROWSER_INDEX_VERSION)) {
+        char* key = malloc(header.key_length + 1);
+        if(storage_file_read(file, key, header.key_length) == header.key_length) {
+            key[header.key_length] = '\0';
+            char* separator = strchr(key, BROWSER_INDEX_KEY_SEPARATOR);
+            if(separator) {
+                *separator = '\0';
+            }
+            stale = !storage_dir_exists(storage, key);
+        }
+        free(key);
+    }
+    storage_file_free(file);
+
+    return stale;
+}
+
+void browser_index_prune(Storage* storage, const char* key) {
+    furi_assert(storage);
+
+    File* dir = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    FuriString* keep_path = furi_string_alloc();
+    char name[BROWSER_INDEX_FILE_NAME_LEN];
+    FileInfo fileinfo;
+    bool found;
+
+    if(key) {
+        browser_index_get_path(keep_path, key);
+    }
+
+    do {
+        found = false;
+        if(!storage_dir_open(dir, BROWSER_INDEX_DIR)) break;
+
+        while(storage_dir_read(dir, &fileinfo, name, sizeof(name))) {
+            furi_string_printf(path, "%s/%s", BROWSER_INDEX_DIR, name);
+            if(file_info_is_dir(&fileinfo) || !furi_string_end_with_str(path, ".idx") ||
+               furi_string_equal(path, keep_path)) {
+                continue;
+            }
+
+            if(browser_index_is_stale(storage, furi_string_get_cstr(path))) {
+                found = true;
+                break;
+            }
+        }
+
+        // Directory is read again after each removal
+        storage_dir_close(dir);
+    } while(found && storage_common_remove(storage, furi_string_get_cstr(path)) == FSE_OK);
+
+    furi_string_free(keep_path);
+    furi_string_free(path);
+    storage_file_free(dir);
+}
+
+BrowserIndexBuilder* browser_index_builder_alloc() {
+    BrowserIndexBuilder* builder = malloc(sizeof(BrowserIndexBuilder));
+    browser_index_offsets_init(builder->offsets);
+    return builder;
+}
+
+void browser_index_builder_free(BrowserIndexBuilder* builder) {
+    furi_assert(builder);
+    browser_index_offsets_clear(builder->offsets);
+    free(builder->data);
+    free(builder);
+}
+
+bool browser_index_builder_add(BrowserIndexBuilder* builder, const char* name, bool is_folder) {
+    furi_assert(builder);
+    furi_assert(name);
+
+    size_t name_length = strlen(name);
+    if(builder->overflow || (name_length > BROWSER_INDEX_NAME_LEN_MAX)) {
+        builder->overflow = true;
+        return false;
+    }
+
+    size_t entry_size = name_length + 2;
+    if(builder->data_size + entry_size > builder->data_capacity) {
+        size_t capacity = builder->data_capacity + MAX(entry_size, BROWSER_INDEX_BUILDER_CHUNK);
+        if((capacity > BROWSER_INDEX_BUILDER_SIZE_MAX) ||
+           (memmgr_heap_get_max_free_block() < capacity + BROWSER_INDEX_BUILDER_HEAP_RESERVE)) {
+            FURI_LOG_W(TAG, "Too many entries to index");
+            builder->overflow = true;
+            return false;
+        }
+        builder->data = realloc(builder->data, capacity); //-V701
+        builder->data_capacity = capacity;
+    }
+
+    char* entry = &builder->data[builder->data_size];
+    entry[0] = is_folder ? BROWSER_INDEX_FLAG_FOLDER : 0;
+    memcpy(&entry[1], name, name_length + 1);
+    browser_index_offsets_push_back(builder->offsets, builder->data_size);
+    builder->data_size += entry_size;
+    builder->fingerprint += browser_index_entry_hash(name, is_folder);
+
+    return true;
+}
+
+bool browser_index_builder_add_index(
+    BrowserIndexBuilder* builder,
+    BrowserIndex* index,
+    const char* skip) {
+    furi_assert(builder);
+    furi_assert(index);
+
+    if(!browser_index_seek(index, 0)) {
+        return false;
+    }
+
+    bool result = true;
+    bool is_folder = false;
+    while(result && browser_index_read_next(index, NULL, &is_folder)) {
+        if(skip && (strcmp(index->name, skip) == 0)) continue;
+        result = browser_index_builder_add(builder, index->name, is_folder);
+    }
+
+    return result && (index->position == index->header.count);
+}
+
+static int browser_index_builder_sort_cmp(const void* a, const void* b) {
+    const char* entry_a = *(const char* const*)a;
+    const char* entry_b = *(const char* const*)b;
+
+    int result = (entry_a[0] & BROWSER_INDEX_FLAG_SORT_LAST) -
+                 (entry_b[0] & BROWSER_INDEX_FLAG_SORT_LAST);
+    if(result == 0) {
+        result = browser_index_compare(&entry_a[1], false, &entry_b[1], false, false);
+    }
+    return result;
+}
+
+static bool browser_index_write_buffered(
+    File* file,
+    uint8_t* buffer,
+    size_t* buffer_used,
+    const void* data,
+    size_t size) {
+    bool result = true;
+    if(*buffer_used + size > BROWSER_INDEX_WRITE_BUFFER_SIZE) {
+        result = (storage_file_write(file, buffer, *buffer_used) == *buffer_used);
+        *buffer_used = 0;
+    }
+    memcpy(&buffer[*buffer_used], data, size);
+    *buffer_used += size;
+    return result;
+}
+
+bool browser_index_builder_save(
+    BrowserIndexBuilder* builder,
+    Storage* storage,
+    const char* key,
+    bool dirs_first) {
+    furi_assert(builder);
+    furi_assert(storage);
+    furi_assert(key);
+
+    if(builder->overflow) {
+        return false;
+    }
+
+    size_t count = browser_index_offsets_size(builder->offsets);
+    const char** entries = malloc(sizeof(char*) * (count + 1));
+    for(size_t i = 0; i < count; i++) {
+        char* entry = &builder->data[*browser_index_offsets_get(builder->offsets, i)];
+        if(dirs_first && !(entry[0] & BROWSER_INDEX_FLAG_FOLDER)) {
+            entry[0] |= BROWSER_INDEX_FLAG_SORT_LAST;
+        } else {
+            entry[0] &= ~BROWSER_INDEX_FLAG_SORT_LAST;
+        }
+        entries[i] = entry;
+    }
+    qsort(entries, count, sizeof(char*), browser_index_builder_sort_cmp);
+
+    FuriString* path = furi_string_alloc();
+    browser_index_get_path(path, key);
+    File* file = storage_file_alloc(storage);
+    uint8_t* buffer = malloc(BROWSER_INDEX_WRITE_BUFFER_SIZE);
+    size_t buffer_used = 0;
+
+    bool result = false;
+    do {
+        storage_simply_mkdir(storage, BROWSER_INDEX_DIR);
+        if(!storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            break;
+        }
+
+        // Header is written last, so incomplete index is never accepted
+        BrowserIndexHeader header = {
+            .magic = BROWSER_INDEX_MAGIC,
+            .version = BROWSER_INDEX_VERSION,
+            .key_length = strlen(key),
+            .count = count,
+            .fingerprint = builder->fingerprint,
+        };
+        BrowserIndexHeader empty_header = {0};
+        bool write_ok = (storage_file_write(file, &empty_header, sizeof(BrowserIndexHeader)) ==
+                         sizeof(BrowserIndexHeader));
+        write_ok &= (storage_file_write(file, key, header.key_length) == header.key_length);
+
+        uint32_t record_offset = 0;
+        for(size_t i = 0; write_ok && (i <= count); i++) {
+            write_ok = browser_index_write_buffered(
+                file, buffer, &buffer_used, &record_offset, sizeof(uint32_t));
+            if(i < count) {
+                record_offset += strlen(&entries[i][1]) + 2;
+            }
+        }
+
+        for(size_t i = 0; write_ok && (i < count); i++) {
+            uint8_t record[2] = {
+                entries[i][0] & BROWSER_INDEX_FLAG_FOLDER,
+                strlen(&entries[i][1]),
+            };
+            write_ok = browser_index_write_buffered(
+                file, buffer, &buffer_used, record, sizeof(record));
+            write_ok &= browser_index_write_buffered(
+                file, buffer, &buffer_used, &entries[i][1], record[1]);
+        }
+
+        if(!write_ok || (storage_file_write(file, buffer, buffer_used) != buffer_used)) {
+            break;
+        }
+        if(!storage_file_seek(file, 0, true)) {
+            break;
+        }
+        if(storage_file_write(file, &header, sizeof(BrowserIndexHeader)) !=
+           sizeof(BrowserIndexHeader)) {
+            break;
+        }
+        result = true;
+    } while(false);
+
+    storage_file_close(file);
+    if(!result) {
+        FURI_LOG_E(TAG, "Failed to save %s", furi_string_get_cstr(path));
+        storage_common_remove(storage, furi_string_get_cstr(path));
+    }
+
+    free(buffer);
+    storage_file_free(file);
+    furi_string_free(path);
+    free(entries);
+
+    return result;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file file_browser_index.h
+ * Persistent sorted folder index used by file browser worker
+ *
+ * Index file keeps filtered and sorted folder entries, so large folders can be
+ * paged in sorted order without reading and sorting the whole folder in RAM.
+ * Index is bound to a key (folder path and filter settings) and a fingerprint
+ * of its entries, which is compared against the folder contents by the worker.
+ */
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BROWSER_INDEX_DIR CFG_PATH("browser_index")
+
+typedef struct BrowserIndex BrowserIndex;
+typedef struct BrowserIndexBuilder BrowserIndexBuilder;
+
+/** Calculate entry hash, fingerprint is a sum of hashes of all entries
+ *
+ * @param      name       entry name
+ * @param      is_folder  entry is a folder
+ *
+ * @return     entry hash
+ */
+uint32_t browser_index_entry_hash(const char* name, bool is_folder);
+
+/** Allocate index reader
+ *
+ * @param      storage  Storage instance
+ *
+ * @return     BrowserIndex instance
+ */
+BrowserIndex* browser_index_alloc(Storage* storage);
+
+/** Free index reader
+ *
+ * @param      index  BrowserIndex instance
+ */
+void browser_index_free(BrowserIndex* index);
+
+/** Open index file for the key
+ *
+ * @param      index       BrowserIndex instance
+ * @param      key         folder path with filter settings
+ * @param      dirs_first  folders are sorted before files
+ *
+ * @return     true if index exists and belongs to the key
+ */
+bool browser_index_open(BrowserIndex* index, const char* key, bool dirs_first);
+
+/** Close index file
+ *
+ * @param      index  BrowserIndex instance
+ */
+void browser_index_close(BrowserIndex* index);
+
+/** Check if index is open
+ *
+ * @param      index  BrowserIndex instance
+ *
+ * @return     true if open
+ */
+bool browser_index_is_open(BrowserIndex* index);
+
+/** Get entries count
+ *
+ * @param      index  BrowserIndex instance
+ *
+ * @return     entries count
+ */
+uint32_t browser_index_get_count(BrowserIndex* index);
+
+/** Get entries fingerprint
+ *
+ * @param      index  BrowserIndex instance
+ *
+ * @return     sum of browser_index_entry_hash of all entries
+ */
+uint32_t browser_index_get_fingerprint(BrowserIndex* index);
+
+/** Start sequential read of entries
+ *
+ * @param      index   BrowserIndex instance
+ * @param      offset  first entry index
+ *
+ * @return     true on success
+ */
+bool browser_index_seek(BrowserIndex* index, uint32_t offset);
+
+/** Read next entry after browser_index_seek
+ *
+ * @param      index      BrowserIndex instance
+ * @param      name       entry name
+ * @param      is_folder  entry is a folder
+ *
+ * @return     false if there are no more entries or on error
+ */
+bool browser_index_read_next(BrowserIndex* index, FuriString* name, bool* is_folder);
+
+/** Find entry position
+ *
+ * @param      index      BrowserIndex instance
+ * @param      name       entry name
+ * @param      is_folder  entry is a folder
+ *
+ * @return     entry position or -1 if not found
+ */
+int32_t browser_index_find(BrowserIndex* index, const char* name, bool is_folder);
+
+/** Remove index file for the key
+ *
+ * @param      storage  Storage instance
+ * @param      key      folder path with filter settings
+ */
+void browser_index_remove(Storage* storage, const char* key);
+
+/** Remove index files of folders that no longer exist and files of unknown format
+ *
+ * Key must start with folder path, followed by '|' if it has filter settings.
+ *
+ * @param      storage  Storage instance
+ * @param      key      key of the index to keep, can be NULL
+ */
+void browser_index_prune(Storage* storage, const char* key);
+
+/** Allocate index builder
+ *
+ * @return     BrowserIndexBuilder instance
+ */
+BrowserIndexBuilder* browser_index_builder_alloc();
+
+/** Free index builder
+ *
+ * @param      builder  BrowserIndexBuilder instance
+ */
+void browser_index_builder_free(BrowserIndexBuilder* builder);
+
+/** Add entry to builder
+ *
+ * @param      builder    BrowserIndexBuilder instance
+ * @param      name       entry name
+ * @param      is_folder  entry is a folder
+ *
+ * @return     false if builder ran out of memory budget, index must not be saved then
+ */
+bool browser_index_builder_add(BrowserIndexBuilder* builder, const char* name, bool is_folder);
+
+/** Add all entries of an open index to builder
+ *
+ * @param      builder  BrowserIndexBuilder instance
+ * @param      index    open BrowserIndex instance
+ * @param      skip     name of an entry to leave out, can be NULL
+ *
+ * @return     false on read error or if builder ran out of memory budget
+ */
+bool browser_index_builder_add_index(
+    BrowserIndexBuilder* builder,
+    BrowserIndex* index,
+    const char* skip);
+
+/** Sort entries and save index file for the key
+ *
+ * @param      builder     BrowserIndexBuilder instance
+ * @param      storage     Storage instance
+ * @param      key         folder path with filter settings
+ * @param      dirs_first  folders are sorted before files
+ *
+ * @return     true on success
+ */
+bool browser_index_builder_save(
+    BrowserIndexBuilder* builder,
+    Storage* storage,
+    const char* key,
+    bool dirs_first);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,4 +1,5 @@
 #include "file_browser_worker.h"
+#include "file_browser_index.h"
 
 #include <storage/filesystem_api_defines.h>
 #include <storage/storage.h>
@@ -7,6 +8,8 @@
 #include <core/check.h>
 #include <core/common_defines.h>
 #include <furi.h>
+#include <furi_hal_rtc.h>
+#include <cfw.h>
 
 #include <m-array.h>
 #include <stdbool.h>
@@ -18,6 +21,8 @@
 #define BROWSER_ROOT STORAGE_ANY_PATH_PREFIX
 #define FILE_NAME_LEN_MAX 256
 #define LONG_LOAD_THRESHOLD 100
+#define DIR_READ_BATCH_SIZE 8
+#define DIR_CHECKPOINT_STEP 32
 
 typedef enum {
     WorkerEvtStop = (1 << 0),
@@ -34,6 +39,15 @@ typedef enum {
 
 ARRAY_DEF(idx_last_array, int32_t)
 
+typedef struct {
+    uint32_t index; // filtered items before position
+    uint32_t position; // storage_dir_tell result
+} BrowserDirCheckpoint;
+
+ARRAY_DEF(checkpoint_array, BrowserDirCheckpoint, M_POD_OPLIST)
+
+ARRAY_DEF(index_key_array, uint32_t, M_POD_OPLIST)
+
 struct BrowserWorker {
     FuriThread* thread;
 
@@ -48,6 +62,20 @@ struct BrowserWorker {
     bool hide_dot_files;
     idx_last_array_t idx_last;
 
+    // Directory positions recorded by folder_init, valid while storage timestamp is unchanged
+    FuriString* checkpoint_path;
+    uint32_t checkpoint_timestamp;
+    checkpoint_array_t checkpoints;
+
+    // Sorted index of current folder, open only if folder is indexed
+    bool use_index;
+    FuriMutex* index_mutex;
+    BrowserIndex* index;
+    FuriString* index_key;
+    // Hashes of index keys checked against folder contents at index_timestamp
+    uint32_t index_timestamp;
+    index_key_array_t index_validated;
+
     void* cb_ctx;
     BrowserWorkerFolderOpenCallback folder_cb;
     BrowserWorkerListLoadCallback list_load_cb;
@@ -55,6 +83,136 @@ struct BrowserWorker {
     BrowserWorkerLongLoadCallback long_load_cb;
 };
 
+typedef struct {
+    File* directory;
+    const char* extension;
+    StorageDirEntry entries[DIR_READ_BATCH_SIZE];
+    char* names;
+    size_t count;
+    size_t position;
+} BrowserDirReader;
+
+static void browser_dir_reader_init(
+    BrowserDirReader* reader,
+    BrowserWorker* browser,
+    File* directory) {
+    reader->directory = directory;
+    reader->extension = NULL;
+    if(!furi_string_empty(browser->filter_extension) &&
+       (furi_string_cmp_str(browser->filter_extension, "*") != 0)) {
+        reader->extension = furi_string_get_cstr(browser->filter_extension);
+    }
+    reader->names = malloc(DIR_READ_BATCH_SIZE * FILE_NAME_LEN_MAX);
+    for(size_t i = 0; i < DIR_READ_BATCH_SIZE; i++) {
+        reader->entries[i].name = &reader->names[i * FILE_NAME_LEN_MAX];
+    }
+    reader->count = 0;
+    reader->position = 0;
+}
+
+static void browser_dir_reader_deinit(BrowserDirReader* reader) {
+    free(reader->names);
+}
+
+// Files not matching extension filter are skipped by storage, folders are always returned
+static StorageDirEntry* browser_dir_reader_next(BrowserDirReader* reader) {
+    if(reader->position == reader->count) {
+        reader->count = storage_dir_read_batch(
+            reader->directory,
+            reader->entries,
+            DIR_READ_BATCH_SIZE,
+            FILE_NAME_LEN_MAX,
+            reader->extension);
+        reader->position = 0;
+    }
+
+    if(reader->position < reader->count) {
+        return &reader->entries[reader->position++];
+    }
+    return NULL;
+}
+
+// Reader is at batch boundary, so storage position points to the next entry returned
+static bool browser_dir_reader_is_empty(BrowserDirReader* reader) {
+    return reader->position == reader->count;
+}
+
+static void browser_dir_reader_reset(BrowserDirReader* reader) {
+    reader->count = 0;
+    reader->position = 0;
+}
+
+static void browser_checkpoints_reset(BrowserWorker* browser) {
+    furi_string_reset(browser->checkpoint_path);
+    checkpoint_array_reset(browser->checkpoints);
+}
+
+static void browser_checkpoints_start(
+    BrowserWorker* browser,
+    Storage* storage,
+    FuriString* path) {
+    browser_checkpoints_reset(browser);
+    if(storage_common_timestamp(
+           storage, furi_string_get_cstr(path), &browser->checkpoint_timestamp) != FSE_OK) {
+        return;
+    }
+    // Timestamp has one second resolution, changes later within this second would be missed
+    if(browser->checkpoint_timestamp >= furi_hal_rtc_get_timestamp()) {
+        return;
+    }
+    furi_string_set(browser->checkpoint_path, path);
+}
+
+static void browser_checkpoints_add(BrowserWorker* browser, uint32_t index, File* directory) {
+    // Not saved if folder timestamp can't be trusted
+    if(furi_string_empty(browser->checkpoint_path)) return;
+
+    BrowserDirCheckpoint checkpoint = {
+        .index = index,
+        .position = storage_dir_tell(directory),
+    };
+    if(storage_file_get_error(directory) == FSE_OK) {
+        checkpoint_array_push_back(browser->checkpoints, checkpoint);
+    }
+}
+
+// Find the closest checkpoint before offset, returns false if cache is missing or outdated
+static bool browser_checkpoints_find(
+    BrowserWorker* browser,
+    Storage* storage,
+    FuriString* path,
+    uint32_t offset,
+    BrowserDirCheckpoint* checkpoint) {
+    if(furi_string_empty(browser->checkpoint_path) ||
+       (furi_string_cmp(browser->checkpoint_path, path) != 0)) {
+        return false;
+    }
+
+    uint32_t timestamp = 0;
+    if((storage_common_timestamp(storage, furi_string_get_cstr(path), &timestamp) != FSE_OK) ||
+       (timestamp != browser->checkpoint_timestamp)) {
+        browser_checkpoints_reset(browser);
+        return false;
+    }
+
+    // Checkpoints are pushed in ascending index order
+    bool found = false;
+    size_t low = 0;
+    size_t high = checkpoint_array_size(browser->checkpoints);
+    while(low < high) {
+        size_t mid = low + (high - low) / 2;
+        const BrowserDirCheckpoint* item = checkpoint_array_cget(browser->checkpoints, mid);
+        if(item->index <= offset) {
+            *checkpoint = *item;
+            found = true;
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return found;
+}
+
 static bool browser_path_is_file(FuriString* path) {
     bool state = false;
     FileInfo file_info;
@@ -132,6 +290,152 @@ static bool browser_folder_check_and_switch(FuriString* path) {
     return is_root;
 }
 
+static void browser_index_make_key(BrowserWorker* browser, FuriString* path, FuriString* key) {
+    furi_string_printf(
+        key,
+        "%s|%s|%d%d%d",
+        furi_string_get_cstr(path),
+        furi_string_get_cstr(browser->filter_extension),
+        browser->skip_assets,
+        browser->hide_dot_files,
+        CFW_SETTINGS()->sort_dirs_first);
+}
+
+static bool
+    browser_index_is_validated(BrowserWorker* browser, Storage* storage, FuriString* path) {
+    uint32_t timestamp = 0;
+    if((storage_common_timestamp(storage, furi_string_get_cstr(path), &timestamp) != FSE_OK) ||
+       (timestamp != browser->index_timestamp)) {
+        return false;
+    }
+
+    uint32_t key_hash = browser_index_entry_hash(furi_string_get_cstr(browser->index_key), false);
+    for(size_t i = 0; i < index_key_array_size(browser->index_validated); i++) {
+        if(*index_key_array_get(browser->index_validated, i) == key_hash) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void
+    browser_index_set_validated(BrowserWorker* browser, Storage* storage, FuriString* path) {
+    uint32_t timestamp = 0;
+    if(storage_common_timestamp(storage, furi_string_get_cstr(path), &timestamp) != FSE_OK) {
+        return;
+    }
+    // Timestamp has one second resolution, changes later within this second would be missed
+    if(timestamp >= furi_hal_rtc_get_timestamp()) {
+        return;
+    }
+
+    if(timestamp != browser->index_timestamp) {
+        index_key_array_reset(browser->index_validated);
+        browser->index_timestamp = timestamp;
+    }
+    index_key_array_push_back(
+        browser->index_validated,
+        browser_index_entry_hash(furi_string_get_cstr(browser->index_key), false));
+}
+
+static bool browser_index_build(BrowserWorker* browser, Storage* storage, FuriString* path) {
+    File* directory = storage_file_alloc(storage);
+    BrowserIndexBuilder* builder = browser_index_builder_alloc();
+
+    BrowserDirReader reader;
+    browser_dir_reader_init(&reader, browser, directory);
+    StorageDirEntry* entry;
+    FuriString* name_str;
+    name_str = furi_string_alloc();
+
+    bool result = false;
+    if(storage_dir_open(directory, furi_string_get_cstr(path))) {
+        result = true;
+        while(result && ((entry = browser_dir_reader_next(&reader)) != NULL)) {
+            if(entry->name[0] == '\0') continue;
+            bool is_folder = file_info_is_dir(&entry->fileinfo);
+            furi_string_set(name_str, entry->name);
+            if(browser_filter_by_name(browser, name_str, is_folder)) {
+                result = browser_index_builder_add(builder, entry->name, is_folder);
+            }
+        }
+    }
+    storage_dir_close(directory);
+
+    if(result) {
+        // Indexes of removed folders are dropped when a new one is built
+        browser_index_prune(storage, furi_string_get_cstr(browser->index_key));
+        result = browser_index_builder_save(
+            builder,
+            storage,
+            furi_string_get_cstr(browser->index_key),
+            CFW_SETTINGS()->sort_dirs_first);
+    }
+
+    furi_string_free(name_str);
+    browser_dir_reader_deinit(&reader);
+    browser_index_builder_free(builder);
+    storage_file_free(directory);
+
+    return result;
+}
+
+// Open index matching folder contents, index is rebuilt if it is missing or outdated
+static bool browser_index_validate(
+    BrowserWorker* browser,
+    Storage* storage,
+    FuriString* path,
+    uint32_t item_cnt,
+    uint32_t fingerprint) {
+    const char* key = furi_string_get_cstr(browser->index_key);
+    bool dirs_first = CFW_SETTINGS()->sort_dirs_first;
+
+    for(size_t attempt = 0; attempt < 2; attempt++) {
+        if(browser_index_open(browser->index, key, dirs_first) &&
+           (browser_index_get_count(browser->index) == item_cnt) &&
+           (browser_index_get_fingerprint(browser->index) == fingerprint)) {
+            return true;
+        }
+        browser_index_close(browser->index);
+
+        if((attempt > 0) || !browser_index_build(browser, storage, path)) {
+            break;
+        }
+        FURI_LOG_D(TAG, "Index rebuilt: %s", key);
+    }
+
+    return false;
+}
+
+// Get folder info from index if folder is unchanged since index was checked
+static bool browser_folder_init_from_index(
+    BrowserWorker* browser,
+    Storage* storage,
+    FuriString* path,
+    FuriString* filename,
+    uint32_t* item_cnt,
+    int32_t* file_idx) {
+    bool result = false;
+
+    furi_mutex_acquire(browser->index_mutex, FuriWaitForever);
+    browser_index_close(browser->index);
+    browser_index_make_key(browser, path, browser->index_key);
+    if(browser->use_index && browser_index_is_validated(browser, storage, path) &&
+       browser_index_open(
+           browser->index,
+           furi_string_get_cstr(browser->index_key),
+           CFW_SETTINGS()->sort_dirs_first)) {
+        *item_cnt = browser_index_get_count(browser->index);
+        if(!furi_string_empty(filename)) {
+            *file_idx = browser_index_find(browser->index, furi_string_get_cstr(filename), false);
+        }
+        result = true;
+    }
+    furi_mutex_release(browser->index_mutex);
+
+    return result;
+}
+
 static bool browser_folder_init(
     BrowserWorker* browser,
     FuriString* path,
@@ -139,29 +443,47 @@ static bool browser_folder_init(
     uint32_t* item_cnt,
     int32_t* file_idx) {
     bool state = false;
-    FileInfo file_info;
     uint32_t total_files_cnt = 0;
 
+    *item_cnt = 0;
+    *file_idx = -1;
+
     Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(browser_folder_init_from_index(browser, storage, path, filename, item_cnt, file_idx)) {
+        furi_record_close(RECORD_STORAGE);
+        return true;
+    }
+
     File* directory = storage_file_alloc(storage);
 
-    char name_temp[FILE_NAME_LEN_MAX];
+    BrowserDirReader reader;
+    browser_dir_reader_init(&reader, browser, directory);
+    StorageDirEntry* entry;
     FuriString* name_str;
     name_str = furi_string_alloc();
 
-    *item_cnt = 0;
-    *file_idx = -1;
+    uint32_t fingerprint = 0;
+    browser_checkpoints_start(browser, storage, path);
+    uint32_t checkpoint_next = DIR_CHECKPOINT_STEP;
 
     if(storage_dir_open(directory, furi_string_get_cstr(path))) {
         state = true;
-        while(1) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+        while(true) {
+            if((*item_cnt >= checkpoint_next) && browser_dir_reader_is_empty(&reader)) {
+                browser_checkpoints_add(browser, *item_cnt, directory);
+                checkpoint_next = *item_cnt + DIR_CHECKPOINT_STEP;
+            }
+            entry = browser_dir_reader_next(&reader);
+            if(!entry) {
                 break;
             }
-            if((storage_file_get_error(directory) == FSE_OK) && (name_temp[0] != '\0')) {
+            if(entry->name[0] != '\0') {
                 total_files_cnt++;
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
+                furi_string_set(name_str, entry->name);
+                if(browser_filter_by_name(
+                       browser, name_str, file_info_is_dir(&entry->fileinfo))) {
+                    fingerprint +=
+                        browser_index_entry_hash(entry->name, file_info_is_dir(&entry->fileinfo));
                     if(!furi_string_empty(filename)) {
                         if(furi_string_cmp(name_str, filename) == 0) {
                             *file_idx = *item_cnt;
@@ -180,27 +502,77 @@ static bool browser_folder_init(
     }
 
     furi_string_free(name_str);
+    browser_dir_reader_deinit(&reader);
 
     storage_dir_close(directory);
     storage_file_free(directory);
 
+    // Large folders are paged from sorted index, small ones are sorted by the app in RAM
+    if(state && browser->use_index && (*item_cnt > BROWSER_SORT_THRESHOLD)) {
+        furi_mutex_acquire(browser->index_mutex, FuriWaitForever);
+        if(browser_index_validate(browser, storage, path, *item_cnt, fingerprint)) {
+            browser_index_set_validated(browser, storage, path);
+            if(!furi_string_empty(filename)) {
+                *file_idx =
+                    browser_index_find(browser->index, furi_string_get_cstr(filename), false);
+            }
+        }
+        furi_mutex_release(browser->index_mutex);
+    }
+
     furi_record_close(RECORD_STORAGE);
 
     return state;
 }
 
+// Load files list by chunks from sorted folder index
+static void browser_folder_load_index(
+    BrowserWorker* browser,
+    FuriString* path,
+    uint32_t offset,
+    uint32_t count) {
+    FuriString* name_str = furi_string_alloc();
+    FuriString* item_path = furi_string_alloc();
+    bool is_folder = false;
+
+    furi_mutex_acquire(browser->index_mutex, FuriWaitForever);
+    if(browser_index_seek(browser->index, offset)) {
+        if(browser->list_load_cb) {
+            browser->list_load_cb(browser->cb_ctx, offset);
+        }
+
+        uint32_t items_cnt = 0;
+        while((items_cnt < count) &&
+              browser_index_read_next(browser->index, name_str, &is_folder)) {
+            furi_string_printf(
+                item_path, "%s/%s", furi_string_get_cstr(path), furi_string_get_cstr(name_str));
+            if(browser->list_item_cb) {
+                browser->list_item_cb(browser->cb_ctx, item_path, items_cnt, is_folder, false);
+            }
+            items_cnt++;
+        }
+        if(browser->list_item_cb) {
+            browser->list_item_cb(browser->cb_ctx, NULL, 0, false, true);
+        }
+    }
+    furi_mutex_release(browser->index_mutex);
+
+    furi_string_free(item_path);
+    furi_string_free(name_str);
+}
+
 // Load files list by chunks, like it was originally, not compatible with sorting, sorting needs to be disabled to use this
 static bool browser_folder_load_chunked(
     BrowserWorker* browser,
     FuriString* path,
     uint32_t offset,
     uint32_t count) {
-    FileInfo file_info;
-
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* directory = storage_file_alloc(storage);
 
-    char name_temp[FILE_NAME_LEN_MAX];
+    BrowserDirReader reader;
+    browser_dir_reader_init(&reader, browser, directory);
+    StorageDirEntry* entry;
     FuriString* name_str;
     name_str = furi_string_alloc();
 
@@ -212,17 +584,26 @@ static bool browser_folder_load_chunked(
         }
 
         items_cnt = 0;
+        // Skip to the closest known position instead of reading from the beginning
+        BrowserDirCheckpoint checkpoint;
+        if(browser_checkpoints_find(browser, storage, path, offset, &checkpoint)) {
+            if(storage_dir_seek(directory, checkpoint.position)) {
+                items_cnt = checkpoint.index;
+            } else {
+                browser_checkpoints_reset(browser);
+                storage_dir_rewind(directory);
+            }
+            browser_dir_reader_reset(&reader);
+        }
+
         while(items_cnt < offset) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            entry = browser_dir_reader_next(&reader);
+            if(!entry) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    items_cnt++;
-                }
-            } else {
-                break;
+            furi_string_set(name_str, entry->name);
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&entry->fileinfo))) {
+                items_cnt++;
             }
         }
         if(items_cnt != offset) {
@@ -235,25 +616,22 @@ static bool browser_folder_load_chunked(
 
         items_cnt = 0;
         while(items_cnt < count) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            entry = browser_dir_reader_next(&reader);
+            if(!entry) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
-                    if(browser->list_item_cb) {
-                        browser->list_item_cb(
-                            browser->cb_ctx,
-                            name_str,
-                            items_cnt,
-                            file_info_is_dir(&file_info),
-                            false);
-                    }
-                    items_cnt++;
+            furi_string_set(name_str, entry->name);
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&entry->fileinfo))) {
+                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), entry->name);
+                if(browser->list_item_cb) {
+                    browser->list_item_cb(
+                        browser->cb_ctx,
+                        name_str,
+                        items_cnt,
+                        file_info_is_dir(&entry->fileinfo),
+                        false);
                 }
-            } else {
-                break;
+                items_cnt++;
             }
         }
         if(browser->list_item_cb) {
@@ -262,6 +640,7 @@ static bool browser_folder_load_chunked(
     } while(0);
 
     furi_string_free(name_str);
+    browser_dir_reader_deinit(&reader);
 
     storage_dir_close(directory);
     storage_file_free(directory);
@@ -273,12 +652,12 @@ static bool browser_folder_load_chunked(
 
 // Load all files at once, may cause memory overflow so need to limit that to about 400 files
 static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
-    FileInfo file_info;
-
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* directory = storage_file_alloc(storage);
 
-    char name_temp[FILE_NAME_LEN_MAX];
+    BrowserDirReader reader;
+    browser_dir_reader_init(&reader, browser, directory);
+    StorageDirEntry* entry;
     FuriString* name_str;
     name_str = furi_string_alloc();
 
@@ -292,14 +671,13 @@ static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
         if(browser->list_load_cb) {
             browser->list_load_cb(browser->cb_ctx, 0);
         }
-        while(storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX) &&
-              storage_file_get_error(directory) == FSE_OK) {
-            furi_string_set(name_str, name_temp);
-            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
+        while((entry = browser_dir_reader_next(&reader)) != NULL) {
+            bool is_folder = file_info_is_dir(&entry->fileinfo);
+            furi_string_set(name_str, entry->name);
+            if(browser_filter_by_name(browser, name_str, is_folder)) {
+                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), entry->name);
                 if(browser->list_item_cb) {
-                    browser->list_item_cb(
-                        browser->cb_ctx, name_str, items_cnt, file_info_is_dir(&file_info), false);
+                    browser->list_item_cb(browser->cb_ctx, name_str, items_cnt, is_folder, false);
                 }
                 items_cnt++;
             }
@@ -311,6 +689,7 @@ static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
     } while(0);
 
     furi_string_free(name_str);
+    browser_dir_reader_deinit(&reader);
 
     storage_dir_close(directory);
     storage_file_free(directory);
@@ -346,6 +725,7 @@ static int32_t browser_worker(void* context) {
                 path_extract_filename(browser->path_next, filename, false);
             }
             idx_last_array_reset(browser->idx_last);
+            browser_checkpoints_reset(browser);
 
             furi_thread_flags_set(furi_thread_get_id(browser->thread), WorkerEvtFolderEnter);
         }
@@ -414,7 +794,10 @@ static int32_t browser_worker(void* context) {
         if(flags & WorkerEvtLoad) {
             FURI_LOG_D(
                 TAG, "Load offset: %lu cnt: %lu", browser->load_offset, browser->load_count);
-            if(items_cnt > BROWSER_SORT_THRESHOLD) {
+            if(browser_index_is_open(browser->index)) {
+                browser_folder_load_index(
+                    browser, path, browser->load_offset, browser->load_count);
+            } else if(items_cnt > BROWSER_SORT_THRESHOLD) {
                 browser_folder_load_chunked(
                     browser, path, browser->load_offset, browser->load_count);
             } else {
@@ -443,6 +826,12 @@ BrowserWorker* file_browser_worker_alloc(
     BrowserWorker* browser = malloc(sizeof(BrowserWorker));
 
     idx_last_array_init(browser->idx_last);
+    checkpoint_array_init(browser->checkpoints);
+    browser->checkpoint_path = furi_string_alloc();
+    index_key_array_init(browser->index_validated);
+    browser->index_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    browser->index = browser_index_alloc(furi_record_open(RECORD_STORAGE));
+    browser->index_key = furi_string_alloc();
 
     browser->filter_extension = furi_string_alloc_set(filter_ext);
     browser->skip_assets = skip_assets;
@@ -476,6 +865,13 @@ void file_browser_worker_free(BrowserWorker* browser) {
     furi_string_free(browser->path_start);
 
     idx_last_array_clear(browser->idx_last);
+    checkpoint_array_clear(browser->checkpoints);
+    furi_string_free(browser->checkpoint_path);
+    browser_index_free(browser->index);
+    furi_record_close(RECORD_STORAGE);
+    furi_mutex_free(browser->index_mutex);
+    furi_string_free(browser->index_key);
+    index_key_array_clear(browser->index_validated);
 
     free(browser);
 }
@@ -556,3 +952,86 @@ void file_browser_worker_load(BrowserWorker* browser, uint32_t offset, uint32_t
     browser->load_count = count;
     furi_thread_flags_set(furi_thread_get_id(browser->thread), WorkerEvtLoad);
 }
+
+void file_browser_worker_set_index_enabled(BrowserWorker* browser, bool enabled) {
+    furi_assert(browser);
+    browser->use_index = enabled;
+}
+
+// Apply file operation to the open index, so it is not rebuilt on next folder check
+static void browser_index_update(
+    BrowserWorker* browser,
+    const char* remove_path,
+    const char* add_path,
+    bool is_folder) {
+    FuriString* folder = furi_string_alloc();
+    FuriString* key = furi_string_alloc();
+    FuriString* name = furi_string_alloc();
+
+    furi_mutex_acquire(browser->index_mutex, FuriWaitForever);
+    do {
+        if(!browser_index_is_open(browser->index)) break;
+
+        path_extract_dirname(remove_path, folder);
+        browser_index_make_key(browser, folder, key);
+        if(!furi_string_equal(key, browser->index_key)) break;
+
+        BrowserIndexBuilder* builder = browser_index_builder_alloc();
+        path_extract_basename(remove_path, name);
+        bool result =
+            browser_index_builder_add_index(builder, browser->index, furi_string_get_cstr(name));
+
+        if(result && add_path) {
+            path_extract_dirname(add_path, folder);
+            browser_index_make_key(browser, folder, key);
+            path_extract_basename(add_path, name);
+            // Item moved to another folder or hidden by filter is just removed
+            if(furi_string_equal(key, browser->index_key) &&
+               browser_filter_by_name(browser, name, is_folder)) {
+                result = browser_index_builder_add(builder, furi_string_get_cstr(name), is_folder);
+            }
+        }
+
+        browser_index_close(browser->index);
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        if(result) {
+            browser_index_builder_save(
+                builder,
+                storage,
+                furi_string_get_cstr(browser->index_key),
+                CFW_SETTINGS()->sort_dirs_first);
+        } else {
+            // Drop index that can't be updated, it is rebuilt on next folder check
+            browser_index_remove(storage, furi_string_get_cstr(browser->index_key));
+        }
+        furi_record_close(RECORD_STORAGE);
+        browser_index_builder_free(builder);
+
+        browser_index_open(
+            browser->index,
+            furi_string_get_cstr(browser->index_key),
+            CFW_SETTINGS()->sort_dirs_first);
+    } while(false);
+    furi_mutex_release(browser->index_mutex);
+
+    furi_string_free(name);
+    furi_string_free(key);
+    furi_string_free(folder);
+}
+
+void file_browser_worker_index_remove(BrowserWorker* browser, const char* path, bool is_folder) {
+    furi_assert(browser);
+    furi_assert(path);
+    browser_index_update(browser, path, NULL, is_folder);
+}
+
+void file_browser_worker_index_rename(
+    BrowserWorker* browser,
+    const char* old_path,
+    const char* new_path,
+    bool is_folder) {
+    furi_assert(browser);
+    furi_assert(old_path);
+    furi_assert(new_path);
+    browser_index_update(browser, old_path, new_path, is_folder);
+}
@@ -68,6 +68,16 @@ void file_browser_worker_folder_refresh(BrowserWorker* browser, int32_t item_idx
 
 void file_browser_worker_load(BrowserWorker* browser, uint32_t offset, uint32_t count);
 
+void file_browser_worker_set_index_enabled(BrowserWorker* browser, bool enabled);
+
+void file_browser_worker_index_remove(BrowserWorker* browser, const char* path, bool is_folder);
+
+void file_browser_worker_index_rename(
+    BrowserWorker* browser,
+    const char* old_path,
+    const char* new_path,
+    bool is_folder);
+
 #ifdef __cplusplus
 }
 #endif
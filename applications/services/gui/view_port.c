@@ -106,7 +106,11 @@ void view_port_free(ViewPort* view_port) {
 
 void view_port_set_width(ViewPort* view_port, uint8_t width) {
     furi_assert(view_port);
-    view_port->width = width;
+    if(view_port->width != width) {
+        view_port->width = width;
+        // Layout changed, area update is not enough
+        if(view_port->gui) gui_update(view_port->gui);
+    }
 }
 
 uint8_t view_port_get_width(const ViewPort* view_port) {
@@ -116,7 +120,10 @@ uint8_t view_port_get_width(const ViewPort* view_port) {
 
 void view_port_set_height(ViewPort* view_port, uint8_t height) {
     furi_assert(view_port);
-    view_port->height = height;
+    if(view_port->height != height) {
+        view_port->height = height;
+        if(view_port->gui) gui_update(view_port->gui);
+    }
 }
 
 uint8_t view_port_get_height(const ViewPort* view_port) {
@@ -153,8 +160,19 @@ void view_port_input_callback_set(
 }
 
 void view_port_update(ViewPort* view_port) {
+    view_port_update_area(view_port, 0, 0, UINT8_MAX, UINT8_MAX);
+}
+
+void view_port_update_area(
+    ViewPort* view_port,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height) {
     furi_assert(view_port);
-    if(view_port->gui && view_port->is_enabled) gui_update(view_port->gui);
+    if(view_port->gui && view_port->is_enabled) {
+        gui_update_view_port(view_port->gui, view_port, x, y, width, height);
+    }
 }
 
 void view_port_gui_set(ViewPort* view_port, Gui* gui) {
@@ -167,8 +185,22 @@ void view_port_draw(ViewPort* view_port, Canvas* canvas) {
     furi_assert(canvas);
     furi_check(view_port->gui);
 
+    // Partial redraw: nothing drawn here would be visible
+    if(!canvas_frame_is_visible(canvas)) return;
+
     if(view_port->draw_callback) {
         view_port_setup_canvas_orientation(view_port, canvas);
+
+        FURI_CRITICAL_ENTER();
+        view_port->drawn_generation = view_port->gui->redraw_generation;
+        view_port->drawn_horizontal = canvas_get_orientation(canvas) ==
+                                      CanvasOrientationHorizontal;
+        view_port->drawn_x = canvas->offset_x;
+        view_port->drawn_y = canvas->offset_y;
+        view_port->drawn_width = canvas->width;
+        view_port->drawn_height = canvas->height;
+        FURI_CRITICAL_EXIT();
+
         view_port->draw_callback(canvas, view_port->draw_callback_context);
     }
 }
@@ -187,7 +219,10 @@ void view_port_input(ViewPort* view_port, InputEvent* event) {
 
 void view_port_set_orientation(ViewPort* view_port, ViewPortOrientation orientation) {
     furi_assert(view_port);
-    view_port->orientation = orientation;
+    if(view_port->orientation != orientation) {
+        view_port->orientation = orientation;
+        if(view_port->gui) gui_update(view_port->gui);
+    }
 }
 
 ViewPortOrientation view_port_get_orientation(const ViewPort* view_port) {
@@ -97,6 +97,24 @@ void view_port_input_callback_set(
  */
 void view_port_update(ViewPort* view_port);
 
+/** Emit update signal for ViewPort area to GUI system.
+ *
+ * Only the area is redrawn if nothing else changed on screen. Draw callback
+ * must still draw the whole ViewPort, output outside of the area is discarded.
+ *
+ * @param      view_port  ViewPort instance
+ * @param      x          x coordinate
+ * @param      y          y coordinate
+ * @param      width      area width
+ * @param      height     area height
+ */
+void view_port_update_area(
+    ViewPort* view_port,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height);
+
 /** Set ViewPort orientation.
  *
  * @param      view_port    ViewPort instance
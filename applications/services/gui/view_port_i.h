@@ -16,6 +16,14 @@ struct ViewPort {
     uint8_t width;
     uint8_t height;
 
+    // Screen area of the last draw, used to track damage
+    uint32_t drawn_generation;
+    bool drawn_horizontal;
+    uint8_t drawn_x;
+    uint8_t drawn_y;
+    uint8_t drawn_width;
+    uint8_t drawn_height;
+
     ViewPortDrawCallback draw_callback;
     void* draw_callback_context;
 
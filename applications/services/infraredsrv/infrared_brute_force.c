@@ -1,14 +1,58 @@
 #include "infrared_brute_force.h"
 
 #include <stdlib.h>
+#include <string.h>
 #include <m-dict.h>
 #include <flipper_format/flipper_format.h>
+#include <toolbox/crc32_calc.h>
+#include <toolbox/path.h>
 
 #include "infrared_signal.h"
 
+#define TAG "InfraredBruteForce"
+
+#define INFRARED_BRUTE_FORCE_CACHE_FOLDER EXT_PATH("infrared/.cache")
+#define INFRARED_BRUTE_FORCE_CACHE_EXTENSION ".irc"
+#define INFRARED_BRUTE_FORCE_CACHE_MAGIC (0x43524921U)
+#define INFRARED_BRUTE_FORCE_CACHE_VERSION (1U)
+
+/*
+ * Signal cache file layout:
+ * header, signals in database order, button table.
+ * Signals with the same name are chained by offset, so a sweep over one button
+ * reads only its own signals and never parses text.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t db_size;
+    uint32_t db_crc;
+    uint32_t table_offset;
+    uint32_t table_count;
+} InfraredBruteForceCacheHeader;
+
+typedef struct {
+    uint32_t next; // offset of the next signal with the same name, 0 for the last one
+    uint8_t is_raw;
+    uint8_t reserved;
+    uint16_t timings_size; // raw signal timings follow the entry
+    union {
+        struct {
+            uint32_t protocol;
+            uint32_t address;
+            uint32_t command;
+        } message;
+        struct {
+            uint32_t frequency;
+            float duty_cycle;
+        } raw;
+    };
+} InfraredBruteForceCacheSignal;
+
 typedef struct {
     uint32_t index;
     uint32_t count;
+    uint32_t offset;
 } InfraredBruteForceRecord;
 
 DICT_DEF2(
@@ -19,21 +63,29 @@ DICT_DEF2(
     M_POD_OPLIST);
 
 struct InfraredBruteForce {
+    File* cache_file;
     FlipperFormat* ff;
     const char* db_filename;
+    FuriString* cache_filename;
     FuriString* current_record_name;
+    uint32_t current_offset;
     InfraredSignal* current_signal;
     InfraredBruteForceRecordDict_t records;
+    bool use_cache;
     bool is_started;
 };
 
 InfraredBruteForce* infrared_brute_force_alloc() {
     InfraredBruteForce* brute_force = malloc(sizeof(InfraredBruteForce));
+    brute_force->cache_file = NULL;
     brute_force->ff = NULL;
     brute_force->db_filename = NULL;
+    brute_force->cache_filename = furi_string_alloc();
+    brute_force->current_record_name = furi_string_alloc();
+    brute_force->current_offset = 0;
     brute_force->current_signal = NULL;
+    brute_force->use_cache = false;
     brute_force->is_started = false;
-    brute_force->current_record_name = furi_string_alloc();
     InfraredBruteForceRecordDict_init(brute_force->records);
     return brute_force;
 }
@@ -41,6 +93,7 @@ InfraredBruteForce* infrared_brute_force_alloc() {
 void infrared_brute_force_free(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
     InfraredBruteForceRecordDict_clear(brute_force->records);
+    furi_string_free(brute_force->cache_filename);
     furi_string_free(brute_force->current_record_name);
     free(brute_force);
 }
@@ -50,15 +103,259 @@ void infrared_brute_force_set_db_filename(InfraredBruteForce* brute_force, const
     brute_force->db_filename = db_filename;
 }
 
-bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
-    furi_assert(!brute_force->is_started);
-    furi_assert(brute_force->db_filename);
+static void infrared_brute_force_set_cache_filename(InfraredBruteForce* brute_force) {
+    // Databases with the same name in different folders must not share a cache
+    const char* db_filename = brute_force->db_filename;
+    const uint32_t path_hash = crc32_calc_buffer(0, db_filename, strlen(db_filename));
+
+    FuriString* name = furi_string_alloc();
+    path_extract_filename_no_ext(db_filename, name);
+    furi_string_printf(
+        brute_force->cache_filename,
+        "%s/%s_%08lX%s",
+        INFRARED_BRUTE_FORCE_CACHE_FOLDER,
+        furi_string_get_cstr(name),
+        path_hash,
+        INFRARED_BRUTE_FORCE_CACHE_EXTENSION);
+    furi_string_free(name);
+}
+
+static bool infrared_brute_force_get_db_checksum(
+    Storage* storage,
+    const char* db_filename,
+    uint32_t* db_size,
+    uint32_t* db_crc) {
+    File* file = storage_file_alloc(storage);
+    bool success = storage_file_open(file, db_filename, FSAM_READ, FSOM_OPEN_EXISTING);
+    if(success) {
+        *db_size = storage_file_size(file);
+        *db_crc = crc32_calc_file(file, NULL, NULL);
+    }
+    storage_file_free(file);
+    return success;
+}
+
+static bool infrared_brute_force_cache_write_signal(
+    File* file,
+    InfraredSignal* signal,
+    uint32_t* size) {
+    InfraredBruteForceCacheSignal entry = {0};
+    const uint32_t* timings = NULL;
+
+    if(infrared_signal_is_raw(signal)) {
+        InfraredRawSignal* raw = infrared_signal_get_raw_signal(signal);
+        entry.is_raw = true;
+        entry.timings_size = raw->timings_size;
+        entry.raw.frequency = raw->frequency;
+        entry.raw.duty_cycle = raw->duty_cycle;
+        timings = raw->timings;
+    } else {
+        InfraredMessage* message = infrared_signal_get_message(signal);
+        entry.message.protocol = message->protocol;
+        entry.message.address = message->address;
+        entry.message.command = message->command;
+    }
+
+    const size_t timings_size = entry.timings_size * sizeof(uint32_t);
+    *size = sizeof(entry) + timings_size;
+
+    return (storage_file_write(file, &entry, sizeof(entry)) == sizeof(entry)) &&
+           (!timings || storage_file_write(file, timings, timings_size) == timings_size);
+}
+
+static bool infrared_brute_force_cache_read_signal(
+    File* file,
+    InfraredSignal* signal,
+    uint32_t* next) {
+    InfraredBruteForceCacheSignal entry;
+    if(storage_file_read(file, &entry, sizeof(entry)) != sizeof(entry)) return false;
+
     bool success = false;
+    if(entry.is_raw) {
+        const size_t timings_size = entry.timings_size * sizeof(uint32_t);
+        uint32_t* timings = malloc(timings_size);
+        if(storage_file_read(file, timings, timings_size) == timings_size) {
+            infrared_signal_set_raw_signal(
+                signal,
+                timings,
+                entry.timings_size,
+                entry.raw.frequency,
+                entry.raw.duty_cycle);
+            success = true;
+        }
+        free(timings);
+    } else {
+        InfraredMessage message = {
+            .protocol = entry.message.protocol,
+            .address = entry.message.address,
+            .command = entry.message.command,
+            .repeat = false,
+        };
+        infrared_signal_set_message(signal, &message);
+        success = true;
+    }
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
+    *next = entry.next;
+    return success;
+}
+
+static bool infrared_brute_force_cache_generate(
+    Storage* storage,
+    const char* db_filename,
+    const char* cache_filename,
+    const InfraredBruteForceCacheHeader* db_header) {
     FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    File* file = storage_file_alloc(storage);
+    InfraredSignal* signal = infrared_signal_alloc();
+    FuriString* signal_name = furi_string_alloc();
+    // count: signals with the name, offset: first signal, index: last signal
+    InfraredBruteForceRecordDict_t table;
+    InfraredBruteForceRecordDict_init(table);
+
+    InfraredBruteForceCacheHeader header = *db_header;
+    bool success = false;
+
+    do {
+        storage_simply_mkdir(storage, INFRARED_BRUTE_FORCE_CACHE_FOLDER);
+        if(!flipper_format_buffered_file_open_existing(ff, db_filename)) break;
+        if(!storage_file_open(file, cache_filename, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        uint32_t offset = sizeof(header);
+        bool error = false;
+        flipper_format_set_key_index(ff, true);
+
+        while(flipper_format_read_string(ff, "name", signal_name)) {
+            if(!infrared_signal_read_body(signal, ff)) {
+                FURI_LOG_W(TAG, "Skipping invalid signal %s", furi_string_get_cstr(signal_name));
+                continue;
+            }
+
+            uint32_t size;
+            if(!infrared_brute_force_cache_write_signal(file, signal, &size)) {
+                error = true;
+                break;
+            }
+
+            InfraredBruteForceRecord* record =
+                InfraredBruteForceRecordDict_get(table, signal_name);
+            if(record) {
+                // Link the previous signal with the same name to this one
+                error = !storage_file_seek(file, record->index, true) ||
+                        storage_file_write(file, &offset, sizeof(offset)) != sizeof(offset) ||
+                        !storage_file_seek(file, offset + size, true);
+                if(error) break;
+                record->count++;
+                record->index = offset;
+            } else {
+                InfraredBruteForceRecord value = {.index = offset, .count = 1, .offset = offset};
+                InfraredBruteForceRecordDict_set_at(table, signal_name, value);
+            }
+
+            offset += size;
+        }
+
+        if(error) break;
+
+        header.table_offset = offset;
+        header.table_count = InfraredBruteForceRecordDict_size(table);
+
+        InfraredBruteForceRecordDict_it_t it;
+        for(InfraredBruteForceRecordDict_it(it, table); !InfraredBruteForceRecordDict_end_p(it);
+            InfraredBruteForceRecordDict_next(it)) {
+            const InfraredBruteForceRecordDict_itref_t* record =
+                InfraredBruteForceRecordDict_cref(it);
+            const uint8_t name_size = MIN(furi_string_size(record->key), UINT8_MAX);
+            error = storage_file_write(file, &name_size, 1) != 1 ||
+                    storage_file_write(file, furi_string_get_cstr(record->key), name_size) !=
+                        name_size ||
+                    storage_file_write(file, &record->value.count, sizeof(uint32_t)) !=
+                        sizeof(uint32_t) ||
+                    storage_file_write(file, &record->value.offset, sizeof(uint32_t)) !=
+                        sizeof(uint32_t);
+            if(error) break;
+        }
+
+        if(error) break;
+
+        // Header is written last, so an interrupted generation leaves an invalid cache
+        header.magic = INFRARED_BRUTE_FORCE_CACHE_MAGIC;
+        if(!storage_file_seek(file, 0, true)) break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        success = true;
+    } while(false);
 
-    success = flipper_format_buffered_file_open_existing(ff, brute_force->db_filename);
+    storage_file_close(file);
+    if(!success) {
+        FURI_LOG_E(TAG, "Failed to generate %s", cache_filename);
+        storage_simply_remove(storage, cache_filename);
+    }
+
+    InfraredBruteForceRecordDict_clear(table);
+    furi_string_free(signal_name);
+    infrared_signal_free(signal);
+    storage_file_free(file);
+    flipper_format_free(ff);
+    return success;
+}
+
+static bool infrared_brute_force_cache_load(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    const char* cache_filename,
+    const InfraredBruteForceCacheHeader* db_header) {
+    File* file = storage_file_alloc(storage);
+    FuriString* name = furi_string_alloc();
+    char name_buffer[UINT8_MAX + 1];
+    bool success = false;
+
+    do {
+        if(!storage_file_open(file, cache_filename, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        InfraredBruteForceCacheHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != INFRARED_BRUTE_FORCE_CACHE_MAGIC ||
+           header.version != db_header->version || header.db_size != db_header->db_size ||
+           header.db_crc != db_header->db_crc) {
+            FURI_LOG_I(TAG, "Cache %s is outdated", cache_filename);
+            break;
+        }
+
+        if(!storage_file_seek(file, header.table_offset, true)) break;
+
+        uint32_t i;
+        for(i = 0; i < header.table_count; i++) {
+            uint8_t name_size;
+            uint32_t count;
+            uint32_t offset;
+            if(storage_file_read(file, &name_size, 1) != 1) break;
+            if(storage_file_read(file, name_buffer, name_size) != name_size) break;
+            if(storage_file_read(file, &count, sizeof(count)) != sizeof(count)) break;
+            if(storage_file_read(file, &offset, sizeof(offset)) != sizeof(offset)) break;
+
+            name_buffer[name_size] = '\0';
+            furi_string_set(name, name_buffer);
+            InfraredBruteForceRecord* record =
+                InfraredBruteForceRecordDict_get(brute_force->records, name);
+            if(record) {
+                record->count = count;
+                record->offset = offset;
+            }
+        }
+
+        success = (i == header.table_count);
+    } while(false);
+
+    furi_string_free(name);
+    storage_file_free(file);
+    return success;
+}
+
+static bool infrared_brute_force_count_records(InfraredBruteForce* brute_force, Storage* storage) {
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+
+    bool success = flipper_format_buffered_file_open_existing(ff, brute_force->db_filename);
     if(success) {
         FuriString* signal_name;
         signal_name = furi_string_alloc();
@@ -73,6 +370,60 @@ bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
     }
 
     flipper_format_free(ff);
+    return success;
+}
+
+static void infrared_brute_force_clear_counts(InfraredBruteForce* brute_force) {
+    InfraredBruteForceRecordDict_it_t it;
+    for(InfraredBruteForceRecordDict_it(it, brute_force->records);
+        !InfraredBruteForceRecordDict_end_p(it);
+        InfraredBruteForceRecordDict_next(it)) {
+        InfraredBruteForceRecordDict_itref_t* record = InfraredBruteForceRecordDict_ref(it);
+        record->value.count = 0;
+        record->value.offset = 0;
+    }
+}
+
+bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
+    furi_assert(!brute_force->is_started);
+    furi_assert(brute_force->db_filename);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    infrared_brute_force_set_cache_filename(brute_force);
+    const char* cache_filename = furi_string_get_cstr(brute_force->cache_filename);
+
+    InfraredBruteForceCacheHeader db_header = {.version = INFRARED_BRUTE_FORCE_CACHE_VERSION};
+    bool use_cache = false;
+
+    do {
+        if(!infrared_brute_force_get_db_checksum(
+               storage, brute_force->db_filename, &db_header.db_size, &db_header.db_crc)) {
+            break;
+        }
+
+        use_cache =
+            infrared_brute_force_cache_load(brute_force, storage, cache_filename, &db_header);
+        if(use_cache) break;
+
+        // Database is new or changed since the cache was made
+        if(!infrared_brute_force_cache_generate(
+               storage, brute_force->db_filename, cache_filename, &db_header)) {
+            break;
+        }
+
+        use_cache =
+            infrared_brute_force_cache_load(brute_force, storage, cache_filename, &db_header);
+    } while(false);
+
+    bool success = use_cache;
+    if(!use_cache) {
+        // Cache can't be written (read-only or full storage): parse the database as text
+        FURI_LOG_W(TAG, "Cache is not available, using %s", brute_force->db_filename);
+        infrared_brute_force_clear_counts(brute_force);
+        success = infrared_brute_force_count_records(brute_force, storage);
+    }
+    brute_force->use_cache = use_cache;
+
     furi_record_close(RECORD_STORAGE);
     return success;
 }
@@ -95,17 +446,27 @@ bool infrared_brute_force_start(
             if(*record_count) {
                 furi_string_set(brute_force->current_record_name, record->key);
             }
+            brute_force->current_offset = record->value.offset;
             break;
         }
     }
 
     if(*record_count) {
         Storage* storage = furi_record_open(RECORD_STORAGE);
-        brute_force->ff = flipper_format_buffered_file_alloc(storage);
         brute_force->current_signal = infrared_signal_alloc();
         brute_force->is_started = true;
-        success =
-            flipper_format_buffered_file_open_existing(brute_force->ff, brute_force->db_filename);
+        if(brute_force->use_cache) {
+            brute_force->cache_file = storage_file_alloc(storage);
+            success = storage_file_open(
+                brute_force->cache_file,
+                furi_string_get_cstr(brute_force->cache_filename),
+                FSAM_READ,
+                FSOM_OPEN_EXISTING);
+        } else {
+            brute_force->ff = flipper_format_buffered_file_alloc(storage);
+            success = flipper_format_buffered_file_open_existing(
+                brute_force->ff, brute_force->db_filename);
+        }
         if(!success) infrared_brute_force_stop(brute_force);
     }
     return success;
@@ -119,17 +480,34 @@ void infrared_brute_force_stop(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
     furi_string_reset(brute_force->current_record_name);
     infrared_signal_free(brute_force->current_signal);
-    flipper_format_free(brute_force->ff);
+    if(brute_force->cache_file) storage_file_free(brute_force->cache_file);
+    if(brute_force->ff) flipper_format_free(brute_force->ff);
     brute_force->current_signal = NULL;
+    brute_force->cache_file = NULL;
     brute_force->ff = NULL;
+    brute_force->current_offset = 0;
     brute_force->is_started = false;
     furi_record_close(RECORD_STORAGE);
 }
 
 bool infrared_brute_force_send_next(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
-    const bool success = infrared_signal_search_and_read(
-        brute_force->current_signal, brute_force->ff, brute_force->current_record_name);
+    bool success = false;
+
+    if(brute_force->use_cache) {
+        if(brute_force->current_offset) {
+            success =
+                storage_file_seek(brute_force->cache_file, brute_force->current_offset, true) &&
+                infrared_brute_force_cache_read_signal(
+                    brute_force->cache_file,
+                    brute_force->current_signal,
+                    &brute_force->current_offset);
+        }
+    } else {
+        success = infrared_signal_search_and_read(
+            brute_force->current_signal, brute_force->ff, brute_force->current_record_name);
+    }
+
     if(success) {
         infrared_signal_transmit(brute_force->current_signal);
     }
@@ -140,7 +518,7 @@ void infrared_brute_force_add_record(
     InfraredBruteForce* brute_force,
     uint32_t index,
     const char* name) {
-    InfraredBruteForceRecord value = {.index = index, .count = 0};
+    InfraredBruteForceRecord value = {.index = index, .count = 0, .offset = 0};
     FuriString* key;
     key = furi_string_alloc_set(name);
     InfraredBruteForceRecordDict_set_at(brute_force->records, key, value);
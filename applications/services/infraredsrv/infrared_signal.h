@@ -37,6 +37,7 @@ InfraredMessage* infrared_signal_get_message(InfraredSignal* signal);
 
 bool infrared_signal_save(InfraredSignal* signal, FlipperFormat* ff, const char* name);
 bool infrared_signal_read(InfraredSignal* signal, FlipperFormat* ff, FuriString* name);
+bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff);
 bool infrared_signal_search_and_read(
     InfraredSignal* signal,
     FlipperFormat* ff,
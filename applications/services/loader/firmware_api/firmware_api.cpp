@@ -9,15 +9,18 @@
 #include <furi_hal_info.h>
 
 static_assert(!has_hash_collisions(elf_api_table), "Detected API method hash collision!");
+static_assert(elf_api_perfect_hash_table.valid, "Can't build API perfect hash table!");
 
-constexpr HashtableApiInterface elf_api_interface{
+constexpr PerfectHashApiInterface elf_api_interface{
     {
         .api_version_major = (elf_api_version >> 16),
         .api_version_minor = (elf_api_version & 0xFFFF),
-        .resolver_callback = &elf_resolve_from_hashtable,
+        .resolver_callback = &elf_resolve_from_perfect_hash,
     },
-    .table_cbegin = elf_api_table.cbegin(),
-    .table_cend = elf_api_table.cend(),
+    .table = elf_api_perfect_hash_table.entries.data(),
+    .table_size = elf_api_perfect_hash_table.entries.size(),
+    .displacements = elf_api_perfect_hash_table.displacements.data(),
+    .displacements_size = elf_api_perfect_hash_table.displacements.size(),
 };
 
 const ElfApiInterface* const firmware_api_interface = &elf_api_interface;
@@ -9,6 +9,7 @@
 #include <portmacro.h>
 
 #include <furi.h>
+#include <furi_hal.h>
 
 #include <cli/cli.h>
 #include <stdint.h>
@@ -24,6 +25,11 @@ typedef enum {
 
 #define RPC_ALL_EVENTS (RpcEvtNewData | RpcEvtDisconnect)
 
+/* Encoded messages are accumulated here and handed to transport in chunks
+ * of at most this size, so large messages never need a heap buffer.
+ */
+#define RPC_TX_BUFFER_SIZE (1024)
+
 DICT_DEF2(RpcHandlerDict, pb_size_t, M_DEFAULT_OPLIST, RpcHandler, M_POD_OPLIST)
 
 typedef struct {
@@ -83,6 +89,17 @@ struct RpcSession {
     RpcOwner owner;
     bool status;
     void* context;
+
+    uint8_t* tx_buffer;
+    size_t tx_buffer_used;
+    size_t block_size;
+    uint32_t options;
+
+    uint32_t open_tick;
+    uint32_t stat_messages;
+    uint32_t stat_chunks;
+    uint32_t stat_bytes;
+    uint64_t stat_encode_cycles;
 };
 
 struct Rpc {
@@ -154,6 +171,28 @@ void rpc_session_set_terminated_callback(
     furi_mutex_release(session->callbacks_mutex);
 }
 
+void rpc_session_set_block_size(RpcSession* session, size_t block_size) {
+    furi_assert(session);
+    furi_check(block_size && (block_size <= RPC_BLOCK_SIZE_MAX));
+
+    session->block_size = block_size;
+}
+
+size_t rpc_session_get_block_size(RpcSession* session) {
+    furi_assert(session);
+    return session->block_size;
+}
+
+void rpc_session_set_options(RpcSession* session, uint32_t options) {
+    furi_assert(session);
+    session->options = options;
+}
+
+uint32_t rpc_session_get_options(RpcSession* session) {
+    furi_assert(session);
+    return session->options;
+}
+
 /* Doesn't forbid using rpc_feed_bytes() after session close - it's safe.
  * Because any bytes received in buffer will be flushed before next session.
  * If bytes get into stream buffer before it's get emptied and this
@@ -243,6 +282,22 @@ static bool rpc_pb_content_callback(pb_istream_t* stream, const pb_field_t* fiel
     return true;
 }
 
+static void rpc_session_log_stats(RpcSession* session) {
+    RpcSessionStats stats;
+    rpc_session_get_stats(session, &stats);
+
+    uint32_t uptime_s = MAX(stats.uptime_ms / 1000, 1UL);
+    FURI_LOG_I(
+        TAG,
+        "Sent %lu messages (%lu/s), %lu bytes (%lu B/s) in %lu chunks, encode %lu us",
+        stats.messages,
+        stats.messages / uptime_s,
+        stats.bytes,
+        stats.bytes / uptime_s,
+        stats.chunks,
+        stats.encode_us);
+}
+
 static int32_t rpc_session_worker(void* context) {
     furi_assert(context);
     RpcSession* session = (RpcSession*)context;
@@ -324,6 +379,7 @@ static int32_t rpc_session_worker(void* context) {
 
         if(session->terminate) {
             FURI_LOG_D(TAG, "Session terminated");
+            rpc_session_log_stats(session);
             break;
         }
     }
@@ -342,6 +398,7 @@ static void rpc_session_thread_pending_callback(void* context, uint32_t arg) {
     }
     free(session->system_contexts);
     free(session->decoded_message);
+    free(session->tx_buffer);
     RpcHandlerDict_clear(session->handlers);
     furi_stream_buffer_free(session->stream);
 
@@ -373,6 +430,10 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
     session->terminate = false;
     session->decode_error = false;
     session->owner = owner;
+    session->tx_buffer = malloc(RPC_TX_BUFFER_SIZE);
+    session->block_size = RPC_BLOCK_SIZE_DEFAULT;
+    session->options = 0;
+    session->open_tick = furi_get_tick();
     RpcHandlerDict_init(session->handlers);
 
     session->decoded_message = malloc(sizeof(PB_Main));
@@ -430,36 +491,94 @@ void rpc_add_handler(RpcSession* session, pb_size_t message_tag, RpcHandler* han
     RpcHandlerDict_set_at(session->handlers, message_tag, *handler);
 }
 
+/* Must be called with callbacks_mutex held */
+static void rpc_session_tx_flush(RpcSession* session) {
+    if(!session->tx_buffer_used) return;
+
+#if SRV_RPC_DEBUG
+    rpc_debug_print_data("OUTPUT", session->tx_buffer, session->tx_buffer_used);
+#endif
+
+    if(session->send_bytes_callback) {
+        session->send_bytes_callback(
+            session->context, session->tx_buffer, session->tx_buffer_used);
+    }
+
+    session->stat_chunks++;
+    session->stat_bytes += session->tx_buffer_used;
+    session->tx_buffer_used = 0;
+}
+
+static bool rpc_pb_stream_write(pb_ostream_t* ostream, const pb_byte_t* buf, size_t count) {
+    furi_assert(ostream);
+    furi_assert(buf);
+    RpcSession* session = ostream->state;
+    furi_assert(session);
+
+    while(count) {
+        size_t chunk = MIN(count, RPC_TX_BUFFER_SIZE - session->tx_buffer_used);
+        memcpy(&session->tx_buffer[session->tx_buffer_used], buf, chunk);
+        session->tx_buffer_used += chunk;
+        buf += chunk;
+        count -= chunk;
+
+        if(session->tx_buffer_used == RPC_TX_BUFFER_SIZE) {
+            /* Transport time is not encode time */
+            uint32_t flush_start = DWT->CYCCNT;
+            rpc_session_tx_flush(session);
+            session->stat_encode_cycles -= DWT->CYCCNT - flush_start;
+        }
+    }
+
+    return true;
+}
+
 void rpc_send(RpcSession* session, PB_Main* message) {
     furi_assert(session);
     furi_assert(message);
 
-    pb_ostream_t ostream = PB_OSTREAM_SIZING;
-
 #if SRV_RPC_DEBUG
     FURI_LOG_I(TAG, "OUTPUT:");
     rpc_debug_print_message(message);
 #endif
 
+    pb_ostream_t ostream = {
+        .callback = rpc_pb_stream_write,
+        .state = session,
+        .max_size = SIZE_MAX,
+        .bytes_written = 0,
+        .errmsg = NULL,
+    };
+
+    /* TX buffer is shared by all senders of the session, so encoding is
+     * serialized together with transport calls.
+     */
+    furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
+
+    uint32_t encode_start = DWT->CYCCNT;
     bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+    session->stat_encode_cycles += DWT->CYCCNT - encode_start;
     furi_check(result && ostream.bytes_written);
 
-    uint8_t* buffer = malloc(ostream.bytes_written);
-    ostream = pb_ostream_from_buffer(buffer, ostream.bytes_written);
+    rpc_session_tx_flush(session);
+    session->stat_messages++;
 
-    pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+    furi_mutex_release(session->callbacks_mutex);
+}
 
-#if SRV_RPC_DEBUG
-    rpc_debug_print_data("OUTPUT", buffer, ostream.bytes_written);
-#endif
+void rpc_session_get_stats(RpcSession* session, RpcSessionStats* stats) {
+    furi_assert(session);
+    furi_assert(stats);
 
     furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
-    if(session->send_bytes_callback) {
-        session->send_bytes_callback(session->context, buffer, ostream.bytes_written);
-    }
+    stats->uptime_ms =
+        (uint64_t)(furi_get_tick() - session->open_tick) * 1000 / furi_kernel_get_tick_frequency();
+    stats->messages = session->stat_messages;
+    stats->chunks = session->stat_chunks;
+    stats->bytes = session->stat_bytes;
+    stats->encode_us =
+        session->stat_encode_cycles / furi_hal_cortex_instructions_per_microsecond();
     furi_mutex_release(session->callbacks_mutex);
-
-    free(buffer);
 }
 
 void rpc_send_and_release(RpcSession* session, PB_Main* message) {
@@ -11,6 +11,10 @@ extern "C" {
 
 #define RPC_BUFFER_SIZE (1024)
 
+/** Default and max payload size of one frame in chunked data transfers */
+#define RPC_BLOCK_SIZE_DEFAULT (512)
+#define RPC_BLOCK_SIZE_MAX (4096)
+
 #define RECORD_RPC "rpc"
 
 /** Rpc interface. Used for opening session only. */
@@ -38,6 +42,20 @@ typedef enum {
     RpcOwnerCount,
 } RpcOwner;
 
+/** RPC session options, change protocol so enabled only on client request */
+typedef enum {
+    RpcSessionOptionScreenStreamDelta = (1 << 0), /**< delta encoded screen frames */
+} RpcSessionOption;
+
+/** RPC session transmit statistics */
+typedef struct {
+    uint32_t uptime_ms; /**< time since session was opened */
+    uint32_t messages; /**< messages sent */
+    uint32_t chunks; /**< send bytes callback invocations */
+    uint32_t bytes; /**< encoded bytes sent */
+    uint32_t encode_us; /**< time spent encoding, transport excluded */
+} RpcSessionStats;
+
 /** Get RPC session owner
  *
  * @param   session     pointer to RpcSession descriptor
@@ -134,6 +152,49 @@ size_t rpc_session_feed(RpcSession* session, uint8_t* buffer, size_t size, TickT
  */
 size_t rpc_session_get_available_size(RpcSession* session);
 
+/** Set payload size of one frame in chunked data transfers (e.g. storage read)
+ *
+ * Transport layer may raise it when link is fast enough to benefit from
+ * bigger frames. Value is reported to client as "rpc.block_size" property.
+ *
+ * @param   session     pointer to RpcSession descriptor
+ * @param   block_size  payload size, 1..RPC_BLOCK_SIZE_MAX
+ */
+void rpc_session_set_block_size(RpcSession* session, size_t block_size);
+
+/** Get payload size of one frame in chunked data transfers
+ *
+ * @param   session     pointer to RpcSession descriptor
+ *
+ * @return              payload size in bytes
+ */
+size_t rpc_session_get_block_size(RpcSession* session);
+
+/** Set session options
+ *
+ * Transport layer sets options requested by client before any command is fed.
+ * Options are reported to client as "rpc" category properties.
+ *
+ * @param   session     pointer to RpcSession descriptor
+ * @param   options     RpcSessionOption bits
+ */
+void rpc_session_set_options(RpcSession* session, uint32_t options);
+
+/** Get session options
+ *
+ * @param   session     pointer to RpcSession descriptor
+ *
+ * @return              RpcSessionOption bits
+ */
+uint32_t rpc_session_get_options(RpcSession* session);
+
+/** Get RPC session transmit statistics
+ *
+ * @param   session     pointer to RpcSession descriptor
+ * @param   stats       pointer to RpcSessionStats to fill
+ */
+void rpc_session_get_stats(RpcSession* session, RpcSessionStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
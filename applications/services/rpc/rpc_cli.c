@@ -2,6 +2,7 @@
 #include <furi.h>
 #include <rpc/rpc.h>
 #include <furi_hal.h>
+#include <toolbox/args.h>
 #include <semphr.h>
 
 #define TAG "RpcCli"
@@ -37,8 +38,23 @@ static void rpc_cli_session_terminated_callback(void* context) {
     furi_semaphore_release(cli_rpc->terminate_semaphore);
 }
 
+static uint32_t rpc_cli_parse_options(FuriString* args) {
+    uint32_t options = 0;
+    FuriString* option = furi_string_alloc();
+
+    while(args_read_string_and_trim(args, option)) {
+        if(furi_string_cmp_str(option, "screen_delta") == 0) {
+            options |= RpcSessionOptionScreenStreamDelta;
+        } else {
+            FURI_LOG_W(TAG, "Unknown option %s", furi_string_get_cstr(option));
+        }
+    }
+
+    furi_string_free(option);
+    return options;
+}
+
 void rpc_cli_command_start_session(Cli* cli, FuriString* args, void* context) {
-    UNUSED(args);
     furi_assert(cli);
     furi_assert(context);
     Rpc* rpc = context;
@@ -57,6 +73,8 @@ void rpc_cli_command_start_session(Cli* cli, FuriString* args, void* context) {
     CliRpc cli_rpc = {.cli = cli, .session_close_request = false};
     cli_rpc.terminate_semaphore = furi_semaphore_alloc(1, 0);
     rpc_session_set_context(rpc_session, &cli_rpc);
+    rpc_session_set_block_size(rpc_session, RPC_BLOCK_SIZE_MAX);
+    rpc_session_set_options(rpc_session, rpc_cli_parse_options(args));
     rpc_session_set_send_bytes_callback(rpc_session, rpc_cli_send_bytes_callback);
     rpc_session_set_close_callback(rpc_session, rpc_cli_session_close_callback);
     rpc_session_set_terminated_callback(rpc_session, rpc_cli_session_terminated_callback);
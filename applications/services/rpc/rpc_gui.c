@@ -16,6 +16,29 @@ typedef enum {
 
 #define RPC_GUI_INPUT_RESET (0u)
 
+/* Delta encoded screen stream, enabled by RpcSessionOptionScreenStreamDelta
+ *
+ * Each ScreenFrame payload starts with a frame type byte:
+ * - RpcGuiFrameTypeKey: followed by the whole framebuffer
+ * - RpcGuiFrameTypeDelta: followed by a mask of changed pages (8 rows of pixels,
+ *   RPC_GUI_FRAME_PAGE_SIZE bytes each) and then by each changed page XOR-ed with
+ *   the previous frame and run length encoded. Control byte with high bit set
+ *   skips ((byte & 0x7F) + 1) unchanged bytes, otherwise (byte + 1) XOR bytes follow.
+ *
+ * Frames without changes are not sent. Keyframe is sent on stream start, on
+ * orientation change, every RPC_GUI_KEYFRAME_INTERVAL_MS and on repeated
+ * StartScreenStream request.
+ */
+#define RPC_GUI_FRAME_PAGE_SIZE (128u)
+#define RPC_GUI_FRAME_PAGES_MAX (8u)
+#define RPC_GUI_FRAME_RUN_MAX (128u)
+#define RPC_GUI_KEYFRAME_INTERVAL_MS (5000u)
+
+typedef enum {
+    RpcGuiFrameTypeKey = 0,
+    RpcGuiFrameTypeDelta = 1,
+} RpcGuiFrameType;
+
 typedef struct {
     RpcSession* session;
     Gui* gui;
@@ -31,6 +54,17 @@ typedef struct {
     bool virtual_display_not_empty;
     bool is_streaming;
 
+    // Delta encoded stream
+    bool is_delta_streaming;
+    bool keyframe_request;
+    FuriMutex* frame_mutex;
+    uint8_t* frame;
+    uint8_t* sent_frame;
+    size_t frame_size;
+    CanvasOrientation frame_orientation;
+    CanvasOrientation sent_frame_orientation;
+    uint32_t keyframe_tick;
+
     uint32_t input_key_counter[InputKeyMAX];
     uint32_t input_counter;
 
@@ -56,17 +90,118 @@ static void rpc_system_gui_screen_stream_frame_callback(
     furi_assert(context);
 
     RpcGuiSystem* rpc_gui = (RpcGuiSystem*)context;
-    uint8_t* buffer = rpc_gui->transmit_frame->content.gui_screen_frame.data->bytes;
 
-    furi_assert(size == rpc_gui->transmit_frame->content.gui_screen_frame.data->size);
+    if(rpc_gui->is_delta_streaming) {
+        furi_assert(size == rpc_gui->frame_size);
+        // Encoded by transmit thread against the last frame it has sent
+        furi_mutex_acquire(rpc_gui->frame_mutex, FuriWaitForever);
+        memcpy(rpc_gui->frame, data, size);
+        rpc_gui->frame_orientation = orientation;
+        furi_mutex_release(rpc_gui->frame_mutex);
+    } else {
+        uint8_t* buffer = rpc_gui->transmit_frame->content.gui_screen_frame.data->bytes;
 
-    memcpy(buffer, data, size);
-    rpc_gui->transmit_frame->content.gui_screen_frame.orientation =
-        rpc_system_gui_screen_orientation_map[orientation];
+        furi_assert(size == rpc_gui->transmit_frame->content.gui_screen_frame.data->size);
+
+        memcpy(buffer, data, size);
+        rpc_gui->transmit_frame->content.gui_screen_frame.orientation =
+            rpc_system_gui_screen_orientation_map[orientation];
+    }
 
     furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
 }
 
+static size_t rpc_system_gui_screen_stream_encode_delta(
+    uint8_t* out,
+    size_t out_size,
+    const uint8_t* frame,
+    const uint8_t* sent_frame,
+    size_t frame_size) {
+    uint8_t page_mask = 0;
+    size_t size = 2;
+
+    out[0] = RpcGuiFrameTypeDelta;
+
+    for(size_t page = 0; page < frame_size / RPC_GUI_FRAME_PAGE_SIZE; page++) {
+        const uint8_t* new_page = &frame[page * RPC_GUI_FRAME_PAGE_SIZE];
+        const uint8_t* old_page = &sent_frame[page * RPC_GUI_FRAME_PAGE_SIZE];
+
+        if(memcmp(new_page, old_page, RPC_GUI_FRAME_PAGE_SIZE) == 0) continue;
+        page_mask |= 1 << page;
+
+        size_t i = 0;
+        while(i < RPC_GUI_FRAME_PAGE_SIZE) {
+            bool changed = new_page[i] != old_page[i];
+            size_t run = 1;
+            while(i + run < RPC_GUI_FRAME_PAGE_SIZE && run < RPC_GUI_FRAME_RUN_MAX &&
+                  (new_page[i + run] != old_page[i + run]) == changed) {
+                run++;
+            }
+
+            size_t token_size = changed ? run + 1 : 1;
+            if(size + token_size > out_size) {
+                // Delta is not smaller than keyframe
+                return out_size + 1;
+            }
+
+            if(changed) {
+                out[size++] = run - 1;
+                for(size_t j = 0; j < run; j++) {
+                    out[size++] = new_page[i + j] ^ old_page[i + j];
+                }
+            } else {
+                out[size++] = 0x80 | (run - 1);
+            }
+            i += run;
+        }
+    }
+
+    out[1] = page_mask;
+
+    return page_mask ? size : 0;
+}
+
+/** Encode latest frame into transmit frame
+ *
+ * @return     false if frame has no changes and must not be sent
+ */
+static bool rpc_system_gui_screen_stream_encode(RpcGuiSystem* rpc_gui) {
+    PB_Gui_ScreenFrame* screen_frame = &rpc_gui->transmit_frame->content.gui_screen_frame;
+    uint8_t* out = screen_frame->data->bytes;
+    size_t size = 0;
+
+    furi_mutex_acquire(rpc_gui->frame_mutex, FuriWaitForever);
+
+    bool keyframe = rpc_gui->keyframe_request ||
+                    rpc_gui->frame_orientation != rpc_gui->sent_frame_orientation ||
+                    (furi_get_tick() - rpc_gui->keyframe_tick) >=
+                        furi_ms_to_ticks(RPC_GUI_KEYFRAME_INTERVAL_MS);
+
+    if(!keyframe) {
+        size = rpc_system_gui_screen_stream_encode_delta(
+            out, rpc_gui->frame_size, rpc_gui->frame, rpc_gui->sent_frame, rpc_gui->frame_size);
+        keyframe = size > rpc_gui->frame_size;
+    }
+
+    if(keyframe) {
+        out[0] = RpcGuiFrameTypeKey;
+        memcpy(&out[1], rpc_gui->frame, rpc_gui->frame_size);
+        size = rpc_gui->frame_size + 1;
+        rpc_gui->keyframe_request = false;
+        rpc_gui->keyframe_tick = furi_get_tick();
+    }
+
+    memcpy(rpc_gui->sent_frame, rpc_gui->frame, rpc_gui->frame_size);
+    rpc_gui->sent_frame_orientation = rpc_gui->frame_orientation;
+    screen_frame->orientation = rpc_system_gui_screen_orientation_map[rpc_gui->frame_orientation];
+
+    furi_mutex_release(rpc_gui->frame_mutex);
+
+    screen_frame->data->size = size;
+
+    return size > 0;
+}
+
 static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context) {
     furi_assert(context);
 
@@ -77,7 +212,8 @@ static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context)
         uint32_t flags =
             furi_thread_flags_wait(RpcGuiWorkerFlagAny, FuriFlagWaitAny, FuriWaitForever);
 
-        if(flags & RpcGuiWorkerFlagTransmit) {
+        if((flags & RpcGuiWorkerFlagTransmit) &&
+           (!rpc_gui->is_delta_streaming || rpc_system_gui_screen_stream_encode(rpc_gui))) {
             transmit_time = furi_get_tick();
             rpc_send(rpc_gui->session, rpc_gui->transmit_frame);
             transmit_time = furi_get_tick() - transmit_time;
@@ -96,6 +232,18 @@ static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context)
     return 0;
 }
 
+static void rpc_system_gui_screen_stream_delta_free(RpcGuiSystem* rpc_gui) {
+    if(rpc_gui->is_delta_streaming) {
+        rpc_gui->is_delta_streaming = false;
+        furi_mutex_free(rpc_gui->frame_mutex);
+        free(rpc_gui->frame);
+        free(rpc_gui->sent_frame);
+        rpc_gui->frame_mutex = NULL;
+        rpc_gui->frame = NULL;
+        rpc_gui->sent_frame = NULL;
+    }
+}
+
 static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -106,21 +254,44 @@ static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, v
     RpcSession* session = rpc_gui->session;
     furi_assert(session);
 
-    if(rpc_gui->is_streaming) {
+    if(rpc_gui->is_streaming && rpc_gui->is_delta_streaming) {
+        // Client lost track of frames, start over from keyframe
+        furi_mutex_acquire(rpc_gui->frame_mutex, FuriWaitForever);
+        rpc_gui->keyframe_request = true;
+        furi_mutex_release(rpc_gui->frame_mutex);
+        rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_OK);
+        furi_thread_flags_set(
+            furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
+    } else if(rpc_gui->is_streaming) {
         rpc_send_and_release_empty(
             session, request->command_id, PB_CommandStatus_ERROR_VIRTUAL_DISPLAY_ALREADY_STARTED);
     } else {
         rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_OK);
 
         rpc_gui->is_streaming = true;
+        rpc_gui->is_delta_streaming = rpc_session_get_options(session) &
+                                      RpcSessionOptionScreenStreamDelta;
         size_t framebuffer_size = gui_get_framebuffer_size(rpc_gui->gui);
+        size_t frame_data_size = framebuffer_size;
+        if(rpc_gui->is_delta_streaming) {
+            furi_check(
+                framebuffer_size % RPC_GUI_FRAME_PAGE_SIZE == 0 &&
+                framebuffer_size <= RPC_GUI_FRAME_PAGE_SIZE * RPC_GUI_FRAME_PAGES_MAX);
+            rpc_gui->frame_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+            rpc_gui->frame = malloc(framebuffer_size);
+            rpc_gui->sent_frame = malloc(framebuffer_size);
+            rpc_gui->frame_size = framebuffer_size;
+            rpc_gui->keyframe_request = true;
+            // Frame type byte
+            frame_data_size += 1;
+        }
         // Reusable Frame
         rpc_gui->transmit_frame = malloc(sizeof(PB_Main));
         rpc_gui->transmit_frame->which_content = PB_Main_gui_screen_frame_tag;
         rpc_gui->transmit_frame->command_status = PB_CommandStatus_OK;
         rpc_gui->transmit_frame->content.gui_screen_frame.data =
-            malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(framebuffer_size));
-        rpc_gui->transmit_frame->content.gui_screen_frame.data->size = framebuffer_size;
+            malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(frame_data_size));
+        rpc_gui->transmit_frame->content.gui_screen_frame.data->size = frame_data_size;
         // Transmission thread for async TX
         rpc_gui->transmit_thread = furi_thread_alloc_ex(
             "GuiRpcWorker", 1024, rpc_system_gui_screen_stream_frame_transmit_thread, rpc_gui);
@@ -154,6 +325,7 @@ static void rpc_system_gui_stop_screen_stream_process(const PB_Main* request, vo
         pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
         free(rpc_gui->transmit_frame);
         rpc_gui->transmit_frame = NULL;
+        rpc_system_gui_screen_stream_delta_free(rpc_gui);
     }
 
     rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_OK);
@@ -496,6 +668,7 @@ void rpc_system_gui_free(void* context) {
         pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
         free(rpc_gui->transmit_frame);
         rpc_gui->transmit_frame = NULL;
+        rpc_system_gui_screen_stream_delta_free(rpc_gui);
     }
     furi_record_close(RECORD_GUI);
     free(rpc_gui);
@@ -3,6 +3,7 @@
 #include <furi_hal_info.h>
 #include <furi_hal_power.h>
 #include <core/core_defines.h>
+#include <toolbox/property.h>
 
 #include "rpc_i.h"
 
@@ -11,6 +12,7 @@
 #define PROPERTY_CATEGORY_DEVICE_INFO "devinfo"
 #define PROPERTY_CATEGORY_POWER_INFO "pwrinfo"
 #define PROPERTY_CATEGORY_POWER_DEBUG "pwrdebug"
+#define PROPERTY_CATEGORY_RPC "rpc"
 
 typedef struct {
     RpcSession* session;
@@ -41,6 +43,31 @@ static void
     }
 }
 
+static void rpc_system_property_rpc_get(RpcSession* session, RpcPropertyContext* context) {
+    PropertyValueContext property_context = {
+        .key = furi_string_alloc(),
+        .value = furi_string_alloc(),
+        .out = rpc_system_property_get_callback,
+        .sep = '.',
+        .last = false,
+        .context = context,
+    };
+
+    property_value_out(
+        &property_context, "%zu", 1, "block_size", rpc_session_get_block_size(session));
+
+    property_context.last = true;
+    property_value_out(
+        &property_context,
+        NULL,
+        1,
+        "screen_delta",
+        (rpc_session_get_options(session) & RpcSessionOptionScreenStreamDelta) ? "1" : "0");
+
+    furi_string_free(property_context.key);
+    furi_string_free(property_context.value);
+}
+
 static void rpc_system_property_get_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(request->which_content == PB_Main_property_get_request_tag);
@@ -81,6 +108,8 @@ static void rpc_system_property_get_process(const PB_Main* request, void* contex
         furi_hal_power_info_get(rpc_system_property_get_callback, '.', &property_context);
     } else if(!furi_string_cmp(topkey, PROPERTY_CATEGORY_POWER_DEBUG)) {
         furi_hal_power_debug_get(rpc_system_property_get_callback, &property_context);
+    } else if(!furi_string_cmp(topkey, PROPERTY_CATEGORY_RPC)) {
+        rpc_system_property_rpc_get(session, &property_context);
     } else {
         rpc_send_and_release_empty(
             session, request->command_id, PB_CommandStatus_ERROR_INVALID_PARAMETERS);
@@ -17,7 +17,8 @@
 
 #define MAX_NAME_LENGTH 255
 
-static const size_t MAX_DATA_SIZE = 512;
+/* Incoming write frames are collected up to this size before hitting storage */
+#define WRITE_BUFFER_SIZE (4096)
 
 typedef enum {
     RpcStorageStateIdle = 0,
@@ -30,8 +31,19 @@ typedef struct {
     File* file;
     RpcStorageState state;
     uint32_t current_command_id;
+    uint8_t* write_buffer;
+    size_t write_buffer_used;
 } RpcStorageSystem;
 
+static bool rpc_system_storage_write_flush(RpcStorageSystem* rpc_storage) {
+    size_t size = rpc_storage->write_buffer_used;
+    rpc_storage->write_buffer_used = 0;
+
+    if(!size) return true;
+
+    return storage_file_write(rpc_storage->file, rpc_storage->write_buffer, size) == size;
+}
+
 static void rpc_system_storage_reset_state(
     RpcStorageSystem* rpc_storage,
     RpcSession* session,
@@ -48,6 +60,9 @@ static void rpc_system_storage_reset_state(
         }
 
         if(rpc_storage->state == RpcStorageStateWriting) {
+            /* Keep data received before interruption, as unbuffered write did */
+            rpc_system_storage_write_flush(rpc_storage);
+            free(rpc_storage->write_buffer);
             storage_file_close(rpc_storage->file);
             storage_file_free(rpc_storage->file);
             furi_record_close(RECORD_STORAGE);
@@ -273,6 +288,7 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
 
     bool finish = false;
     int i = 0;
+    StorageDirEntry entries[COUNT_OF(list->file)] = {0};
 
     if(!storage_dir_open(dir, request->content.storage_list_request.path)) {
         response.command_status = rpc_system_storage_get_file_error(dir);
@@ -281,32 +297,46 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     }
 
     while(!finish) {
-        FileInfo fileinfo;
-        char* name = malloc(MAX_NAME_LENGTH + 1);
-        if(storage_dir_read(dir, &fileinfo, name, MAX_NAME_LENGTH)) {
-            if(path_contains_only_ascii(name)) {
-                if(i == COUNT_OF(list->file)) {
-                    list->file_count = i;
-                    response.has_next = true;
-                    rpc_send_and_release(session, &response);
-                    i = 0;
-                }
-                list->file[i].type = file_info_is_dir(&fileinfo) ? PB_Storage_File_FileType_DIR :
-                                                                   PB_Storage_File_FileType_FILE;
-                list->file[i].size = fileinfo.size;
-                list->file[i].data = NULL;
-                list->file[i].name = name;
-                ++i;
-            } else {
-                free(name);
+        for(size_t j = 0; j < COUNT_OF(entries); ++j) {
+            if(!entries[j].name) {
+                entries[j].name = malloc(MAX_NAME_LENGTH + 1);
             }
-        } else {
+        }
+
+        size_t read_count =
+            storage_dir_read_batch(dir, entries, COUNT_OF(entries), MAX_NAME_LENGTH, NULL);
+        finish = (read_count < COUNT_OF(entries));
+
+        for(size_t j = 0; j < read_count; ++j) {
+            if(!path_contains_only_ascii(entries[j].name)) {
+                continue;
+            }
+            if(i == COUNT_OF(list->file)) {
+                list->file_count = i;
+                response.has_next = true;
+                rpc_send_and_release(session, &response);
+                i = 0;
+            }
+            FileInfo* fileinfo = &entries[j].fileinfo;
+            list->file[i].type = file_info_is_dir(fileinfo) ? PB_Storage_File_FileType_DIR :
+                                                              PB_Storage_File_FileType_FILE;
+            list->file[i].size = fileinfo->size;
+            list->file[i].data = NULL;
+            /* name buffer is released with response */
+            list->file[i].name = entries[j].name;
+            entries[j].name = NULL;
+            ++i;
+        }
+
+        if(finish) {
             list->file_count = i;
-            finish = true;
-            free(name);
         }
     }
 
+    for(size_t j = 0; j < COUNT_OF(entries); ++j) {
+        free(entries[j].name);
+    }
+
     response.has_next = false;
     rpc_send_and_release(session, &response);
 
@@ -329,8 +359,10 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
 
     rpc_system_storage_reset_state(rpc_storage, session, true);
 
-    /* use same message memory to send response */
+    /* use same message and data memory to send every response */
     PB_Main* response = malloc(sizeof(PB_Main));
+    const size_t block_size = rpc_session_get_block_size(session);
+    pb_bytes_array_t* data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(block_size));
     const char* path = request->content.storage_read_request.path;
     Storage* fs_api = furi_record_open(RECORD_STORAGE);
     File* file = storage_file_alloc(fs_api);
@@ -338,35 +370,24 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
 
     if(fs_operation_success) {
         size_t size_left = storage_file_size(file);
-        do {
-            response->command_id = request->command_id;
-            response->which_content = PB_Main_storage_read_response_tag;
-            response->command_status = PB_CommandStatus_OK;
+        response->command_id = request->command_id;
+        response->which_content = PB_Main_storage_read_response_tag;
+        response->command_status = PB_CommandStatus_OK;
+        response->content.storage_read_response.has_file = true;
+        response->content.storage_read_response.file.data = data;
 
-            size_t read_size = MIN(size_left, MAX_DATA_SIZE);
+        do {
+            size_t read_size = MIN(size_left, block_size);
+            data->size = 0;
             if(read_size) {
-                response->content.storage_read_response.has_file = true;
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(read_size));
-                uint8_t* buffer = &response->content.storage_read_response.file.data->bytes[0];
-                uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
-
-                *read_size_msg = storage_file_read(file, buffer, read_size);
-                size_left -= *read_size_msg;
-                fs_operation_success = (*read_size_msg == read_size);
-
-                response->has_next = fs_operation_success && (size_left > 0);
-            } else {
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(0));
-                response->content.storage_read_response.file.data->size = 0;
-                response->content.storage_read_response.has_file = true;
-                response->has_next = false;
-                fs_operation_success = true;
+                data->size = storage_file_read(file, data->bytes, read_size);
+                size_left -= data->size;
+                fs_operation_success = (data->size == read_size);
             }
+            response->has_next = fs_operation_success && (size_left > 0);
 
             if(fs_operation_success) {
-                rpc_send_and_release(session, response);
+                rpc_send(session, response);
             }
         } while((size_left != 0) && fs_operation_success);
     }
@@ -376,6 +397,7 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
             session, request->command_id, rpc_system_storage_get_file_error(file));
     }
 
+    free(data);
     free(response);
     storage_file_close(file);
     storage_file_free(file);
@@ -415,6 +437,8 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
         rpc_storage->current_command_id = request->command_id;
         rpc_storage->state = RpcStorageStateWriting;
         const char* path = request->content.storage_write_request.path;
+        rpc_storage->write_buffer = malloc(WRITE_BUFFER_SIZE);
+        rpc_storage->write_buffer_used = 0;
         fs_operation_success =
             storage_file_open(rpc_storage->file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
     }
@@ -428,8 +452,23 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
            request->content.storage_write_request.file.data->size) {
             uint8_t* buffer = request->content.storage_write_request.file.data->bytes;
             size_t buffer_size = request->content.storage_write_request.file.data->size;
-            uint16_t written_size = storage_file_write(file, buffer, buffer_size);
-            fs_operation_success = (written_size == buffer_size);
+            if(rpc_storage->write_buffer_used + buffer_size > WRITE_BUFFER_SIZE) {
+                fs_operation_success = rpc_system_storage_write_flush(rpc_storage);
+            }
+            if(fs_operation_success && (buffer_size >= WRITE_BUFFER_SIZE)) {
+                size_t written_size = storage_file_write(file, buffer, buffer_size);
+                fs_operation_success = (written_size == buffer_size);
+            } else if(fs_operation_success) {
+                memcpy(
+                    &rpc_storage->write_buffer[rpc_storage->write_buffer_used],
+                    buffer,
+                    buffer_size);
+                rpc_storage->write_buffer_used += buffer_size;
+            }
+        }
+
+        if(fs_operation_success && !request->has_next) {
+            fs_operation_success = rpc_system_storage_write_flush(rpc_storage);
         }
 
         send_response = !request->has_next;
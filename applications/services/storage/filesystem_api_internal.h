@@ -123,6 +123,16 @@ typedef struct {
  *  @var FS_Dir_Api::rewind
  *      @brief Rewind to first object info in directory
  *      @param file pointer to file object
+ *      @return success flag * 
+ *  @var FS_Dir_Api::tell
+ *      @brief Get opaque position of the next object info in directory
+ *      @param file pointer to file object
+ *      @return position, valid only for FS_Dir_Api::seek on the same directory
+ * 
+ *  @var FS_Dir_Api::seek
+ *      @brief Move to position previously obtained by FS_Dir_Api::tell
+ *      @param file pointer to file object
+ *      @param position position to move to
  *      @return success flag
  */
 typedef struct {
@@ -135,6 +145,8 @@ typedef struct {
         char* name,
         uint16_t name_length);
     bool (*const rewind)(void* context, File* file);
+    uint32_t (*const tell)(void* context, File* file);
+    bool (*const seek)(void* context, File* file, uint32_t position);
 } FS_Dir_Api;
 
 /** Common api structure
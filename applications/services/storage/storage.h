@@ -186,12 +186,48 @@ bool storage_dir_close(File* file);
  */
 bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length);
 
+/** Directory entry filled by storage_dir_read_batch */
+typedef struct {
+    FileInfo fileinfo; /**< object info */
+    char* name; /**< name buffer, provided by caller */
+} StorageDirEntry;
+
+/** Reads up to count next objects in the directory with a single storage request
+ * @param file pointer to file object.
+ * @param entries array of entries, each must have name buffer of name_length bytes
+ * @param count entries array length
+ * @param name_length length of each name buffer
+ * @param extension if not NULL, files not ending with it are skipped, directories are always read
+ * @return number of entries read. If it is less than count, the end of the directory was
+ * reached (file error id is FSE_NOT_EXIST) or an error occurred
+ */
+size_t storage_dir_read_batch(
+    File* file,
+    StorageDirEntry* entries,
+    size_t count,
+    uint16_t name_length,
+    const char* extension);
+
 /** Rewinds the read pointer to first item in the directory
  * @param file pointer to file object.
  * @return bool success flag
  */
 bool storage_dir_rewind(File* file);
 
+/** Gets the position of the next item in the directory
+ * @param file pointer to file object.
+ * @return opaque position, only meaningful for storage_dir_seek on the same directory
+ */
+uint32_t storage_dir_tell(File* file);
+
+/** Moves the read pointer to a position obtained by storage_dir_tell
+ * The position becomes stale once the directory contents are changed
+ * @param file pointer to file object.
+ * @param position position to move to
+ * @return bool success flag
+ */
+bool storage_dir_seek(File* file, uint32_t position);
+
 /**
  * @brief Check that dir exists
  * 
@@ -272,6 +308,26 @@ FS_Error storage_common_fs_info(
     uint64_t* total_space,
     uint64_t* free_space);
 
+/** File IO statistics of the storage */
+typedef struct {
+    uint32_t read_requests; /**< file read calls */
+    uint64_t read_bytes; /**< bytes returned by file read calls */
+    uint32_t read_transactions; /**< reads passed to the filesystem */
+    uint64_t read_transaction_bytes; /**< bytes read from the filesystem */
+    uint32_t write_requests; /**< file write calls */
+    uint64_t write_bytes; /**< bytes accepted by file write calls */
+    uint32_t write_transactions; /**< writes passed to the filesystem */
+    uint64_t write_transaction_bytes; /**< bytes written to the filesystem */
+} StorageIoStats;
+
+/** Gets file IO statistics of the storage
+ * @param app pointer to the api
+ * @param fs_path the path to the storage of interest
+ * @param stats pointer to stats record, will be filled
+ * @return FS_Error operation result
+ */
+FS_Error storage_common_io_stats(Storage* storage, const char* fs_path, StorageIoStats* stats);
+
 /**
  * @brief Parse aliases in path and replace them with real path
  * Also will create special folders if they are not exist
@@ -33,6 +33,7 @@ static void storage_cli_print_usage() {
     printf("\tmd5\t - md5 hash of the file\r\n");
     printf("\tstat\t - info about file or dir\r\n");
     printf("\ttimestamp\t - last modification timestamp\r\n");
+    printf("\tstats\t - file IO statistics, bytes per filesystem transaction\r\n");
 }
 
 static void storage_cli_print_error(FS_Error error) {
@@ -88,6 +89,42 @@ static void storage_cli_info(Cli* cli, FuriString* path) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static void storage_cli_stats(Cli* cli, FuriString* path) {
+    UNUSED(cli);
+    Storage* api = furi_record_open(RECORD_STORAGE);
+
+    if(furi_string_cmp_str(path, STORAGE_INT_PATH_PREFIX) == 0 ||
+       furi_string_cmp_str(path, STORAGE_EXT_PATH_PREFIX) == 0) {
+        StorageIoStats stats;
+        FS_Error error = storage_common_io_stats(api, furi_string_get_cstr(path), &stats);
+
+        if(error != FSE_OK) {
+            storage_cli_print_error(error);
+        } else {
+            printf(
+                "Read: %lu requests, %lu transactions, %luKiB, %lu bytes per transaction\r\n",
+                stats.read_requests,
+                stats.read_transactions,
+                (uint32_t)(stats.read_transaction_bytes / 1024),
+                stats.read_transactions ?
+                    (uint32_t)(stats.read_transaction_bytes / stats.read_transactions) :
+                    0);
+            printf(
+                "Write: %lu requests, %lu transactions, %luKiB, %lu bytes per transaction\r\n",
+                stats.write_requests,
+                stats.write_transactions,
+                (uint32_t)(stats.write_transaction_bytes / 1024),
+                stats.write_transactions ?
+                    (uint32_t)(stats.write_transaction_bytes / stats.write_transactions) :
+                    0);
+        }
+    } else {
+        storage_cli_print_usage();
+    }
+
+    furi_record_close(RECORD_STORAGE);
+}
+
 static void storage_cli_format(Cli* cli, FuriString* path) {
     if(furi_string_cmp_str(path, STORAGE_INT_PATH_PREFIX) == 0) {
         storage_cli_print_error(FSE_NOT_IMPLEMENTED);
@@ -609,6 +646,11 @@ void storage_cli(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "stats") == 0) {
+            storage_cli_stats(cli, path);
+            break;
+        }
+
         storage_cli_print_usage();
     } while(false);
 
@@ -42,7 +42,9 @@
 
 #define S_RETURN_BOOL (return_data.bool_value);
 #define S_RETURN_UINT16 (return_data.uint16_value);
+#define S_RETURN_UINT32 (return_data.uint32_value);
 #define S_RETURN_UINT64 (return_data.uint64_value);
+#define S_RETURN_SIZE (return_data.size_value);
 #define S_RETURN_ERROR (return_data.error_value);
 #define S_RETURN_CSTRING (return_data.cstring_value);
 
@@ -357,6 +359,29 @@ bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_
     return S_RETURN_BOOL;
 }
 
+size_t storage_dir_read_batch(
+    File* file,
+    StorageDirEntry* entries,
+    size_t count,
+    uint16_t name_length,
+    const char* extension) {
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .dreadbatch = {
+            .file = file,
+            .entries = entries,
+            .count = count,
+            .name_length = name_length,
+            .extension = extension,
+        }};
+
+    S_API_MESSAGE(StorageCommandDirReadBatch);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
 bool storage_dir_rewind(File* file) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
@@ -366,6 +391,30 @@ bool storage_dir_rewind(File* file) {
     return S_RETURN_BOOL;
 }
 
+uint32_t storage_dir_tell(File* file) {
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+    S_API_DATA_FILE;
+    S_API_MESSAGE(StorageCommandDirTell);
+    S_API_EPILOGUE;
+    return S_RETURN_UINT32;
+}
+
+bool storage_dir_seek(File* file, uint32_t position) {
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .dseek = {
+            .file = file,
+            .position = position,
+        }};
+
+    S_API_MESSAGE(StorageCommandDirSeek);
+    S_API_EPILOGUE;
+    return S_RETURN_BOOL;
+}
+
 bool storage_dir_exists(Storage* storage, const char* path) {
     bool exist = false;
     FileInfo fileinfo;
@@ -696,6 +745,21 @@ FS_Error storage_common_fs_info(
     return S_RETURN_ERROR;
 }
 
+FS_Error storage_common_io_stats(Storage* storage, const char* fs_path, StorageIoStats* stats) {
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .ciostats = {
+            .fs_path = fs_path,
+            .stats = stats,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandCommonIoStats);
+    S_API_EPILOGUE;
+    return S_RETURN_ERROR;
+}
+
 void storage_common_resolve_path_and_ensure_app_directory(Storage* storage, FuriString* path) {
     S_API_PROLOGUE;
 
@@ -7,18 +7,21 @@ void storage_file_init(StorageFile* obj) {
     obj->file = NULL;
     obj->file_data = NULL;
     obj->path = furi_string_alloc();
+    memset(&obj->buffer, 0, sizeof(StorageFileBuffer));
 }
 
 void storage_file_init_set(StorageFile* obj, const StorageFile* src) {
     obj->file = src->file;
     obj->file_data = src->file_data;
     obj->path = furi_string_alloc_set(src->path);
+    obj->buffer = src->buffer;
 }
 
 void storage_file_set(StorageFile* obj, const StorageFile* src) { //-V524
     obj->file = src->file;
     obj->file_data = src->file_data;
     furi_string_set(obj->path, src->path);
+    obj->buffer = src->buffer;
 }
 
 void storage_file_clear(StorageFile* obj) {
@@ -31,6 +34,8 @@ void storage_data_init(StorageData* storage) {
     storage->data = NULL;
     storage->status = StorageStatusNotReady;
     StorageFileList_init(storage->files);
+    storage->buffered = false;
+    memset(&storage->io_stats, 0, sizeof(StorageIoStats));
 }
 
 StorageStatus storage_data_status(StorageData* storage) {
@@ -124,6 +129,12 @@ void* storage_get_storage_file_data(const File* file, StorageData* storage) {
     return storage_file_ref->file_data;
 }
 
+StorageFileBuffer* storage_get_storage_file_buffer(const File* file, StorageData* storage) {
+    StorageFile* storage_file_ref = storage_get_file(file, storage);
+    furi_check(storage_file_ref != NULL);
+    return &storage_file_ref->buffer;
+}
+
 void storage_push_storage_file(File* file, FuriString* path, StorageData* storage) {
     StorageFile* storage_file = StorageFileList_push_new(storage->files);
     file->file_id = (uint32_t)storage_file;
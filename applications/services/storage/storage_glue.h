@@ -2,6 +2,7 @@
 
 #include <furi.h>
 #include "filesystem_api_internal.h"
+#include "storage.h"
 #include <m-list.h>
 
 #ifdef __cplusplus
@@ -16,10 +17,26 @@ typedef struct {
     void (*tick)(StorageData* storage);
 } StorageApi;
 
+typedef enum {
+    StorageFileBufferModeNone, /**< buffer is empty */
+    StorageFileBufferModeRead, /**< buffer holds data read ahead of file position */
+    StorageFileBufferModeWrite, /**< buffer holds data not yet written to filesystem */
+} StorageFileBufferMode;
+
+typedef struct {
+    StorageFileBufferMode mode;
+    uint8_t* data;
+    uint16_t capacity;
+    uint16_t size; /**< bytes read ahead or pending write */
+    uint16_t position; /**< bytes of read ahead data already returned */
+    uint8_t small_requests; /**< consecutive small sequential requests */
+} StorageFileBuffer;
+
 typedef struct {
     File* file;
     void* file_data;
     FuriString* path;
+    StorageFileBuffer buffer;
 } StorageFile;
 
 typedef enum {
@@ -57,6 +74,8 @@ struct StorageData {
     StorageStatus status;
     StorageFileList_t files;
     uint32_t timestamp;
+    bool buffered; /**< enables read ahead and write behind for files */
+    StorageIoStats io_stats;
 };
 
 bool storage_has_file(const File* file, StorageData* storage_data);
@@ -64,6 +83,7 @@ bool storage_path_already_open(FuriString* path, StorageData* storage_data);
 
 void storage_set_storage_file_data(const File* file, void* file_data, StorageData* storage);
 void* storage_get_storage_file_data(const File* file, StorageData* storage);
+StorageFileBuffer* storage_get_storage_file_buffer(const File* file, StorageData* storage);
 
 void storage_push_storage_file(File* file, FuriString* path, StorageData* storage);
 bool storage_pop_storage_file(File* file, StorageData* storage);
@@ -45,6 +45,19 @@ typedef struct {
     uint16_t name_length;
 } SADataDRead;
 
+typedef struct {
+    File* file;
+    StorageDirEntry* entries;
+    size_t count;
+    uint16_t name_length;
+    const char* extension;
+} SADataDReadBatch;
+
+typedef struct {
+    File* file;
+    uint32_t position;
+} SADataDSeek;
+
 typedef struct {
     const char* path;
     uint32_t* timestamp;
@@ -64,6 +77,12 @@ typedef struct {
     FuriThreadId thread_id;
 } SADataCFSInfo;
 
+typedef struct {
+    const char* fs_path;
+    StorageIoStats* stats;
+    FuriThreadId thread_id;
+} SADataCIoStats;
+
 typedef struct {
     FuriString* path;
     FuriThreadId thread_id;
@@ -94,10 +113,13 @@ typedef union {
 
     SADataDOpen dopen;
     SADataDRead dread;
+    SADataDReadBatch dreadbatch;
+    SADataDSeek dseek;
 
     SADataCTimestamp ctimestamp;
     SADataCStat cstat;
     SADataCFSInfo cfsinfo;
+    SADataCIoStats ciostats;
     SADataCResolvePath cresolvepath;
 
     SADataError error;
@@ -111,7 +133,9 @@ typedef union {
 typedef union {
     bool bool_value;
     uint16_t uint16_value;
+    uint32_t uint32_value;
     uint64_t uint64_value;
+    size_t size_value;
     FS_Error error_value;
     const char* cstring_value;
 } SAReturn;
@@ -130,12 +154,16 @@ typedef enum {
     StorageCommandDirOpen,
     StorageCommandDirClose,
     StorageCommandDirRead,
+    StorageCommandDirReadBatch,
     StorageCommandDirRewind,
+    StorageCommandDirTell,
+    StorageCommandDirSeek,
     StorageCommandCommonTimestamp,
     StorageCommandCommonStat,
     StorageCommandCommonRemove,
     StorageCommandCommonMkDir,
     StorageCommandCommonFSInfo,
+    StorageCommandCommonIoStats,
     StorageCommandSDFormat,
     StorageCommandSDUnmount,
     StorageCommandSDInfo,
@@ -98,6 +98,218 @@ FS_Error storage_get_data(Storage* app, FuriString* path, StorageData** storage)
     }
 }
 
+/******************* File Buffers *******************/
+
+#define STORAGE_FILE_BUFFER_MIN_SIZE 1024u
+#define STORAGE_FILE_BUFFER_MAX_SIZE 4096u
+#define STORAGE_FILE_BUFFER_HEAP_RESERVE (8 * 1024)
+// Sequential requests smaller than buffer before buffering kicks in
+#define STORAGE_FILE_BUFFER_SMALL_REQUESTS 3u
+
+static uint16_t
+    storage_file_fs_read(StorageData* storage, File* file, void* buff, uint16_t bytes_to_read) {
+    uint16_t ret = 0;
+    FS_CALL(storage, file.read(storage, file, buff, bytes_to_read));
+    storage->io_stats.read_transactions++;
+    storage->io_stats.read_transaction_bytes += ret;
+    return ret;
+}
+
+static uint16_t storage_file_fs_write(
+    StorageData* storage,
+    File* file,
+    const void* buff,
+    uint16_t bytes_to_write) {
+    uint16_t ret = 0;
+    FS_CALL(storage, file.write(storage, file, buff, bytes_to_write));
+    storage->io_stats.write_transactions++;
+    storage->io_stats.write_transaction_bytes += ret;
+    return ret;
+}
+
+/** Allocate buffer, or make it bigger if the stream keeps going
+ * Must be called on empty buffer only
+ */
+static bool storage_file_buffer_grow(StorageFileBuffer* buffer, bool grow) {
+    uint16_t capacity = STORAGE_FILE_BUFFER_MIN_SIZE;
+    if(buffer->data) {
+        capacity = grow ? MIN(buffer->capacity * 2u, STORAGE_FILE_BUFFER_MAX_SIZE) :
+                          buffer->capacity;
+    }
+
+    if(capacity != buffer->capacity &&
+       memmgr_heap_get_max_free_block() >= capacity + STORAGE_FILE_BUFFER_HEAP_RESERVE) {
+        free(buffer->data);
+        buffer->data = malloc(capacity);
+        buffer->capacity = capacity;
+    }
+
+    return buffer->data != NULL;
+}
+
+static void storage_file_buffer_discard(StorageFileBuffer* buffer) {
+    buffer->mode = StorageFileBufferModeNone;
+    buffer->size = 0;
+    buffer->position = 0;
+}
+
+static void storage_file_buffer_free(StorageFileBuffer* buffer) {
+    free(buffer->data);
+    memset(buffer, 0, sizeof(StorageFileBuffer));
+}
+
+static uint16_t storage_file_buffer_unread(StorageFileBuffer* buffer) {
+    return buffer->mode == StorageFileBufferModeRead ? buffer->size - buffer->position : 0;
+}
+
+/** Write pending data to filesystem */
+static bool
+    storage_file_buffer_flush(StorageData* storage, File* file, StorageFileBuffer* buffer) {
+    bool ret = true;
+
+    if(buffer->mode == StorageFileBufferModeWrite) {
+        uint16_t written = storage_file_fs_write(storage, file, buffer->data, buffer->size);
+        ret = (file->error_id == FSE_OK) && (written == buffer->size);
+        if(!ret && file->error_id == FSE_OK) {
+            // Short write, no space left
+            file->error_id = FSE_INTERNAL;
+        }
+        storage_file_buffer_discard(buffer);
+    }
+
+    return ret;
+}
+
+/** Drop read ahead data and move filesystem position back to the client position */
+static bool
+    storage_file_buffer_rewind(StorageData* storage, File* file, StorageFileBuffer* buffer) {
+    bool ret = true;
+
+    if(buffer->mode == StorageFileBufferModeRead) {
+        uint16_t unread = storage_file_buffer_unread(buffer);
+        storage_file_buffer_discard(buffer);
+
+        if(unread) {
+            uint64_t position = storage->fs_api->file.tell(storage, file);
+            FS_CALL(storage, file.seek(storage, file, position - unread, true));
+        }
+    }
+
+    return ret;
+}
+
+/** Make filesystem state match the one seen by client */
+static bool
+    storage_file_buffer_commit(StorageData* storage, File* file, StorageFileBuffer* buffer) {
+    if(buffer->mode == StorageFileBufferModeWrite) {
+        return storage_file_buffer_flush(storage, file, buffer);
+    } else {
+        return storage_file_buffer_rewind(storage, file, buffer);
+    }
+}
+
+static uint16_t storage_file_buffer_read(
+    StorageData* storage,
+    File* file,
+    StorageFileBuffer* buffer,
+    uint8_t* buff,
+    uint16_t bytes_to_read) {
+    uint16_t bytes_read = 0;
+
+    if(!storage_file_buffer_flush(storage, file, buffer)) {
+        return 0;
+    }
+
+    if(buffer->mode == StorageFileBufferModeRead) {
+        bytes_read = MIN(storage_file_buffer_unread(buffer), bytes_to_read);
+        memcpy(buff, &buffer->data[buffer->position], bytes_read);
+        buffer->position += bytes_read;
+        file->error_id = FSE_OK;
+    }
+
+    if(bytes_read < bytes_to_read) {
+        uint16_t remaining = bytes_to_read - bytes_read;
+        // Whole read ahead buffer was consumed, read more next time
+        bool grow = (buffer->mode == StorageFileBufferModeRead) &&
+                    (buffer->size == buffer->capacity);
+        storage_file_buffer_discard(buffer);
+
+        if(remaining >= STORAGE_FILE_BUFFER_MIN_SIZE) {
+            buffer->small_requests = 0;
+        } else if(buffer->small_requests < STORAGE_FILE_BUFFER_SMALL_REQUESTS) {
+            buffer->small_requests++;
+        }
+
+        if(buffer->small_requests == STORAGE_FILE_BUFFER_SMALL_REQUESTS &&
+           storage_file_buffer_grow(buffer, grow)) {
+            buffer->size = storage_file_fs_read(storage, file, buffer->data, buffer->capacity);
+            buffer->mode = StorageFileBufferModeRead;
+            buffer->position = MIN(buffer->size, remaining);
+            memcpy(&buff[bytes_read], buffer->data, buffer->position);
+            bytes_read += buffer->position;
+        } else {
+            bytes_read += storage_file_fs_read(storage, file, &buff[bytes_read], remaining);
+        }
+    }
+
+    return bytes_read;
+}
+
+static uint16_t storage_file_buffer_write(
+    StorageData* storage,
+    File* file,
+    StorageFileBuffer* buffer,
+    const uint8_t* buff,
+    uint16_t bytes_to_write) {
+    if(!storage_file_buffer_rewind(storage, file, buffer)) {
+        return 0;
+    }
+
+    if(bytes_to_write >= STORAGE_FILE_BUFFER_MIN_SIZE) {
+        buffer->small_requests = 0;
+        if(!storage_file_buffer_flush(storage, file, buffer)) {
+            return 0;
+        }
+        return storage_file_fs_write(storage, file, buff, bytes_to_write);
+    }
+
+    if(buffer->small_requests < STORAGE_FILE_BUFFER_SMALL_REQUESTS) {
+        buffer->small_requests++;
+    }
+
+    if(buffer->mode != StorageFileBufferModeWrite) {
+        if(buffer->small_requests < STORAGE_FILE_BUFFER_SMALL_REQUESTS ||
+           !storage_file_buffer_grow(buffer, false)) {
+            return storage_file_fs_write(storage, file, buff, bytes_to_write);
+        }
+    } else if(buffer->size + bytes_to_write > buffer->capacity) {
+        if(!storage_file_buffer_flush(storage, file, buffer)) {
+            return 0;
+        }
+        storage_file_buffer_grow(buffer, true);
+    }
+
+    memcpy(&buffer->data[buffer->size], buff, bytes_to_write);
+    buffer->size += bytes_to_write;
+    buffer->mode = StorageFileBufferModeWrite;
+    file->error_id = FSE_OK;
+
+    return bytes_to_write;
+}
+
+/** Flush pending writes of the file opened by path, or of all files if path is NULL */
+static void storage_file_buffers_flush(StorageData* storage, FuriString* path) {
+    StorageFileList_it_t it;
+    for(StorageFileList_it(it, storage->files); !StorageFileList_end_p(it);
+        StorageFileList_next(it)) {
+        StorageFile* storage_file = StorageFileList_ref(it);
+
+        if(path == NULL || furi_string_cmp(storage_file->path, path) == 0) {
+            storage_file_buffer_flush(storage, storage_file->file, &storage_file->buffer);
+        }
+    }
+}
+
 /******************* File Functions *******************/
 
 bool storage_process_file_open(
@@ -134,7 +346,16 @@ bool storage_process_file_close(Storage* app, File* file) {
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
+        StorageFileBuffer* buffer = storage_get_storage_file_buffer(file, storage);
+        bool flushed = storage_file_buffer_flush(storage, file, buffer);
+        FS_Error flush_error = file->error_id;
+        storage_file_buffer_free(buffer);
+
         FS_CALL(storage, file.close(storage, file));
+        if(!flushed) {
+            file->error_id = flush_error;
+            ret = false;
+        }
         storage_pop_storage_file(file, storage);
 
         StorageEvent event = {.type = StorageEventTypeFileClose};
@@ -152,7 +373,18 @@ static uint16_t
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, file.read(storage, file, buff, bytes_to_read));
+        if(storage->buffered) {
+            ret = storage_file_buffer_read(
+                storage,
+                file,
+                storage_get_storage_file_buffer(file, storage),
+                buff,
+                bytes_to_read);
+        } else {
+            ret = storage_file_fs_read(storage, file, buff, bytes_to_read);
+        }
+        storage->io_stats.read_requests++;
+        storage->io_stats.read_bytes += ret;
     }
 
     return ret;
@@ -170,7 +402,18 @@ static uint16_t storage_process_file_write(
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
         storage_data_timestamp(storage);
-        FS_CALL(storage, file.write(storage, file, buff, bytes_to_write));
+        if(storage->buffered) {
+            ret = storage_file_buffer_write(
+                storage,
+                file,
+                storage_get_storage_file_buffer(file, storage),
+                buff,
+                bytes_to_write);
+        } else {
+            ret = storage_file_fs_write(storage, file, buff, bytes_to_write);
+        }
+        storage->io_stats.write_requests++;
+        storage->io_stats.write_bytes += ret;
     }
 
     return ret;
@@ -187,7 +430,24 @@ static bool storage_process_file_seek(
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, file.seek(storage, file, offset, from_start));
+        StorageFileBuffer* buffer = storage_get_storage_file_buffer(file, storage);
+        uint16_t unread = storage_file_buffer_unread(buffer);
+
+        if(!from_start && offset <= unread) {
+            // Skip inside read ahead data
+            buffer->position += offset;
+            file->error_id = FSE_OK;
+            ret = true;
+        } else if(!from_start && unread) {
+            uint64_t position = storage->fs_api->file.tell(storage, file) - unread;
+            storage_file_buffer_discard(buffer);
+            buffer->small_requests = 0;
+            FS_CALL(storage, file.seek(storage, file, position + offset, true));
+        } else if(storage_file_buffer_flush(storage, file, buffer)) {
+            storage_file_buffer_discard(buffer);
+            buffer->small_requests = 0;
+            FS_CALL(storage, file.seek(storage, file, offset, from_start));
+        }
     }
 
     return ret;
@@ -200,7 +460,14 @@ static uint64_t storage_process_file_tell(Storage* app, File* file) {
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
+        StorageFileBuffer* buffer = storage_get_storage_file_buffer(file, storage);
         FS_CALL(storage, file.tell(storage, file));
+
+        if(buffer->mode == StorageFileBufferModeWrite) {
+            ret += buffer->size;
+        } else {
+            ret -= storage_file_buffer_unread(buffer);
+        }
     }
 
     return ret;
@@ -214,7 +481,10 @@ static bool storage_process_file_truncate(Storage* app, File* file) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
         storage_data_timestamp(storage);
-        FS_CALL(storage, file.truncate(storage, file));
+        StorageFileBuffer* buffer = storage_get_storage_file_buffer(file, storage);
+        if(storage_file_buffer_commit(storage, file, buffer)) {
+            FS_CALL(storage, file.truncate(storage, file));
+        }
     }
 
     return ret;
@@ -228,7 +498,10 @@ static bool storage_process_file_sync(Storage* app, File* file) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
         storage_data_timestamp(storage);
-        FS_CALL(storage, file.sync(storage, file));
+        StorageFileBuffer* buffer = storage_get_storage_file_buffer(file, storage);
+        if(storage_file_buffer_flush(storage, file, buffer)) {
+            FS_CALL(storage, file.sync(storage, file));
+        }
     }
 
     return ret;
@@ -241,7 +514,10 @@ static uint64_t storage_process_file_size(Storage* app, File* file) {
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, file.size(storage, file));
+        StorageFileBuffer* buffer = storage_get_storage_file_buffer(file, storage);
+        if(storage_file_buffer_flush(storage, file, buffer)) {
+            FS_CALL(storage, file.size(storage, file));
+        }
     }
 
     return ret;
@@ -254,7 +530,12 @@ static bool storage_process_file_eof(Storage* app, File* file) {
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, file.eof(storage, file));
+        StorageFileBuffer* buffer = storage_get_storage_file_buffer(file, storage);
+        if(storage_file_buffer_unread(buffer)) {
+            file->error_id = FSE_OK;
+        } else if(storage_file_buffer_flush(storage, file, buffer)) {
+            FS_CALL(storage, file.eof(storage, file));
+        }
     }
 
     return ret;
@@ -314,6 +595,44 @@ bool storage_process_dir_read(
     return ret;
 }
 
+static bool storage_name_has_extension(const char* name, const char* extension) {
+    size_t name_length = strlen(name);
+    size_t extension_length = strlen(extension);
+
+    return (name_length >= extension_length) &&
+           (strcmp(&name[name_length - extension_length], extension) == 0);
+}
+
+size_t storage_process_dir_read_batch(
+    Storage* app,
+    File* file,
+    StorageDirEntry* entries,
+    size_t count,
+    const uint16_t name_length,
+    const char* extension) {
+    size_t read_count = 0;
+    StorageData* storage = get_storage_by_file(file, app->storage);
+
+    if(storage == NULL) {
+        file->error_id = FSE_INVALID_PARAMETER;
+    } else {
+        while(read_count < count) {
+            StorageDirEntry* entry = &entries[read_count];
+            bool ret = false;
+            FS_CALL(storage, dir.read(storage, file, &entry->fileinfo, entry->name, name_length));
+            if(!ret) break;
+
+            if(extension && !file_info_is_dir(&entry->fileinfo) &&
+               !storage_name_has_extension(entry->name, extension)) {
+                continue;
+            }
+            read_count++;
+        }
+    }
+
+    return read_count;
+}
+
 bool storage_process_dir_rewind(Storage* app, File* file) {
     bool ret = false;
     StorageData* storage = get_storage_by_file(file, app->storage);
@@ -327,6 +646,32 @@ bool storage_process_dir_rewind(Storage* app, File* file) {
     return ret;
 }
 
+static uint32_t storage_process_dir_tell(Storage* app, File* file) {
+    uint32_t ret = 0;
+    StorageData* storage = get_storage_by_file(file, app->storage);
+
+    if(storage == NULL) {
+        file->error_id = FSE_INVALID_PARAMETER;
+    } else {
+        FS_CALL(storage, dir.tell(storage, file));
+    }
+
+    return ret;
+}
+
+static bool storage_process_dir_seek(Storage* app, File* file, uint32_t position) {
+    bool ret = false;
+    StorageData* storage = get_storage_by_file(file, app->storage);
+
+    if(storage == NULL) {
+        file->error_id = FSE_INVALID_PARAMETER;
+    } else {
+        FS_CALL(storage, dir.seek(storage, file, position));
+    }
+
+    return ret;
+}
+
 /******************* Common FS Functions *******************/
 
 static FS_Error
@@ -346,6 +691,7 @@ static FS_Error storage_process_common_stat(Storage* app, FuriString* path, File
     FS_Error ret = storage_get_data(app, path, &storage);
 
     if(ret == FSE_OK) {
+        storage_file_buffers_flush(storage, path);
         FS_CALL(storage, common.stat(storage, cstr_path_without_vfs_prefix(path), fileinfo));
     }
 
@@ -398,6 +744,18 @@ static FS_Error storage_process_common_fs_info(
     return ret;
 }
 
+static FS_Error
+    storage_process_common_io_stats(Storage* app, FuriString* path, StorageIoStats* stats) {
+    StorageData* storage;
+    FS_Error ret = storage_get_data(app, path, &storage);
+
+    if(ret == FSE_OK) {
+        *stats = storage->io_stats;
+    }
+
+    return ret;
+}
+
 /****************** Raw SD API ******************/
 // TODO think about implementing a custom storage API to split that kind of api linkage
 #include "storages/storage_ext.h"
@@ -421,6 +779,7 @@ static FS_Error storage_process_sd_unmount(Storage* app) {
     if(storage_data_status(&app->storage[ST_EXT]) == StorageStatusNotReady) {
         ret = FSE_NOT_READY;
     } else {
+        storage_file_buffers_flush(&app->storage[ST_EXT], NULL);
         sd_unmount_card(&app->storage[ST_EXT]);
         storage_data_timestamp(&app->storage[ST_EXT]);
     }
@@ -591,10 +950,27 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
             message->data->dread.name,
             message->data->dread.name_length);
         break;
+    case StorageCommandDirReadBatch:
+        message->return_data->size_value = storage_process_dir_read_batch(
+            app,
+            message->data->dreadbatch.file,
+            message->data->dreadbatch.entries,
+            message->data->dreadbatch.count,
+            message->data->dreadbatch.name_length,
+            message->data->dreadbatch.extension);
+        break;
     case StorageCommandDirRewind:
         message->return_data->bool_value =
             storage_process_dir_rewind(app, message->data->file.file);
         break;
+    case StorageCommandDirTell:
+        message->return_data->uint32_value =
+            storage_process_dir_tell(app, message->data->file.file);
+        break;
+    case StorageCommandDirSeek:
+        message->return_data->bool_value = storage_process_dir_seek(
+            app, message->data->dseek.file, message->data->dseek.position);
+        break;
 
     // Common operations
     case StorageCommandCommonTimestamp:
@@ -625,6 +1001,12 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         message->return_data->error_value = storage_process_common_fs_info(
             app, path, message->data->cfsinfo.total_space, message->data->cfsinfo.free_space);
         break;
+    case StorageCommandCommonIoStats:
+        path = furi_string_alloc_set(message->data->ciostats.fs_path);
+        storage_process_alias(app, path, message->data->ciostats.thread_id, false);
+        message->return_data->error_value =
+            storage_process_common_io_stats(app, path, message->data->ciostats.stats);
+        break;
     case StorageCommandCommonResolvePath:
         storage_process_alias(
             app, message->data->cresolvepath.path, message->data->cresolvepath.thread_id, true);
@@ -507,6 +507,32 @@ static bool storage_ext_dir_rewind(void* ctx, File* file) {
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return (file->error_id == FSE_OK);
 }
+
+#define STORAGE_EXT_DIR_END UINT32_MAX
+
+static uint32_t storage_ext_dir_tell(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    SDDir* file_data = storage_get_storage_file_data(file, storage);
+
+    file->internal_error_id = FR_OK;
+    file->error_id = FSE_OK;
+    // FatFs keeps the last offset when the end is reached, mark it explicitly
+    return file_data->sect ? f_telldir(file_data) : STORAGE_EXT_DIR_END;
+}
+
+static bool storage_ext_dir_seek(void* ctx, File* file, uint32_t position) {
+    StorageData* storage = ctx;
+    SDDir* file_data = storage_get_storage_file_data(file, storage);
+
+    if(position == STORAGE_EXT_DIR_END) {
+        file_data->sect = 0;
+        file->internal_error_id = FR_OK;
+    } else {
+        file->internal_error_id = f_seekdir(file_data, position);
+    }
+    file->error_id = storage_ext_parse_error(file->internal_error_id);
+    return (file->error_id == FSE_OK);
+}
 /******************* Common FS Functions *******************/
 
 static FS_Error storage_ext_common_stat(void* ctx, const char* path, FileInfo* fileinfo) {
@@ -608,6 +634,8 @@ static const FS_Api fs_api = {
             .close = storage_ext_dir_close,
             .read = storage_ext_dir_read,
             .rewind = storage_ext_dir_rewind,
+            .tell = storage_ext_dir_tell,
+            .seek = storage_ext_dir_seek,
         },
     .common =
         {
@@ -629,6 +657,7 @@ void storage_ext_init(StorageData* storage) {
     storage->data = sd_data;
     storage->api.tick = storage_ext_tick;
     storage->fs_api = &fs_api;
+    storage->buffered = true;
 
     hal_sd_detect_init();
 
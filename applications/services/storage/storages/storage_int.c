@@ -632,6 +632,38 @@ static bool storage_int_dir_rewind(void* ctx, File* file) {
     return (file->error_id == FSE_OK);
 }
 
+static uint32_t storage_int_dir_tell(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    lfs_t* lfs = lfs_get_from_storage(storage);
+    LFSHandle* handle = storage_get_storage_file_data(file, storage);
+
+    lfs_soff_t position = 0;
+    if(lfs_handle_is_open(handle)) {
+        position = lfs_dir_tell(lfs, lfs_handle_get_dir(handle));
+        file->internal_error_id = (position < 0) ? position : 0;
+    } else {
+        file->internal_error_id = LFS_ERR_BADF;
+    }
+
+    file->error_id = storage_int_parse_error(file->internal_error_id);
+    return (file->error_id == FSE_OK) ? (uint32_t)position : 0;
+}
+
+static bool storage_int_dir_seek(void* ctx, File* file, uint32_t position) {
+    StorageData* storage = ctx;
+    lfs_t* lfs = lfs_get_from_storage(storage);
+    LFSHandle* handle = storage_get_storage_file_data(file, storage);
+
+    if(lfs_handle_is_open(handle)) {
+        file->internal_error_id = lfs_dir_seek(lfs, lfs_handle_get_dir(handle), position);
+    } else {
+        file->internal_error_id = LFS_ERR_BADF;
+    }
+
+    file->error_id = storage_int_parse_error(file->internal_error_id);
+    return (file->error_id == FSE_OK);
+}
+
 /******************* Common FS Functions *******************/
 
 static FS_Error storage_int_common_stat(void* ctx, const char* path, FileInfo* fileinfo) {
@@ -707,6 +739,8 @@ static const FS_Api fs_api = {
             .close = storage_int_dir_close,
             .read = storage_int_dir_read,
             .rewind = storage_int_dir_rewind,
+            .tell = storage_int_dir_tell,
+            .seek = storage_int_dir_seek,
         },
     .common =
         {
@@ -308,6 +308,15 @@ bool furi_hal_hid_kb_release_all() {
     return hid_send_report(ReportIdKeyboard);
 }
 
+bool furi_hal_hid_kb_set_report(uint8_t modifiers, const uint8_t* keys, size_t keys_count) {
+    furi_assert(keys_count <= HID_KB_MAX_KEYS);
+    for(uint8_t key_nb = 0; key_nb < HID_KB_MAX_KEYS; key_nb++) {
+        hid_report.keyboard.boot.btn[key_nb] = (key_nb < keys_count) ? keys[key_nb] : 0;
+    }
+    hid_report.keyboard.boot.mods = modifiers;
+    return hid_send_report(ReportIdKeyboard);
+}
+
 bool furi_hal_hid_mouse_move(int8_t dx, int8_t dy) {
     hid_report.mouse.x = dx;
     hid_report.mouse.y = dy;
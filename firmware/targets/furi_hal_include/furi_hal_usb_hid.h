@@ -222,6 +222,17 @@ bool furi_hal_hid_kb_release(uint16_t button);
  */
 bool furi_hal_hid_kb_release_all();
 
+/** Replace pressed keys and modifiers with given ones and send single HID report
+ *
+ * Keys absent in previous report are registered by host as pressed in the
+ * order they are given.
+ *
+ * @param      modifiers   modifier keys bitmask
+ * @param      keys        key codes
+ * @param      keys_count  number of key codes, up to HID_KB_MAX_KEYS
+ */
+bool furi_hal_hid_kb_set_report(uint8_t modifiers, const uint8_t* keys, size_t keys_count);
+
 /** Set mouse movement and send HID report
  *
  * @param      dx  x coordinate delta
@@ -19,6 +19,15 @@ extern "C" {
 #define FURI_WEAK __attribute__((weak))
 #endif
 
+#ifndef FAP_COLD
+#ifdef FAP_LAZY_LOAD
+/** Place function into FAP section that is loaded on first call, not callable from ISR */
+#define FAP_COLD __attribute__((section(".fapcold"), noinline))
+#else
+#define FAP_COLD
+#endif
+#endif
+
 #ifndef FURI_IS_IRQ_MASKED
 #define FURI_IS_IRQ_MASKED() (__get_PRIMASK() != 0U)
 #endif
@@ -1,6 +1,6 @@
 #include <furi_hal.h>
 #include <furi_hal_usb_hid.h>
-#include "ducky_script_i.h"
+#include "ducky_script_program.h"
 
 typedef struct {
     char* name;
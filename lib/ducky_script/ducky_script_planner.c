@@ -0,0 +1,57 @@
+#include <furi_hal.h>
+#include <furi_hal_usb_hid.h>
+#include "ducky_script_program.h"
+
+uint16_t ducky_string_get_keycode(const uint16_t* layout, char chr) {
+    if(chr == '\n') {
+        return HID_KEYBOARD_RETURN;
+    }
+    return ((uint8_t)chr < 128) ? layout[(uint8_t)chr] : HID_KEYBOARD_NONE;
+}
+
+static bool ducky_hid_report_has_key(const DuckyHidReport* report, uint8_t key) {
+    for(uint8_t key_nb = 0; key_nb < report->keys_nb; key_nb++) {
+        if(report->keys[key_nb] == key) return true;
+    }
+    return false;
+}
+
+/*
+ * Packs following characters into one report: host registers keys that were not
+ * pressed in previous report in the order they are given. Report ends on modifiers
+ * change or on key that is already pressed, as it can't be pressed twice.
+ */
+size_t ducky_string_plan_report(
+    const uint16_t* layout,
+    const char* param,
+    const DuckyHidReport* prev,
+    DuckyHidReport* report) {
+    size_t len = 0;
+    report->mods = 0;
+    report->keys_nb = 0;
+
+    while(param[len] != '\0' && report->keys_nb < HID_KB_MAX_KEYS) {
+        uint16_t keycode = ducky_string_get_keycode(layout, param[len]);
+        uint8_t key = keycode & 0xFF;
+        uint8_t mods = keycode >> 8;
+
+        if(keycode != HID_KEYBOARD_NONE) {
+            if(report->keys_nb == 0) {
+                report->mods = mods;
+            } else if(
+                mods != report->mods || ducky_hid_report_has_key(report, key) ||
+                ducky_hid_report_has_key(prev, key)) {
+                break;
+            }
+            report->keys[report->keys_nb++] = key;
+        }
+        len++;
+    }
+
+    // Only first key of report can be held since previous one
+    report->release =
+        prev->keys_nb > 0 && report->keys_nb > 0 &&
+        (report->mods != prev->mods || ducky_hid_report_has_key(prev, report->keys[0]));
+
+    return len;
+}
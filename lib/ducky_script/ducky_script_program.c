@@ -0,0 +1,299 @@
+#include <furi_hal.h>
+#include <furi_hal_usb_hid.h>
+#include "ducky_script_program.h"
+
+/*
+ * Script compiler and compiled program reader. Nothing here sends HID reports,
+ * so the library is shared by BadUSB app and unit tests.
+ */
+
+uint32_t ducky_get_command_len(const char* line) {
+    uint32_t len = strlen(line);
+    for(uint32_t i = 0; i < len; i++) {
+        if(line[i] == ' ') return i;
+    }
+    return 0;
+}
+
+bool ducky_is_line_end(const char chr) {
+    return ((chr == ' ') || (chr == '\0') || (chr == '\r') || (chr == '\n'));
+}
+
+bool ducky_get_number(const char* param, uint32_t* val) {
+    uint32_t value = 0;
+    if(sscanf(param, "%lu", &value) == 1) {
+        *val = value;
+        return true;
+    }
+    return false;
+}
+
+typedef struct {
+    char* name;
+    DuckyOpcode opcode;
+    int32_t param;
+} DuckyCmd;
+
+static const DuckyCmd ducky_commands[] = {
+    {"REM", DuckyOpRem, -1},
+    {"ID", DuckyOpId, -1},
+    {"DELAY", DuckyOpDelay, -1},
+    {"STRING", DuckyOpString, 0},
+    {"STRINGLN", DuckyOpString, 1},
+    {"DEFAULT_DELAY", DuckyOpDefaultDelay, -1},
+    {"DEFAULTDELAY", DuckyOpDefaultDelay, -1},
+    {"STRINGDELAY", DuckyOpStringDelay, -1},
+    {"STRING_DELAY", DuckyOpStringDelay, -1},
+    {"STRING_BATCH", DuckyOpStringBatch, -1},
+    {"REPEAT", DuckyOpRepeat, -1},
+    {"SYSRQ", DuckyOpSysrq, -1},
+    {"ALTCHAR", DuckyOpAltchar, -1},
+    {"ALTSTRING", DuckyOpAltstring, -1},
+    {"ALTCODE", DuckyOpAltstring, -1},
+    {"HOLD", DuckyOpHold, -1},
+    {"RELEASE", DuckyOpRelease, -1},
+    {"WAIT_FOR_BUTTON_PRESS", DuckyOpWaitForButton, -1},
+};
+
+static void ducky_compile_error(DuckyInstruction* instruction) {
+    instruction->opcode = DuckyOpError;
+    instruction->key = HID_KEYBOARD_NONE;
+    instruction->chr = 0;
+    instruction->value = 0;
+}
+
+// Keys given by name are resolved now, characters depend on layout selected on execution
+static void ducky_compile_key(const char* param, DuckyInstruction* instruction) {
+    uint16_t keycode = ducky_get_keycode_by_name(param);
+    if(keycode != HID_KEYBOARD_NONE) {
+        instruction->key |= keycode;
+    } else if(strlen(param) > 0) {
+        instruction->chr = param[0];
+    }
+}
+
+static void ducky_compile_number(
+    const char* param,
+    DuckyInstruction* instruction,
+    FuriString* text,
+    bool allow_zero) {
+    if(!ducky_get_number(param, &instruction->value) || (!allow_zero && !instruction->value)) {
+        furi_string_printf(text, "Invalid number %s", param);
+        ducky_compile_error(instruction);
+    }
+}
+
+static bool ducky_compile_cmd(const char* line, DuckyInstruction* instruction, FuriString* text) {
+    size_t cmd_word_len = strcspn(line, " ");
+    const DuckyCmd* cmd = NULL;
+    for(size_t i = 0; i < COUNT_OF(ducky_commands); i++) {
+        size_t cmd_compare_len = strlen(ducky_commands[i].name);
+
+        if(cmd_compare_len != cmd_word_len) {
+            continue;
+        }
+
+        if(strncmp(line, ducky_commands[i].name, cmd_compare_len) == 0) {
+            cmd = &ducky_commands[i];
+            break;
+        }
+    }
+
+    if(!cmd) return false;
+
+    const char* param = &line[ducky_get_command_len(line) + 1];
+    instruction->opcode = cmd->opcode;
+
+    switch(cmd->opcode) {
+    case DuckyOpId:
+    case DuckyOpAltchar:
+    case DuckyOpAltstring:
+        furi_string_set_str(text, param);
+        break;
+    case DuckyOpString:
+        furi_string_set_str(text, param);
+        if(cmd->param == 1) {
+            furi_string_push_back(text, '\n');
+        }
+        break;
+    case DuckyOpDelay:
+    case DuckyOpRepeat:
+        ducky_compile_number(param, instruction, text, false);
+        break;
+    case DuckyOpDefaultDelay:
+    case DuckyOpStringDelay:
+    case DuckyOpStringBatch:
+        ducky_compile_number(param, instruction, text, true);
+        break;
+    case DuckyOpSysrq:
+        ducky_compile_key(param, instruction);
+        break;
+    case DuckyOpHold:
+    case DuckyOpRelease:
+        // Keycode can be undefined in selected layout, text is kept for error message
+        ducky_compile_key(param, instruction);
+        furi_string_set_str(text, param);
+        break;
+    default:
+        break;
+    }
+
+    return true;
+}
+
+void ducky_compile_line(const char* line, DuckyInstruction* instruction, FuriString* text) {
+    memset(instruction, 0, sizeof(DuckyInstruction));
+    furi_string_reset(text);
+
+    size_t line_len = strlen(line);
+    if(line_len == 0) {
+        instruction->opcode = DuckyOpNop; // Skip empty lines
+        return;
+    }
+
+    // Ducky Lang Functions
+    if(ducky_compile_cmd(line, instruction, text)) {
+        return;
+    }
+
+    // Special keys + modifiers
+    uint16_t key = ducky_get_keycode_by_name(line);
+    if(key == HID_KEYBOARD_NONE) {
+        furi_string_printf(text, "No keycode defined for %s", line);
+        ducky_compile_error(instruction);
+        return;
+    }
+
+    instruction->opcode = DuckyOpKey;
+    instruction->key = key;
+    if((key & 0xFF00) != 0) {
+        // It's a modifier key
+        uint32_t offset = ducky_get_command_len(line) + 1;
+        // ducky_get_command_len() returns 0 without space, so check for != 1
+        if(offset != 1 && line_len > offset) {
+            // It's also a key combination
+            ducky_compile_key(line + offset, instruction);
+        }
+    }
+}
+
+bool ducky_program_compile(Stream* script, Stream* program, DuckyProgramHeader* header) {
+    FuriString* line = furi_string_alloc();
+    FuriString* text = furi_string_alloc();
+    size_t program_start = stream_tell(program);
+    bool success = false;
+
+    header->magic = 0;
+    header->version = DUCKY_PROGRAM_VERSION;
+    header->line_nb = 0;
+    header->text_size_max = 0;
+
+    do {
+        if(stream_write(program, (uint8_t*)header, sizeof(DuckyProgramHeader)) !=
+           sizeof(DuckyProgramHeader)) {
+            break;
+        }
+
+        bool error = false;
+        while(stream_read_line(script, line)) {
+            furi_string_trim(line, "\n");
+            if(furi_string_empty(line)) continue; // Empty lines are not counted
+            furi_string_trim(line);
+
+            DuckyInstruction instruction;
+            ducky_compile_line(furi_string_get_cstr(line), &instruction, text);
+            instruction.text_size = furi_string_size(text);
+            header->text_size_max = MAX(header->text_size_max, instruction.text_size);
+            header->line_nb++;
+
+            error = stream_write(program, (uint8_t*)&instruction, sizeof(instruction)) !=
+                        sizeof(instruction) ||
+                    stream_write(
+                        program,
+                        (uint8_t*)furi_string_get_cstr(text),
+                        instruction.text_size) != instruction.text_size;
+            if(error) break;
+        }
+
+        if(error) break;
+
+        // Header is written last, so an interrupted compilation leaves an invalid program
+        header->magic = DUCKY_PROGRAM_MAGIC;
+        if(!stream_seek(program, program_start, StreamOffsetFromStart)) break;
+        if(stream_write(program, (uint8_t*)header, sizeof(DuckyProgramHeader)) !=
+           sizeof(DuckyProgramHeader)) {
+            break;
+        }
+
+        success = true;
+    } while(false);
+
+    furi_string_free(text);
+    furi_string_free(line);
+    return success;
+}
+
+DuckyProgram* ducky_program_alloc(Stream* stream, const DuckyProgramHeader* header) {
+    DuckyProgram* program = malloc(sizeof(DuckyProgram));
+    program->stream = stream;
+    program->start = sizeof(DuckyProgramHeader);
+    program->line_nb = header->line_nb;
+    program->text = malloc(header->text_size_max + 1);
+    ducky_program_rewind(program);
+    return program;
+}
+
+void ducky_program_free(DuckyProgram* program) {
+    stream_free(program->stream);
+    free(program->text);
+    free(program);
+}
+
+void ducky_program_rewind(DuckyProgram* program) {
+    program->pc = program->start;
+    program->cur = 0;
+    program->prev = 0;
+}
+
+static bool ducky_program_fetch(
+    DuckyProgram* program,
+    uint32_t offset,
+    DuckyInstruction* instruction,
+    uint32_t* next) {
+    if(stream_tell(program->stream) != offset &&
+       !stream_seek(program->stream, offset, StreamOffsetFromStart)) {
+        return false;
+    }
+
+    if(stream_read(program->stream, (uint8_t*)instruction, sizeof(DuckyInstruction)) !=
+           sizeof(DuckyInstruction) ||
+       stream_read(program->stream, (uint8_t*)program->text, instruction->text_size) !=
+           instruction->text_size) {
+        return false;
+    }
+
+    program->text[instruction->text_size] = '\0';
+    *next = offset + sizeof(DuckyInstruction) + instruction->text_size;
+    return true;
+}
+
+bool ducky_program_next(DuckyProgram* program, DuckyInstruction* instruction) {
+    uint32_t next;
+    if(!ducky_program_fetch(program, program->pc, instruction, &next)) {
+        return false;
+    }
+
+    program->prev = program->cur;
+    program->cur = program->pc;
+    program->pc = next;
+    return true;
+}
+
+bool ducky_program_previous(DuckyProgram* program, DuckyInstruction* instruction) {
+    uint32_t next;
+    if(!program->prev) {
+        return false;
+    }
+
+    return ducky_program_fetch(program, program->prev, instruction, &next);
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <furi.h>
+#include <furi_hal_usb_hid.h>
+#include <toolbox/stream/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    DuckyOpNop, // Empty line
+    DuckyOpRem,
+    DuckyOpId,
+    DuckyOpDelay,
+    DuckyOpString,
+    DuckyOpDefaultDelay,
+    DuckyOpStringDelay,
+    DuckyOpStringBatch,
+    DuckyOpRepeat,
+    DuckyOpSysrq,
+    DuckyOpAltchar,
+    DuckyOpAltstring,
+    DuckyOpHold,
+    DuckyOpRelease,
+    DuckyOpWaitForButton,
+    DuckyOpKey, // Special key with modifiers
+    DuckyOpError, // Text is error message, reported when the line is reached
+} DuckyOpcode;
+
+/** Compiled script line, followed by text_size bytes of text */
+typedef struct {
+    uint8_t opcode;
+    uint8_t chr; // Character resolved with keyboard layout on execution, 0 if none
+    uint16_t key; // Keycode resolved by name
+    uint32_t value;
+    uint32_t text_size;
+} DuckyInstruction;
+
+/** Keys typed at once by single HID report */
+typedef struct {
+    uint8_t mods;
+    uint8_t keys_nb;
+    uint8_t keys[HID_KB_MAX_KEYS];
+    bool release; // Keys of previous report must be released first
+} DuckyHidReport;
+
+#define DUCKY_PROGRAM_MAGIC (0x43445542U)
+#define DUCKY_PROGRAM_VERSION (3U)
+
+/** Compiled script starts with header, then one instruction per script line */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t script_size;
+    uint32_t script_crc;
+    uint32_t line_nb;
+    uint32_t text_size_max;
+} DuckyProgramHeader;
+
+typedef struct {
+    Stream* stream;
+    uint32_t start;
+    uint32_t pc; // Next instruction
+    uint32_t cur; // Last fetched instruction
+    uint32_t prev; // Instruction fetched before the last one, 0 if none
+    uint32_t line_nb;
+    char* text; // Text of last fetched instruction
+} DuckyProgram;
+
+uint32_t ducky_get_command_len(const char* line);
+
+bool ducky_is_line_end(const char chr);
+
+uint16_t ducky_get_keycode_by_name(const char* param);
+
+bool ducky_get_number(const char* param, uint32_t* val);
+
+/** Get keycode of character, newline is typed as Enter
+ *
+ * @param      layout  keyboard layout, keycodes of 128 ASCII characters
+ * @param      chr     character
+ *
+ * @return     keycode with modifiers, HID_KEYBOARD_NONE if there is none
+ */
+uint16_t ducky_string_get_keycode(const uint16_t* layout, char chr);
+
+/** Plan next report of batched STRING
+ *
+ * @param      layout  keyboard layout, keycodes of 128 ASCII characters
+ * @param      param   text to type
+ * @param      prev    previous report, its keys are still pressed
+ * @param      report  planned report
+ *
+ * @return     number of characters consumed, characters without keycode are skipped
+ */
+size_t ducky_string_plan_report(
+    const uint16_t* layout,
+    const char* param,
+    const DuckyHidReport* prev,
+    DuckyHidReport* report);
+
+void ducky_compile_line(const char* line, DuckyInstruction* instruction, FuriString* text);
+
+/** Compile script lines to program stream, header is written last
+ *
+ * @param      script   script stream, read from current position
+ * @param      program  program stream, written from current position
+ * @param      header   script size and CRC are taken from it, on success
+ *                      it is filled with program info
+ *
+ * @return     true on success
+ */
+bool ducky_program_compile(Stream* script, Stream* program, DuckyProgramHeader* header);
+
+/** Allocate program over compiled stream, stream is freed with program */
+DuckyProgram* ducky_program_alloc(Stream* stream, const DuckyProgramHeader* header);
+
+void ducky_program_free(DuckyProgram* program);
+
+void ducky_program_rewind(DuckyProgram* program);
+
+/** Fetch next instruction, its text is put to program->text */
+bool ducky_program_next(DuckyProgram* program, DuckyInstruction* instruction);
+
+/** Fetch again instruction fetched before the last one, for REPEAT */
+bool ducky_program_previous(DuckyProgram* program, DuckyInstruction* instruction);
+
+#ifdef __cplusplus
+}
+#endif
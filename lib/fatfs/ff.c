@@ -4293,6 +4293,28 @@ FRESULT f_readdir (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Move Directory Read Pointer (offset is taken from f_telldir)          */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_seekdir (
+	DIR* dp,			/* Pointer to the open directory object */
+	DWORD ofs			/* Offset of directory table */
+)
+{
+	FRESULT res;
+	FATFS *fs;
+
+
+	res = validate(&dp->obj, &fs);	/* Check validity of the directory object */
+	if (res == FR_OK) {
+		res = dir_sdi(dp, ofs);		/* Move to the entry */
+	}
+	LEAVE_FF(fs, res);
+}
+
+
+
 #if _USE_FIND
 /*-----------------------------------------------------------------------*/
 /* Find Next File                                                        */
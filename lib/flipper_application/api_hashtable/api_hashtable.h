@@ -28,6 +28,18 @@ bool elf_resolve_from_hashtable(
     uint32_t hash,
     Elf32_Addr* address);
 
+/**
+ * @brief Resolver for API entries using a minimal perfect hash table
+ * @param interface pointer to PerfectHashApiInterface
+ * @param hash gnu hash of function name
+ * @param address output for function address
+ * @return true if the table contains a function
+ */
+bool elf_resolve_from_perfect_hash(
+    const ElfApiInterface* interface,
+    uint32_t hash,
+    Elf32_Addr* address);
+
 uint32_t elf_symbolname_hash(const char* s);
 
 #ifdef __cplusplus
@@ -45,6 +57,18 @@ struct HashtableApiInterface : public ElfApiInterface {
     const sym_entry *table_cbegin, *table_cend;
 };
 
+/**
+ * @brief  PerfectHashApiInterface is an implementation of ElfApiInterface
+ * that resolves function addresses with a single probe of a minimal perfect hash table.
+ * table and displacements must be taken from a PerfectHashTable
+ */
+struct PerfectHashApiInterface : public ElfApiInterface {
+    const sym_entry* table;
+    std::size_t table_size;
+    const uint16_t* displacements;
+    std::size_t displacements_size;
+};
+
 #define API_METHOD(x, ret_type, args_type)                                                     \
     sym_entry {                                                                                \
         .hash = elf_gnu_hash(#x), .address = (uint32_t)(static_cast<ret_type(*) args_type>(x)) \
@@ -86,4 +110,120 @@ constexpr bool has_hash_collisions(const std::array<sym_entry, N>& api_methods)
     return false;
 }
 
+/**
+ * @brief Mix symbol hash with a seed, used for perfect hash bucket and slot selection
+ * @param hash gnu hash of function name
+ * @param seed bucket displacement, 0 for bucket selection
+ * @return mixed hash value
+ */
+constexpr uint32_t elf_perfect_hash_mix(uint32_t hash, uint32_t seed) {
+    uint32_t h = hash ^ (seed * 0x9E3779B9U);
+    h ^= h >> 16;
+    h *= 0x85EBCA6BU;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35U;
+    h ^= h >> 16;
+    return h;
+}
+
+/* Average number of symbols per perfect hash bucket */
+constexpr std::size_t elf_perfect_hash_bucket_load = 2;
+
+/* Upper limit of symbols per bucket and of displacement search */
+constexpr std::size_t elf_perfect_hash_bucket_max = 16;
+constexpr uint16_t elf_perfect_hash_displacement_max = 0xFFFF;
+
+/**
+ * @brief Minimal perfect hash table of API symbols
+ * Symbol with hash h is stored in slot
+ * mix(h, displacements[mix(h, 0) % B]) % N
+ */
+template <std::size_t N>
+struct PerfectHashTable {
+    static constexpr std::size_t bucket_count =
+        (N + elf_perfect_hash_bucket_load - 1) / elf_perfect_hash_bucket_load;
+
+    std::array<sym_entry, N> entries;
+    std::array<uint16_t, bucket_count> displacements;
+    bool valid;
+};
+
+/**
+ * @brief Build minimal perfect hash table at compile time using hash and displace method.
+ * Buckets are placed from the largest one, each bucket gets the first displacement
+ * that maps all its symbols to free slots.
+ * Usage: static_assert(table.valid, "Can't build perfect hash table");
+ * @param symbols API table without hash collisions
+ * @return PerfectHashTable
+ */
+template <std::size_t N>
+constexpr PerfectHashTable<N> make_perfect_hash_table(const std::array<sym_entry, N>& symbols) {
+    constexpr std::size_t bucket_count = PerfectHashTable<N>::bucket_count;
+
+    PerfectHashTable<N> result{};
+    std::array<std::size_t, N> bucket_of{};
+    std::array<std::size_t, bucket_count + 1> bucket_start{};
+    std::array<std::size_t, N> members{};
+    std::array<bool, N> used{};
+
+    // Group symbols by bucket
+    for(std::size_t i = 0; i < N; ++i) {
+        bucket_of[i] = elf_perfect_hash_mix(symbols[i].hash, 0) % bucket_count;
+        ++bucket_start[bucket_of[i] + 1];
+    }
+
+    std::size_t bucket_size_max = 0;
+    for(std::size_t b = 0; b < bucket_count; ++b) {
+        if(bucket_start[b + 1] > bucket_size_max) bucket_size_max = bucket_start[b + 1];
+        bucket_start[b + 1] += bucket_start[b];
+    }
+
+    if(bucket_size_max > elf_perfect_hash_bucket_max) {
+        result.valid = false;
+        return result;
+    }
+
+    std::array<std::size_t, bucket_count> bucket_fill{};
+    for(std::size_t i = 0; i < N; ++i) {
+        members[bucket_start[bucket_of[i]] + bucket_fill[bucket_of[i]]++] = i;
+    }
+
+    // Place buckets, largest first
+    for(std::size_t size = bucket_size_max; size > 0; --size) {
+        for(std::size_t b = 0; b < bucket_count; ++b) {
+            if(bucket_start[b + 1] - bucket_start[b] != size) continue;
+
+            std::array<std::size_t, elf_perfect_hash_bucket_max> slots{};
+            bool placed = false;
+            for(uint32_t d = 1; d <= elf_perfect_hash_displacement_max && !placed; ++d) {
+                placed = true;
+                for(std::size_t m = 0; m < size && placed; ++m) {
+                    const sym_entry& symbol = symbols[members[bucket_start[b] + m]];
+                    slots[m] = elf_perfect_hash_mix(symbol.hash, d) % N;
+                    if(used[slots[m]]) placed = false;
+                    for(std::size_t k = 0; k < m && placed; ++k) {
+                        if(slots[k] == slots[m]) placed = false;
+                    }
+                }
+
+                if(placed) {
+                    result.displacements[b] = d;
+                    for(std::size_t m = 0; m < size; ++m) {
+                        used[slots[m]] = true;
+                        result.entries[slots[m]] = symbols[members[bucket_start[b] + m]];
+                    }
+                }
+            }
+
+            if(!placed) {
+                result.valid = false;
+                return result;
+            }
+        }
+    }
+
+    result.valid = true;
+    return result;
+}
+
 #endif
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "elf_file_i.h"
 #include "elf_api_interface.h"
 #include "../api_hashtable/api_hashtable.h"
+#include <toolbox/crc32_calc.h>
+#include <furi_hal_rtc.h>
 
 #define TAG "elf"
 
@@ -12,6 +14,13 @@
 #define RESOLVER_THREAD_YIELD_STEP 30
 #define FAST_RELOCATION_VERSION 1
 
+#define RELOCATION_CACHE_PATH CFG_PATH("fap_cache")
+#define RELOCATION_CACHE_MAGIC 0x43524C45
+#define RELOCATION_CACHE_VERSION 2
+#define RELOCATION_CACHE_HEAP_RESERVE (16 * 1024)
+#define RELOCATION_CACHE_OFFSET_MASK 0x00FFFFFF
+#define RELOCATION_CACHE_TYPE_MASK 0x7F
+
 // #define ELF_DEBUG_LOG 1
 
 #ifndef ELF_DEBUG_LOG
@@ -22,6 +31,8 @@
 #define ELF_INVALID_ADDRESS 0xFFFFFFFF
 
 #define TRAMPOLINE_CODE_SIZE 6
+#define LAZY_STUB_CODE_SIZE 8
+#define LAZY_SECTION_PREFIX ".fapcold"
 
 /**
 ldr r12, [pc, #2]
@@ -35,6 +46,50 @@ typedef struct {
     uint32_t addr;
 } __attribute__((packed)) JMPTrampoline;
 
+/**
+mov r12, pc
+ldr.w pc, [pc, #4]
+nop
+*/
+const uint8_t lazy_stub_code_little_endian[LAZY_STUB_CODE_SIZE] =
+    {0xfc, 0x46, 0xdf, 0xf8, 0x04, 0xf0, 0x00, 0xbf};
+
+/* Stub for a function in lazy section, jumps to elf_lazy_stub_handler until
+ * the section is loaded, then target is replaced with function address */
+struct ELFLazyStub {
+    uint8_t code[LAZY_STUB_CODE_SIZE];
+    uint32_t target;
+    ELFFile* elf;
+    uint16_t sec_idx;
+    Elf32_Addr value;
+};
+
+#pragma pack(push, 1)
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint16_t api_version_major;
+    uint16_t api_version_minor;
+    uint32_t file_size;
+    uint32_t file_crc;
+    uint32_t file_timestamp;
+    uint16_t sections_count;
+    uint16_t path_size;
+} ELFRelocationCacheHeader;
+
+typedef struct {
+    uint16_t sec_idx;
+    uint32_t size;
+} ELFRelocationCacheSection;
+
+#pragma pack(pop)
+
+typedef struct {
+    int sym_entry;
+    uint32_t type_offset;
+} ELFRelocationRecord;
+
 /**************************************************************************************************/
 /********************************************* Caches *********************************************/
 /**************************************************************************************************/
@@ -168,17 +223,182 @@ static ELFSection* elf_section_of(ELFFile* elf, int index) {
     return NULL;
 }
 
+/**************************************************************************************************/
+/***************************************** Lazy sections ******************************************/
+/**************************************************************************************************/
+
+static bool elf_relocate_section(ELFFile* elf, ELFSection* section);
+
+uint32_t elf_lazy_stub_resolve(ELFLazyStub* stub);
+
+/* Preserves argument registers, loads section of the stub and jumps to its target */
+__attribute__((naked)) static void elf_lazy_stub_handler(void) {
+    asm volatile("push {r0, r1, r2, r3, r12, lr}\n"
+                 "vpush {s0-s15}\n"
+                 "sub r0, r12, #4\n"
+                 "bl elf_lazy_stub_resolve\n"
+                 "mov r12, r0\n"
+                 "vpop {s0-s15}\n"
+                 "pop {r0, r1, r2, r3}\n"
+                 "ldr lr, [sp, #4]\n"
+                 "add sp, sp, #8\n"
+                 "bx r12\n");
+}
+
+static bool elf_lazy_load_section(ELFFile* elf, ELFSection* section) {
+    furi_assert(section->lazy && !section->data);
+    bool result = false;
+
+    // Section can be loaded in the middle of relocation of another section
+    off_t old = storage_file_tell(elf->fd);
+    bool relocating = elf->relocating;
+    if(!relocating) {
+        AddressCache_init(elf->relocation_cache);
+        elf->relocating = true;
+    }
+
+    section->data = aligned_malloc(section->size, section->data_align);
+    if(storage_file_seek(elf->fd, section->data_offset, true) &&
+       storage_file_read(elf->fd, section->data, section->size) == section->size) {
+        result = elf_relocate_section(elf, section);
+    }
+
+    if(!relocating) {
+        AddressCache_clear(elf->relocation_cache);
+        elf->relocating = false;
+    }
+    storage_file_seek(elf->fd, old, true);
+
+    if(result) {
+        ELFLazyStubDict_it_t it;
+        for(ELFLazyStubDict_it(it, elf->lazy_stubs); !ELFLazyStubDict_end_p(it);
+            ELFLazyStubDict_next(it)) {
+            ELFLazyStub* stub = ELFLazyStubDict_cref(it)->value;
+            if(stub->sec_idx == section->sec_idx) {
+                stub->target = (uint32_t)section->data + stub->value;
+            }
+        }
+
+        elf->stats.sections_loaded++;
+        elf->stats.sections_size += section->size;
+        elf->stats.lazy_sections_loaded++;
+        FURI_LOG_I(
+            TAG,
+            "Lazy section loaded, resident %lu of %lu bytes",
+            elf->stats.sections_size,
+            elf->stats.sections_total_size);
+    } else {
+        FURI_LOG_E(TAG, "Error loading lazy section #%d", section->sec_idx);
+    }
+
+    return result;
+}
+
+/* Imports of lazy sections are checked on app load, so only storage errors are left here.
+ * Caller can't be resumed without its function, so they are fatal. */
+uint32_t elf_lazy_stub_resolve(ELFLazyStub* stub) {
+    ELFFile* elf = stub->elf;
+
+    if(FURI_IS_ISR()) {
+        // Section is loaded from storage, which is not possible in interrupt
+        furi_crash("FAP cold code called from ISR");
+    }
+
+    furi_check(furi_mutex_acquire(elf->lazy_mutex, FuriWaitForever) == FuriStatusOk);
+    ELFSection* section = elf_section_of(elf, stub->sec_idx);
+    furi_check(section);
+    if(!section->data && !elf_lazy_load_section(elf, section)) {
+        furi_crash("FAP cold code load failed");
+    }
+    furi_check(stub->target != (uint32_t)elf_lazy_stub_handler);
+    furi_check(furi_mutex_release(elf->lazy_mutex) == FuriStatusOk);
+
+    return stub->target;
+}
+
+static Elf32_Addr elf_lazy_stub_get(ELFFile* elf, ELFSection* section, Elf32_Addr value) {
+    uint64_t key = ((uint64_t)section->sec_idx << 32) | value;
+    ELFLazyStub** stub_p = ELFLazyStubDict_get(elf->lazy_stubs, key);
+    if(stub_p) {
+        return (Elf32_Addr)*stub_p | 1;
+    }
+
+    ELFLazyStub* stub = malloc(sizeof(ELFLazyStub));
+    memcpy(stub->code, lazy_stub_code_little_endian, LAZY_STUB_CODE_SIZE);
+    stub->target = (uint32_t)elf_lazy_stub_handler;
+    stub->elf = elf;
+    stub->sec_idx = section->sec_idx;
+    stub->value = value;
+    ELFLazyStubDict_set_at(elf->lazy_stubs, key, stub);
+    elf->stats.lazy_stubs++;
+
+    return (Elf32_Addr)stub | 1;
+}
+
+/* Offset encoded in Thumb BL/B.W instruction, relocation addend for REL relocations */
+static int elf_jmp_call_offset(Elf32_Addr relAddr) {
+    int offset, hi, lo, s, j1, j2, i1, i2, imm10, imm11;
+
+    hi = ((uint16_t*)relAddr)[0];
+    lo = ((uint16_t*)relAddr)[1];
+    s = (hi >> 10) & 1;
+    j1 = (lo >> 13) & 1;
+    j2 = (lo >> 11) & 1;
+    i1 = (j1 ^ s) ^ 1;
+    i2 = (j2 ^ s) ^ 1;
+    imm10 = hi & 0x3ff;
+    imm11 = lo & 0x7ff;
+    offset = (s << 24) | (i1 << 23) | (i2 << 22) | (imm10 << 12) | (imm11 << 1);
+    if(offset & 0x01000000) offset -= 0x02000000;
+
+    return offset;
+}
+
+/* Static function can be called through its section symbol, function offset is in the
+ * instruction then. Such calls are routed through stubs as well. */
+static bool elf_is_lazy_branch(ELFSection* section, Elf32_Addr value, int type) {
+    return section->lazy && !section->data && !(value & 1) &&
+           (type == R_ARM_THM_PC22 || type == R_ARM_THM_JUMP24);
+}
+
+static Elf32_Addr elf_lazy_branch_address(
+    ELFFile* elf,
+    ELFSection* section,
+    Elf32_Addr value,
+    Elf32_Addr relAddr) {
+    // Addend includes PC offset of 4, branch target is always Thumb code
+    int addend = elf_jmp_call_offset(relAddr) + 4;
+    Elf32_Addr stub = elf_lazy_stub_get(elf, section, (value + addend) | 1);
+
+    // Relocation adds the addend back, so the branch lands on the stub
+    return stub - addend;
+}
+
+static Elf32_Addr elf_section_address(ELFFile* elf, ELFSection* section, Elf32_Addr value) {
+    if(section->lazy && !section->data) {
+        // Thumb function can be called through stub, anything else needs section in memory
+        if(value & 1) {
+            return elf_lazy_stub_get(elf, section, value);
+        } else if(!elf_lazy_load_section(elf, section)) {
+            return ELF_INVALID_ADDRESS;
+        }
+    }
+
+    return ((Elf32_Addr)section->data) + value;
+}
+
 static Elf32_Addr elf_address_of(ELFFile* elf, Elf32_Sym* sym, const char* sName) {
     if(sym->st_shndx == SHN_UNDEF) {
         Elf32_Addr addr = 0;
         uint32_t hash = elf_symbolname_hash(sName);
+        elf->stats.resolver_calls++;
         if(elf->api_interface->resolver_callback(elf->api_interface, hash, &addr)) {
             return addr;
         }
     } else {
         ELFSection* symSec = elf_section_of(elf, sym->st_shndx);
         if(symSec) {
-            return ((Elf32_Addr)symSec->data) + sym->st_value;
+            return elf_section_address(elf, symSec, sym->st_value);
         }
     }
     FURI_LOG_D(TAG, "  Can not find address for symbol %s", sName);
@@ -215,15 +435,7 @@ static void elf_relocate_jmp_call(ELFFile* elf, Elf32_Addr relAddr, int type, El
     /* Get initial offset */
     hi = ((uint16_t*)relAddr)[0];
     lo = ((uint16_t*)relAddr)[1];
-    s = (hi >> 10) & 1;
-    j1 = (lo >> 13) & 1;
-    j2 = (lo >> 11) & 1;
-    i1 = (j1 ^ s) ^ 1;
-    i2 = (j2 ^ s) ^ 1;
-    imm10 = hi & 0x3ff;
-    imm11 = lo & 0x7ff;
-    offset = (s << 24) | (i1 << 23) | (i2 << 22) | (imm10 << 12) | (imm11 << 1);
-    if(offset & 0x01000000) offset -= 0x02000000;
+    offset = elf_jmp_call_offset(relAddr);
 
     to_thumb = symAddr & 1;
     is_call = (type == R_ARM_THM_PC22);
@@ -255,6 +467,7 @@ static void elf_relocate_jmp_call(ELFFile* elf, Elf32_Addr relAddr, int type, El
             if(!address_cache_get(elf->trampoline_cache, symAddr, &addr)) {
                 addr = (Elf32_Addr)elf_create_trampoline(symAddr);
                 address_cache_put(elf->trampoline_cache, symAddr, addr);
+                elf->stats.trampolines++;
             }
 
             offset = offset_copy;
@@ -342,6 +555,410 @@ static bool elf_relocate_symbol(ELFFile* elf, Elf32_Addr relAddr, int type, Elf3
     return true;
 }
 
+/**************************************************************************************************/
+/**************************************** Relocation cache ****************************************/
+/**************************************************************************************************/
+
+/*
+ * Relocation cache keeps fast relocation data built from regular relocations of a FAP.
+ * Data is bound to FAP path, size and CRC and to firmware API version, so it can be applied
+ * with elf_relocate_fast on next launch without reading symbols and their names.
+ *
+ * Cache is stamped with storage timestamp while FAP is open and can not be written. If storage
+ * was not written since then, FAP is the same and its CRC is not calculated again.
+ */
+
+static bool elf_relocation_cache_is_valid(const ELFRelocationCacheHeader* header) {
+    return header->magic == RELOCATION_CACHE_MAGIC && header->version == RELOCATION_CACHE_VERSION;
+}
+
+static bool elf_relocation_cache_read_path(
+    File* file,
+    const ELFRelocationCacheHeader* header,
+    FuriString* path) {
+    char* buffer = malloc(header->path_size + 1);
+    bool result = storage_file_read(file, buffer, header->path_size) == header->path_size;
+    buffer[header->path_size] = '\0';
+    furi_string_set(path, buffer);
+    free(buffer);
+    return result;
+}
+
+static bool elf_relocation_cache_stamp(ELFFile* elf, uint32_t timestamp) {
+    File* file = storage_file_alloc(elf->storage);
+    bool result =
+        storage_file_open(
+            file,
+            furi_string_get_cstr(elf->relocation_cache_path),
+            FSAM_WRITE,
+            FSOM_OPEN_EXISTING) &&
+        storage_file_seek(file, offsetof(ELFRelocationCacheHeader, file_timestamp), true) &&
+        storage_file_write(file, &timestamp, sizeof(timestamp)) == sizeof(timestamp);
+    storage_file_free(file);
+
+    elf->relocation_cache_timestamp = result ? timestamp : 0;
+    return result;
+}
+
+static void elf_relocation_cache_unstamp(ELFFile* elf) {
+    // FAP can be written right after it is closed, within the second cache was stamped in
+    if(elf->relocation_cache_timestamp &&
+       furi_hal_rtc_get_timestamp() <= elf->relocation_cache_timestamp &&
+       !elf_relocation_cache_stamp(elf, 0)) {
+        storage_common_remove(elf->storage, furi_string_get_cstr(elf->relocation_cache_path));
+    }
+}
+
+static bool elf_relocation_cache_is_stale(ELFFile* elf, const char* path) {
+    File* file = storage_file_alloc(elf->storage);
+    ELFRelocationCacheHeader header;
+    bool stale = true;
+
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+       storage_file_read(file, &header, sizeof(header)) == sizeof(header) &&
+       elf_relocation_cache_is_valid(&header)) {
+        FuriString* source = furi_string_alloc();
+        stale = !elf_relocation_cache_read_path(file, &header, source) ||
+                !storage_file_exists(elf->storage, furi_string_get_cstr(source));
+        furi_string_free(source);
+    }
+    storage_file_free(file);
+
+    return stale;
+}
+
+/*
+ * Removes caches of other FAPs that were removed or have an unknown format. Caches built for
+ * another API version are kept: plugins are loaded with API versions of their host apps.
+ */
+static void elf_relocation_cache_prune(ELFFile* elf) {
+    File* dir = storage_file_alloc(elf->storage);
+    FuriString* path = furi_string_alloc();
+    char name[ELF_NAME_BUFFER_LEN];
+    FileInfo fileinfo;
+    bool found;
+
+    do {
+        found = false;
+        if(!storage_dir_open(dir, RELOCATION_CACHE_PATH)) break;
+
+        while(storage_dir_read(dir, &fileinfo, name, sizeof(name))) {
+            furi_string_printf(path, RELOCATION_CACHE_PATH "/%s", name);
+            if(file_info_is_dir(&fileinfo) || !furi_string_end_with_str(path, ".rel") ||
+               furi_string_equal(path, elf->relocation_cache_path)) {
+                continue;
+            }
+
+            if(elf_relocation_cache_is_stale(elf, furi_string_get_cstr(path))) {
+                found = true;
+                break;
+            }
+        }
+
+        // Directory is read again after each removal
+        storage_dir_close(dir);
+    } while(found && storage_common_remove(elf->storage, furi_string_get_cstr(path)) == FSE_OK);
+
+    furi_string_free(path);
+    storage_file_free(dir);
+}
+
+static void elf_relocation_cache_abort(ELFFile* elf) {
+    if(elf->relocation_cache_fd) {
+        storage_file_free(elf->relocation_cache_fd);
+        elf->relocation_cache_fd = NULL;
+        storage_common_remove(elf->storage, furi_string_get_cstr(elf->relocation_cache_path));
+    }
+}
+
+static void elf_relocation_cache_begin(ELFFile* elf) {
+    furi_assert(elf->relocation_cache_fd == NULL);
+    const char* path = furi_string_get_cstr(elf->relocation_cache_path);
+    ELFRelocationCacheHeader header = {0};
+    const char* source = furi_string_get_cstr(elf->file_path);
+    const size_t source_size = furi_string_size(elf->file_path);
+
+    File* file = storage_file_alloc(elf->storage);
+    if(storage_simply_mkdir(elf->storage, RELOCATION_CACHE_PATH) &&
+       storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+       storage_file_write(file, &header, sizeof(header)) == sizeof(header) &&
+       storage_file_write(file, source, source_size) == source_size) {
+        elf->relocation_cache_fd = file;
+        elf->relocation_cache_sections = 0;
+        ELFRelocationSymbolDict_reset(elf->relocation_symbols);
+    } else {
+        FURI_LOG_W(TAG, "Can not create relocation cache");
+        storage_file_free(file);
+        storage_common_remove(elf->storage, path);
+    }
+}
+
+static void elf_relocation_cache_end(ELFFile* elf) {
+    File* file = elf->relocation_cache_fd;
+    if(!file) return;
+
+    ELFRelocationCacheHeader header = {
+        .magic = RELOCATION_CACHE_MAGIC,
+        .version = RELOCATION_CACHE_VERSION,
+        .api_version_major = elf->api_interface->api_version_major,
+        .api_version_minor = elf->api_interface->api_version_minor,
+        .file_size = storage_file_size(elf->fd),
+        .file_crc = crc32_calc_file(elf->fd, NULL, NULL),
+        .file_timestamp = furi_hal_rtc_get_timestamp(),
+        .sections_count = elf->relocation_cache_sections,
+        .path_size = furi_string_size(elf->file_path),
+    };
+
+    if(storage_file_seek(file, 0, true) &&
+       storage_file_write(file, &header, sizeof(header)) == sizeof(header)) {
+        storage_file_free(file);
+        elf->relocation_cache_fd = NULL;
+        elf->relocation_cache_timestamp = header.file_timestamp;
+        FURI_LOG_I(TAG, "Relocation cache saved");
+    } else {
+        FURI_LOG_W(TAG, "Can not save relocation cache");
+        elf_relocation_cache_abort(elf);
+    }
+}
+
+static void elf_relocation_cache_put_symbol(
+    ELFFile* elf,
+    int symEntry,
+    Elf32_Sym* sym,
+    const char* sName) {
+    ELFRelocationSymbol symbol = {0};
+    if(sym->st_shndx == SHN_UNDEF) {
+        symbol.hash_or_section_index = elf_symbolname_hash(sName);
+    } else {
+        symbol.is_section = true;
+        symbol.hash_or_section_index = sym->st_shndx;
+        symbol.section_value = sym->st_value;
+    }
+    ELFRelocationSymbolDict_set_at(elf->relocation_symbols, symEntry, symbol);
+}
+
+static int elf_relocation_record_cmp(const void* a, const void* b) {
+    const ELFRelocationRecord* record_a = a;
+    const ELFRelocationRecord* record_b = b;
+
+    if(record_a->sym_entry != record_b->sym_entry) {
+        return record_a->sym_entry < record_b->sym_entry ? -1 : 1;
+    }
+
+    // type is in the upper byte, so records are grouped by type and sorted by offset
+    if(record_a->type_offset != record_b->type_offset) {
+        return record_a->type_offset < record_b->type_offset ? -1 : 1;
+    }
+
+    return 0;
+}
+
+static bool elf_relocation_record_starts_group(const ELFRelocationRecord* records, size_t index) {
+    return index == 0 || records[index].sym_entry != records[index - 1].sym_entry ||
+           (records[index].type_offset >> 24) != (records[index - 1].type_offset >> 24);
+}
+
+static void elf_relocation_cache_put_section(
+    ELFFile* elf,
+    ELFSection* s,
+    ELFRelocationRecord* records,
+    size_t count) {
+    qsort(records, count, sizeof(ELFRelocationRecord), elf_relocation_record_cmp);
+
+    // Fast relocation data: version, records count, records of grouped 24-bit offsets
+    size_t size = sizeof(uint8_t) + sizeof(uint32_t);
+    for(size_t i = 0; i < count; i++) {
+        if(elf_relocation_record_starts_group(records, i)) {
+            ELFRelocationSymbol* symbol =
+                ELFRelocationSymbolDict_get(elf->relocation_symbols, records[i].sym_entry);
+            furi_check(symbol);
+            size += sizeof(uint8_t) + sizeof(uint32_t) * (symbol->is_section ? 3 : 2);
+        }
+        size += 3;
+    }
+
+    if(memmgr_heap_get_max_free_block() < size + RELOCATION_CACHE_HEAP_RESERVE) {
+        FURI_LOG_W(TAG, "Not enough memory for relocation cache");
+        elf_relocation_cache_abort(elf);
+        return;
+    }
+
+    uint8_t* data = malloc(size);
+    uint8_t* ptr = data;
+    uint32_t records_count = 0;
+    uint32_t offsets_count = 0;
+    uint8_t* offsets_count_ptr = NULL;
+
+    *ptr = FAST_RELOCATION_VERSION;
+    ptr += 1 + sizeof(uint32_t);
+
+    for(size_t i = 0; i < count; i++) {
+        if(elf_relocation_record_starts_group(records, i)) {
+            if(offsets_count_ptr) {
+                memcpy(offsets_count_ptr, &offsets_count, sizeof(uint32_t));
+            }
+
+            ELFRelocationSymbol* symbol =
+                ELFRelocationSymbolDict_get(elf->relocation_symbols, records[i].sym_entry);
+            *ptr = (records[i].type_offset >> 24) | (symbol->is_section ? (0x1 << 7) : 0);
+            ptr += 1;
+            memcpy(ptr, &symbol->hash_or_section_index, sizeof(uint32_t));
+            ptr += sizeof(uint32_t);
+            if(symbol->is_section) {
+                memcpy(ptr, &symbol->section_value, sizeof(uint32_t));
+                ptr += sizeof(uint32_t);
+            }
+
+            offsets_count_ptr = ptr;
+            ptr += sizeof(uint32_t);
+            offsets_count = 0;
+            records_count++;
+        }
+
+        uint32_t offset = records[i].type_offset & RELOCATION_CACHE_OFFSET_MASK;
+        memcpy(ptr, &offset, 3);
+        ptr += 3;
+        offsets_count++;
+    }
+
+    if(offsets_count_ptr) {
+        memcpy(offsets_count_ptr, &offsets_count, sizeof(uint32_t));
+    }
+    memcpy(data + 1, &records_count, sizeof(uint32_t));
+    furi_assert(ptr == data + size);
+
+    ELFRelocationCacheSection cache_section = {
+        .sec_idx = s->sec_idx,
+        .size = size,
+    };
+
+    File* file = elf->relocation_cache_fd;
+    if(storage_file_write(file, &cache_section, sizeof(cache_section)) == sizeof(cache_section) &&
+       storage_file_write(file, data, size) == size) {
+        elf->relocation_cache_sections++;
+    } else {
+        FURI_LOG_W(TAG, "Can not write relocation cache");
+        elf_relocation_cache_abort(elf);
+    }
+
+    free(data);
+}
+
+static bool elf_relocation_cache_load(ELFFile* elf, uint16_t sections_count) {
+    const char* path = furi_string_get_cstr(elf->relocation_cache_path);
+    File* file = storage_file_alloc(elf->storage);
+    ELFSection** attached = malloc(sizeof(ELFSection*) * sections_count);
+    uint16_t attached_count = 0;
+    FuriString* source = furi_string_alloc();
+    uint32_t timestamp = 0;
+    bool stamp = false;
+    bool result = false;
+
+    do {
+        ELFRelocationCacheHeader header;
+        if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        if(!elf_relocation_cache_is_valid(&header) ||
+           header.api_version_major != elf->api_interface->api_version_major ||
+           header.api_version_minor != elf->api_interface->api_version_minor ||
+           header.sections_count != sections_count) {
+            FURI_LOG_I(TAG, "Relocation cache is outdated");
+            break;
+        }
+
+        if(!elf_relocation_cache_read_path(file, &header, source) ||
+           !furi_string_equal(source, elf->file_path) ||
+           header.file_size != storage_file_size(elf->fd)) {
+            FURI_LOG_I(TAG, "Relocation cache belongs to another file");
+            break;
+        }
+
+        storage_common_timestamp(elf->storage, furi_string_get_cstr(elf->file_path), &timestamp);
+        if(!header.file_timestamp || header.file_timestamp != timestamp) {
+            if(header.file_crc != crc32_calc_file(elf->fd, NULL, NULL)) {
+                FURI_LOG_I(TAG, "Relocation cache belongs to another file");
+                break;
+            }
+            stamp = true;
+        }
+
+        const uint64_t cache_size = storage_file_size(file);
+        bool sections_loaded = true;
+        for(uint16_t i = 0; i < sections_count; i++) {
+            ELFRelocationCacheSection cache_section;
+            if(storage_file_read(file, &cache_section, sizeof(cache_section)) !=
+               sizeof(cache_section)) {
+                sections_loaded = false;
+                break;
+            }
+
+            ELFSection* section = elf_section_of(elf, cache_section.sec_idx);
+            if(!section || !section->rel_count || section->fast_rel || section->lazy ||
+               !cache_section.size || cache_section.size > cache_size) {
+                sections_loaded = false;
+                break;
+            }
+
+            section->fast_rel = malloc(sizeof(ELFSection));
+            attached[attached_count++] = section;
+
+            // Extra byte: elf_relocate_fast reads 24-bit offsets as 32-bit words
+            section->fast_rel->data = aligned_malloc(cache_section.size + 1, sizeof(uint32_t));
+            section->fast_rel->size = cache_section.size;
+            if(storage_file_read(file, section->fast_rel->data, cache_section.size) !=
+               cache_section.size) {
+                sections_loaded = false;
+                break;
+            }
+        }
+
+        result = sections_loaded;
+    } while(false);
+
+    if(!result) {
+        for(uint16_t i = 0; i < attached_count; i++) {
+            aligned_free(attached[i]->fast_rel->data);
+            free(attached[i]->fast_rel);
+            attached[i]->fast_rel = NULL;
+        }
+    }
+
+    free(attached);
+    furi_string_free(source);
+    storage_file_free(file);
+
+    if(result && stamp) {
+        elf_relocation_cache_stamp(elf, furi_hal_rtc_get_timestamp());
+    }
+
+    return result;
+}
+
+static void elf_relocation_cache_prepare(ELFFile* elf) {
+    if(!elf->relocation_cache_path) return;
+
+    uint16_t sections_count = 0;
+    ELFSectionDict_it_t it;
+    for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
+        const ELFSectionDict_itref_t* itref = ELFSectionDict_cref(it);
+        if(itref->value.rel_count && !itref->value.fast_rel && !itref->value.lazy) {
+            sections_count++;
+        }
+    }
+
+    // FAP already has fast relocation data for all sections
+    if(sections_count == 0) return;
+
+    if(elf_relocation_cache_load(elf, sections_count)) {
+        FURI_LOG_I(TAG, "Using relocation cache");
+        elf->stats.relocation_cache_used = true;
+    } else {
+        elf_relocation_cache_prune(elf);
+        elf_relocation_cache_begin(elf);
+    }
+}
+
 static bool elf_relocate(ELFFile* elf, ELFSection* s) {
     if(s->data) {
         Elf32_Rel rel;
@@ -354,6 +971,17 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
         FuriString* symbol_name;
         symbol_name = furi_string_alloc();
 
+        ELFRelocationRecord* records = NULL;
+        if(elf->relocation_cache_fd && !s->lazy) {
+            size_t records_size = relEntries * sizeof(ELFRelocationRecord);
+            if(memmgr_heap_get_max_free_block() >= records_size + RELOCATION_CACHE_HEAP_RESERVE) {
+                records = malloc(records_size);
+            } else {
+                FURI_LOG_W(TAG, "Not enough memory for relocation cache");
+                elf_relocation_cache_abort(elf);
+            }
+        }
+
         for(relCount = 0; relCount < relEntries; relCount++) {
             if(relCount % RESOLVER_THREAD_YIELD_STEP == 0) {
                 FURI_LOG_D(TAG, "  reloc YIELD");
@@ -363,6 +991,7 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
             if(storage_file_read(elf->fd, &rel, sizeof(Elf32_Rel)) != sizeof(Elf32_Rel)) {
                 FURI_LOG_E(TAG, "  reloc read fail");
                 furi_string_free(symbol_name);
+                free(records);
                 return false;
             }
 
@@ -371,13 +1000,18 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
             int symEntry = ELF32_R_SYM(rel.r_info);
             int relType = ELF32_R_TYPE(rel.r_info);
             Elf32_Addr relAddr = ((Elf32_Addr)s->data) + rel.r_offset;
+            elf->stats.relocations++;
 
-            if(!address_cache_get(elf->relocation_cache, symEntry, &symAddr)) {
+            if(address_cache_get(elf->relocation_cache, symEntry, &symAddr)) {
+                elf->stats.symbol_cache_hits++;
+            } else {
                 Elf32_Sym sym;
+                elf->stats.symbol_reads++;
                 furi_string_reset(symbol_name);
                 if(!elf_read_symbol(elf, symEntry, &sym, symbol_name)) {
                     FURI_LOG_E(TAG, "  symbol read fail");
                     furi_string_free(symbol_name);
+                    free(records);
                     return false;
                 }
 
@@ -389,8 +1023,33 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
                     elf_reloc_type_to_str(relType),
                     furi_string_get_cstr(symbol_name));
 
-                symAddr = elf_address_of(elf, &sym, furi_string_get_cstr(symbol_name));
-                address_cache_put(elf->relocation_cache, symEntry, symAddr);
+                ELFSection* symSec =
+                    sym.st_shndx != SHN_UNDEF ? elf_section_of(elf, sym.st_shndx) : NULL;
+                if(symSec && elf_is_lazy_branch(symSec, sym.st_value, relType)) {
+                    // Stub depends on the offset in instruction, so address is not cached
+                    symAddr = elf_lazy_branch_address(elf, symSec, sym.st_value, relAddr);
+                } else {
+                    symAddr = elf_address_of(elf, &sym, furi_string_get_cstr(symbol_name));
+                    address_cache_put(elf->relocation_cache, symEntry, symAddr);
+                }
+
+                if(elf->relocation_cache_fd) {
+                    elf_relocation_cache_put_symbol(
+                        elf, symEntry, &sym, furi_string_get_cstr(symbol_name));
+                }
+            }
+
+            if(records) {
+                if(rel.r_offset > RELOCATION_CACHE_OFFSET_MASK ||
+                   relType > RELOCATION_CACHE_TYPE_MASK) {
+                    FURI_LOG_W(TAG, "  relocation can not be cached");
+                    free(records);
+                    records = NULL;
+                    elf_relocation_cache_abort(elf);
+                } else {
+                    records[relCount].sym_entry = symEntry;
+                    records[relCount].type_offset = ((uint32_t)relType << 24) | rel.r_offset;
+                }
             }
 
             if(symAddr != ELF_INVALID_ADDRESS) {
@@ -409,6 +1068,13 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
         }
         furi_string_free(symbol_name);
 
+        if(records) {
+            if(relocate_result && elf->relocation_cache_fd) {
+                elf_relocation_cache_put_section(elf, s, records, relEntries);
+            }
+            free(records);
+        }
+
         return relocate_result;
     } else {
         FURI_LOG_D(TAG, "Section not loaded");
@@ -532,10 +1198,26 @@ static SectionType elf_preload_section(
             elf->fini_array = section_p;
         }
 
+        elf->stats.sections_total_size += section_header->sh_size;
+
+        // Cold code is loaded on first call
+        if(str_prefix(name, LAZY_SECTION_PREFIX) && (section_header->sh_flags & SHF_EXECINSTR) &&
+           section_header->sh_type != SHT_NOBITS && section_header->sh_size) {
+            FURI_LOG_D(TAG, "Deferring lazy section '%s'", name);
+            section_p->lazy = true;
+            section_p->size = section_header->sh_size;
+            section_p->data_offset = section_header->sh_offset;
+            section_p->data_align = section_header->sh_addralign;
+            elf->stats.lazy_sections++;
+            return SectionTypeData;
+        }
+
         if(!elf_load_section_data(elf, section_p, section_header)) {
             FURI_LOG_E(TAG, "Error loading section '%s'", name);
             return SectionTypeERROR;
         } else {
+            elf->stats.sections_loaded++;
+            elf->stats.sections_size += section_header->sh_size;
             return SectionTypeData;
         }
     }
@@ -599,6 +1281,7 @@ static SectionType elf_preload_section(
 
 static Elf32_Addr elf_address_of_by_hash(ELFFile* elf, uint32_t hash) {
     Elf32_Addr addr = 0;
+    elf->stats.resolver_calls++;
     if(elf->api_interface->resolver_callback(elf->api_interface, hash, &addr)) {
         return addr;
     }
@@ -646,10 +1329,13 @@ static bool elf_relocate_fast(ELFFile* elf, ELFSection* s) {
             offsets_count);
 
         Elf32_Addr address = 0;
+        ELFSection* lazy_branch_section = NULL;
         if(is_section) {
             ELFSection* symSec = elf_section_of(elf, hash_or_section_index);
-            if(symSec) {
-                address = ((Elf32_Addr)symSec->data) + section_value;
+            if(symSec && elf_is_lazy_branch(symSec, section_value, type)) {
+                lazy_branch_section = symSec;
+            } else if(symSec) {
+                address = elf_section_address(elf, symSec, section_value);
             }
         } else {
             address = elf_address_of_by_hash(elf, hash_or_section_index);
@@ -665,7 +1351,12 @@ static bool elf_relocate_fast(ELFFile* elf, ELFSection* s) {
             start += 3;
             // FURI_LOG_I(TAG, "  Fast relocation offset %ld: %ld", j, offset);
             Elf32_Addr relAddr = ((Elf32_Addr)s->data) + offset;
+            if(lazy_branch_section) {
+                address =
+                    elf_lazy_branch_address(elf, lazy_branch_section, section_value, relAddr);
+            }
             elf_relocate_symbol(elf, relAddr, type, address);
+            elf->stats.fast_relocations++;
         }
     }
 
@@ -689,6 +1380,85 @@ static bool elf_relocate_section(ELFFile* elf, ELFSection* section) {
     return true;
 }
 
+/* Resolves imports of not loaded lazy section, so missing ones are reported on app load */
+static bool elf_lazy_check_imports(ELFFile* elf, ELFSection* section) {
+    if(section->fast_rel) {
+        const uint8_t* start = section->fast_rel->data;
+        if(*start != FAST_RELOCATION_VERSION) {
+            FURI_LOG_E(TAG, "Unsupported fast relocation version %d", *start);
+            return false;
+        }
+        start += 1;
+
+        const uint32_t records_count = *((uint32_t*)start);
+        start += 4;
+
+        for(uint32_t i = 0; i < records_count; i++) {
+            bool is_section = (*start & (0x1 << 7)) ? true : false;
+            start += 1;
+            uint32_t hash_or_section_index = *((uint32_t*)start);
+            start += 4;
+            if(is_section) {
+                start += 4;
+            } else if(elf_address_of_by_hash(elf, hash_or_section_index) == ELF_INVALID_ADDRESS) {
+                FURI_LOG_E(TAG, "Failed to resolve address for hash %lX", hash_or_section_index);
+                return false;
+            }
+
+            const uint32_t offsets_count = *((uint32_t*)start);
+            start += 4 + offsets_count * 3;
+        }
+    } else if(section->rel_count) {
+        bool result = true;
+        FuriString* symbol_name = furi_string_alloc();
+        (void)storage_file_seek(elf->fd, section->rel_offset, true);
+
+        for(size_t relCount = 0; relCount < section->rel_count; relCount++) {
+            if(relCount % RESOLVER_THREAD_YIELD_STEP == 0) {
+                furi_delay_tick(1);
+            }
+
+            Elf32_Rel rel;
+            if(storage_file_read(elf->fd, &rel, sizeof(Elf32_Rel)) != sizeof(Elf32_Rel)) {
+                FURI_LOG_E(TAG, "  reloc read fail");
+                result = false;
+                break;
+            }
+
+            // Only imports are cached here, section symbols can't be resolved without loading
+            int symEntry = ELF32_R_SYM(rel.r_info);
+            Elf32_Addr symAddr;
+            if(address_cache_get(elf->relocation_cache, symEntry, &symAddr)) {
+                continue;
+            }
+
+            Elf32_Sym sym;
+            furi_string_reset(symbol_name);
+            if(!elf_read_symbol(elf, symEntry, &sym, symbol_name)) {
+                FURI_LOG_E(TAG, "  symbol read fail");
+                result = false;
+                break;
+            }
+
+            if(sym.st_shndx == SHN_UNDEF) {
+                symAddr = elf_address_of(elf, &sym, furi_string_get_cstr(symbol_name));
+                if(symAddr == ELF_INVALID_ADDRESS) {
+                    FURI_LOG_E(
+                        TAG, "  No symbol address of %s", furi_string_get_cstr(symbol_name));
+                    result = false;
+                    break;
+                }
+                address_cache_put(elf->relocation_cache, symEntry, symAddr);
+            }
+        }
+
+        furi_string_free(symbol_name);
+        return result;
+    }
+
+    return true;
+}
+
 static void elf_file_call_section_list(ELFSection* section, bool reverse_order) {
     if(section && section->size) {
         const uint32_t* start = section->data;
@@ -714,10 +1484,14 @@ static void elf_file_call_section_list(ELFSection* section, bool reverse_order)
 
 ELFFile* elf_file_alloc(Storage* storage, const ElfApiInterface* api_interface) {
     ELFFile* elf = malloc(sizeof(ELFFile));
+    elf->storage = storage;
     elf->fd = storage_file_alloc(storage);
     elf->api_interface = api_interface;
     ELFSectionDict_init(elf->sections);
     AddressCache_init(elf->trampoline_cache);
+    ELFRelocationSymbolDict_init(elf->relocation_symbols);
+    ELFLazyStubDict_init(elf->lazy_stubs);
+    elf->lazy_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     elf->init_array_called = false;
     return elf;
 }
@@ -748,6 +1522,18 @@ void elf_file_free(ELFFile* elf) {
         ELFSectionDict_clear(elf->sections);
     }
 
+    // free lazy stubs
+    {
+        ELFLazyStubDict_it_t it;
+        for(ELFLazyStubDict_it(it, elf->lazy_stubs); !ELFLazyStubDict_end_p(it);
+            ELFLazyStubDict_next(it)) {
+            free(ELFLazyStubDict_cref(it)->value);
+        }
+
+        ELFLazyStubDict_clear(elf->lazy_stubs);
+        furi_mutex_free(elf->lazy_mutex);
+    }
+
     // free trampoline data
     {
         AddressCache_it_t it;
@@ -764,6 +1550,14 @@ void elf_file_free(ELFFile* elf) {
         free(elf->debug_link_info.debug_link);
     }
 
+    elf_relocation_cache_abort(elf);
+    ELFRelocationSymbolDict_clear(elf->relocation_symbols);
+    if(elf->relocation_cache_path) {
+        elf_relocation_cache_unstamp(elf);
+        furi_string_free(elf->relocation_cache_path);
+        furi_string_free(elf->file_path);
+    }
+
     storage_file_free(elf->fd);
     free(elf);
 }
@@ -784,6 +1578,17 @@ bool elf_file_open(ELFFile* elf, const char* path) {
     elf->sections_count = h.e_shnum;
     elf->section_table = h.e_shoff;
     elf->section_table_strings = sH.sh_offset;
+
+    if(!elf->relocation_cache_path) {
+        elf->relocation_cache_path = furi_string_alloc();
+        elf->file_path = furi_string_alloc();
+    }
+    furi_string_set(elf->file_path, path);
+    furi_string_printf(
+        elf->relocation_cache_path,
+        RELOCATION_CACHE_PATH "/%08lX.rel",
+        elf_symbolname_hash(path));
+
     return true;
 }
 
@@ -859,9 +1664,19 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
     ELFSectionDict_it_t it;
 
     AddressCache_init(elf->relocation_cache);
+    elf->relocating = true;
+    elf_relocation_cache_prepare(elf);
 
     for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
         ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
+        if(itref->value.lazy) {
+            // Relocated on load, if it was not loaded already by reference to its data
+            if(!itref->value.data && !elf_lazy_check_imports(elf, &itref->value)) {
+                FURI_LOG_E(TAG, "Error resolving imports of section '%s'", itref->key);
+                status = ELFFileLoadStatusMissingImports;
+            }
+            continue;
+        }
         FURI_LOG_D(TAG, "Relocating section '%s'", itref->key);
         if(!elf_relocate_section(elf, &itref->value)) {
             FURI_LOG_E(TAG, "Error relocating section '%s'", itref->key);
@@ -881,18 +1696,31 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
         }
     }
 
+    if(status == ELFFileLoadStatusSuccess) {
+        elf_relocation_cache_end(elf);
+    } else if(elf->relocation_cache_fd) {
+        elf_relocation_cache_abort(elf);
+    } else if(elf->relocation_cache_path) {
+        // Cached relocation data could be the reason, rebuild it on next launch
+        storage_common_remove(elf->storage, furi_string_get_cstr(elf->relocation_cache_path));
+    }
+    ELFRelocationSymbolDict_reset(elf->relocation_symbols);
+
     FURI_LOG_D(TAG, "Relocation cache size: %u", AddressCache_size(elf->relocation_cache));
     FURI_LOG_D(TAG, "Trampoline cache size: %u", AddressCache_size(elf->trampoline_cache));
     AddressCache_clear(elf->relocation_cache);
+    elf->relocating = false;
 
-    {
-        size_t total_size = 0;
-        for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it);
-            ELFSectionDict_next(it)) {
-            ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
-            total_size += itref->value.size;
-        }
-        FURI_LOG_I(TAG, "Total size of loaded sections: %u", total_size); //-V576
+    FURI_LOG_I(TAG, "Total size of loaded sections: %lu", elf->stats.sections_size);
+    if(elf->stats.lazy_sections) {
+        FURI_LOG_I(
+            TAG,
+            "Resident %lu of %lu bytes, %lu of %lu lazy sections loaded, %lu stubs",
+            elf->stats.sections_size,
+            elf->stats.sections_total_size,
+            elf->stats.lazy_sections_loaded,
+            elf->stats.lazy_sections,
+            elf->stats.lazy_stubs);
     }
 
     return status;
@@ -924,6 +1752,10 @@ const ElfApiInterface* elf_file_get_api_interface(ELFFile* elf_file) {
     return elf_file->api_interface;
 }
 
+const ELFFileStats* elf_file_get_stats(ELFFile* elf_file) {
+    return &elf_file->stats;
+}
+
 void elf_file_init_debug_info(ELFFile* elf, ELFDebugInfo* debug_info) {
     // set entry
     debug_info->entry = elf->entry;
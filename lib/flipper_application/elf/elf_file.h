@@ -45,6 +45,22 @@ typedef enum {
 
 typedef bool(ElfProcessSection)(File* file, size_t offset, size_t size, void* context);
 
+typedef struct {
+    uint32_t sections_loaded;
+    uint32_t sections_size; /* resident */
+    uint32_t sections_total_size; /* resident and not yet loaded lazy sections */
+    uint32_t lazy_sections;
+    uint32_t lazy_sections_loaded;
+    uint32_t lazy_stubs;
+    uint32_t relocations;
+    uint32_t fast_relocations;
+    uint32_t symbol_reads;
+    uint32_t symbol_cache_hits;
+    uint32_t resolver_calls;
+    uint32_t trampolines;
+    bool relocation_cache_used;
+} ELFFileStats;
+
 /**
  * @brief Allocate ELFFile instance
  * @param storage 
@@ -118,6 +134,13 @@ void elf_file_call_fini(ELFFile* elf);
  */
 const ElfApiInterface* elf_file_get_api_interface(ELFFile* elf_file);
 
+/**
+ * @brief Get ELF file loader statistics, collected by load stages #1 and #2
+ * @param elf_file 
+ * @return const ELFFileStats* 
+ */
+const ELFFileStats* elf_file_get_stats(ELFFile* elf_file);
+
 /**
  * @brief Get ELF file debug info
  * @param elf_file 
@@ -24,10 +24,31 @@ struct ELFSection {
     ELFSection* fast_rel;
 
     uint16_t sec_idx;
+
+    /* Cold code section, loaded on first call through ELFLazyStub */
+    bool lazy;
+    Elf32_Off data_offset;
+    Elf32_Word data_align;
 };
 
 DICT_DEF2(ELFSectionDict, const char*, M_CSTR_OPLIST, ELFSection, M_POD_OPLIST)
 
+/**
+ * Symbol reference recorded for relocation cache
+ */
+typedef struct {
+    bool is_section;
+    uint32_t hash_or_section_index;
+    uint32_t section_value;
+} ELFRelocationSymbol;
+
+DICT_DEF2(ELFRelocationSymbolDict, int, M_DEFAULT_OPLIST, ELFRelocationSymbol, M_POD_OPLIST)
+
+typedef struct ELFLazyStub ELFLazyStub;
+
+/* Lazy stubs, by section index in the upper half and symbol value in the lower half */
+DICT_DEF2(ELFLazyStubDict, uint64_t, M_DEFAULT_OPLIST, ELFLazyStub*, M_PTR_OPLIST)
+
 struct ELFFile {
     size_t sections_count;
     off_t section_table;
@@ -42,6 +63,7 @@ struct ELFFile {
     AddressCache_t relocation_cache;
     AddressCache_t trampoline_cache;
 
+    Storage* storage;
     File* fd;
     const ElfApiInterface* api_interface;
     ELFDebugLinkInfo debug_link_info;
@@ -51,6 +73,19 @@ struct ELFFile {
     ELFSection* fini_array;
 
     bool init_array_called;
+
+    FuriString* file_path;
+    FuriString* relocation_cache_path;
+    uint32_t relocation_cache_timestamp;
+    File* relocation_cache_fd;
+    ELFRelocationSymbolDict_t relocation_symbols;
+    uint16_t relocation_cache_sections;
+
+    ELFFileStats stats;
+
+    ELFLazyStubDict_t lazy_stubs;
+    FuriMutex* lazy_mutex;
+    bool relocating;
 };
 
 #ifdef __cplusplus
@@ -1,4 +1,5 @@
 #include <core/check.h>
+#include <core/memmgr_heap.h>
 #include <toolbox/stream/stream.h>
 #include <toolbox/stream/string_stream.h>
 #include <toolbox/stream/file_stream.h>
@@ -9,9 +10,25 @@
 #include "flipper_format_stream_i.h"
 
 /********************************** Private **********************************/
+#define FLIPPER_FORMAT_KEY_INDEX_MAX (UINT16_MAX)
+#define FLIPPER_FORMAT_KEY_INDEX_HEAP_RESERVE (4096)
+
+#define FLIPPER_FORMAT_KEY_INDEX_ENTRY(hash, number) (((uint32_t)(hash) << 16) | (number))
+#define FLIPPER_FORMAT_KEY_INDEX_ENTRY_HASH(entry) ((uint16_t)((entry) >> 16))
+#define FLIPPER_FORMAT_KEY_INDEX_ENTRY_NUMBER(entry) ((entry)&0xFFFF)
+
+typedef struct {
+    uint32_t* offsets; // key start offsets, in file order
+    uint32_t* entries; // key hash in upper 16 bits and key number in lower ones, sorted
+    size_t count;
+    size_t stream_size;
+    bool valid;
+} FlipperFormatKeyIndex;
+
 struct FlipperFormat {
     Stream* stream;
     bool strict_mode;
+    FlipperFormatKeyIndex* key_index;
 };
 
 static const char* const flipper_format_filetype_key = "Filetype";
@@ -21,12 +38,155 @@ Stream* flipper_format_get_raw_stream(FlipperFormat* flipper_format) {
     return flipper_format->stream;
 }
 
+static uint16_t flipper_format_key_hash(const char* key) {
+    // FNV-1a, folded to 16 bits
+    uint32_t hash = 0x811C9DC5;
+    while(*key) {
+        hash ^= (uint8_t)*key++;
+        hash *= 0x01000193;
+    }
+    return (hash >> 16) ^ (hash & 0xFFFF);
+}
+
+static void flipper_format_key_index_reset(FlipperFormat* flipper_format) {
+    FlipperFormatKeyIndex* index = flipper_format->key_index;
+    if(index) {
+        free(index->offsets);
+        free(index->entries);
+        index->offsets = NULL;
+        index->entries = NULL;
+        index->count = 0;
+        index->valid = false;
+    }
+}
+
+static int flipper_format_key_index_compare(const void* a, const void* b) {
+    // Entries are unique, sorted by hash, then by key number
+    uint32_t entry_a = *(const uint32_t*)a;
+    uint32_t entry_b = *(const uint32_t*)b;
+    return entry_a < entry_b ? -1 : (entry_a > entry_b);
+}
+
+static bool flipper_format_key_index_grow(FlipperFormatKeyIndex* index, size_t capacity) {
+    // Index is optional, give up instead of starving the rest of the system
+    size_t required = capacity * sizeof(uint32_t) * 2;
+    if(capacity > FLIPPER_FORMAT_KEY_INDEX_MAX ||
+       required + FLIPPER_FORMAT_KEY_INDEX_HEAP_RESERVE > memmgr_heap_get_max_free_block()) {
+        return false;
+    }
+    index->offsets = realloc(index->offsets, sizeof(uint32_t) * capacity); //-V701
+    index->entries = realloc(index->entries, sizeof(uint32_t) * capacity); //-V701
+    return true;
+}
+
+static bool flipper_format_key_index_build(FlipperFormat* flipper_format) {
+    FlipperFormatKeyIndex* index = flipper_format->key_index;
+    Stream* stream = flipper_format->stream;
+    flipper_format_key_index_reset(flipper_format);
+
+    FuriString* key = furi_string_alloc();
+    size_t position = stream_tell(stream);
+    size_t capacity = 0;
+    bool result = stream_rewind(stream);
+
+    while(result && flipper_format_stream_seek_to_next_key(stream, key)) {
+        if(index->count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            if(!flipper_format_key_index_grow(index, capacity)) {
+                result = false;
+                break;
+            }
+        }
+        index->offsets[index->count] = stream_tell(stream) - furi_string_size(key);
+        index->entries[index->count] = FLIPPER_FORMAT_KEY_INDEX_ENTRY(
+            flipper_format_key_hash(furi_string_get_cstr(key)), index->count);
+        index->count++;
+    }
+
+    if(result && index->count) {
+        qsort(index->entries, index->count, sizeof(uint32_t), flipper_format_key_index_compare);
+    }
+
+    stream_seek(stream, position, StreamOffsetFromStart);
+    furi_string_free(key);
+
+    if(result) {
+        index->stream_size = stream_size(stream);
+        index->valid = true;
+    } else {
+        flipper_format_key_index_reset(flipper_format);
+    }
+    return result;
+}
+
+/**
+ * Move the stream to the start of the next line with the key, or to the end of the stream if
+ * there is no such line, so the following key search stops right away.
+ * In strict mode move to the next key, whatever it is.
+ * Does nothing if the index is disabled or can't be built.
+ */
+static void flipper_format_key_index_seek(FlipperFormat* flipper_format, const char* key) {
+    FlipperFormatKeyIndex* index = flipper_format->key_index;
+    if(!index) return;
+
+    Stream* stream = flipper_format->stream;
+    // Catch writes done through the raw stream
+    if(!index->valid || index->stream_size != stream_size(stream)) {
+        if(!flipper_format_key_index_build(flipper_format)) return;
+    }
+
+    // First entry at or after the current position
+    size_t position = stream_tell(stream);
+    size_t low = 0;
+    size_t high = index->count;
+    while(low < high) {
+        size_t mid = (low + high) / 2;
+        if(index->offsets[mid] < position) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    size_t first = low;
+
+    size_t entry = index->count;
+    if(flipper_format->strict_mode) {
+        entry = first;
+    } else {
+        // First entry with the same hash at or after that one
+        uint16_t hash = flipper_format_key_hash(key);
+        uint32_t target = FLIPPER_FORMAT_KEY_INDEX_ENTRY(hash, first);
+        low = 0;
+        high = index->count;
+        while(low < high) {
+            size_t mid = (low + high) / 2;
+            if(index->entries[mid] < target) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        if(low < index->count &&
+           FLIPPER_FORMAT_KEY_INDEX_ENTRY_HASH(index->entries[low]) == hash) {
+            entry = FLIPPER_FORMAT_KEY_INDEX_ENTRY_NUMBER(index->entries[low]);
+        }
+    }
+
+    // Hash collisions are fine, the key search will continue from there
+    if(entry < index->count) {
+        stream_seek(stream, index->offsets[entry], StreamOffsetFromStart);
+    } else {
+        stream_seek(stream, 0, StreamOffsetFromEnd);
+    }
+}
+
 /********************************** Public **********************************/
 
 FlipperFormat* flipper_format_string_alloc() {
     FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
     flipper_format->stream = string_stream_alloc();
     flipper_format->strict_mode = false;
+    flipper_format->key_index = NULL;
     return flipper_format;
 }
 
@@ -34,6 +194,7 @@ FlipperFormat* flipper_format_file_alloc(Storage* storage) {
     FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
     flipper_format->stream = file_stream_alloc(storage);
     flipper_format->strict_mode = false;
+    flipper_format->key_index = NULL;
     return flipper_format;
 }
 
@@ -41,22 +202,26 @@ FlipperFormat* flipper_format_buffered_file_alloc(Storage* storage) {
     FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
     flipper_format->stream = buffered_file_stream_alloc(storage);
     flipper_format->strict_mode = false;
+    flipper_format->key_index = NULL;
     return flipper_format;
 }
 
 bool flipper_format_file_open_existing(FlipperFormat* flipper_format, const char* path) {
     furi_assert(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
 }
 
 bool flipper_format_buffered_file_open_existing(FlipperFormat* flipper_format, const char* path) {
     furi_assert(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return buffered_file_stream_open(
         flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
 }
 
 bool flipper_format_file_open_append(FlipperFormat* flipper_format, const char* path) {
     furi_assert(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
 
     bool result =
         file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_APPEND);
@@ -88,32 +253,39 @@ bool flipper_format_file_open_append(FlipperFormat* flipper_format, const char*
 
 bool flipper_format_file_open_always(FlipperFormat* flipper_format, const char* path) {
     furi_assert(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
 }
 
 bool flipper_format_buffered_file_open_always(FlipperFormat* flipper_format, const char* path) {
     furi_assert(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return buffered_file_stream_open(
         flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
 }
 
 bool flipper_format_file_open_new(FlipperFormat* flipper_format, const char* path) {
     furi_assert(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_NEW);
 }
 
 bool flipper_format_file_close(FlipperFormat* flipper_format) {
     furi_assert(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return file_stream_close(flipper_format->stream);
 }
 
 bool flipper_format_buffered_file_close(FlipperFormat* flipper_format) {
     furi_assert(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return buffered_file_stream_close(flipper_format->stream);
 }
 
 void flipper_format_free(FlipperFormat* flipper_format) {
     furi_assert(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
+    free(flipper_format->key_index);
     stream_free(flipper_format->stream);
     free(flipper_format);
 }
@@ -122,6 +294,18 @@ void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_m
     flipper_format->strict_mode = strict_mode;
 }
 
+void flipper_format_set_key_index(FlipperFormat* flipper_format, bool enable) {
+    furi_assert(flipper_format);
+    if(enable && !flipper_format->key_index) {
+        flipper_format->key_index = malloc(sizeof(FlipperFormatKeyIndex));
+        memset(flipper_format->key_index, 0, sizeof(FlipperFormatKeyIndex));
+    } else if(!enable && flipper_format->key_index) {
+        flipper_format_key_index_reset(flipper_format);
+        free(flipper_format->key_index);
+        flipper_format->key_index = NULL;
+    }
+}
+
 bool flipper_format_rewind(FlipperFormat* flipper_format) {
     furi_assert(flipper_format);
     return stream_rewind(flipper_format->stream);
@@ -135,6 +319,7 @@ bool flipper_format_seek_to_end(FlipperFormat* flipper_format) {
 bool flipper_format_key_exist(FlipperFormat* flipper_format, const char* key) {
     size_t pos = stream_tell(flipper_format->stream);
     stream_seek(flipper_format->stream, 0, StreamOffsetFromStart);
+    flipper_format_key_index_seek(flipper_format, key);
     bool result = flipper_format_stream_seek_to_key(flipper_format->stream, key, false);
     stream_seek(flipper_format->stream, pos, StreamOffsetFromStart);
 
@@ -174,12 +359,19 @@ bool flipper_format_get_value_count(
     const char* key,
     uint32_t* count) {
     furi_assert(flipper_format);
-    return flipper_format_stream_get_value_count(
+    size_t position = stream_tell(flipper_format->stream);
+    flipper_format_key_index_seek(flipper_format, key);
+    bool result = flipper_format_stream_get_value_count(
         flipper_format->stream, key, count, flipper_format->strict_mode);
+    if(!stream_seek(flipper_format->stream, position, StreamOffsetFromStart)) {
+        result = false;
+    }
+    return result;
 }
 
 bool flipper_format_read_string(FlipperFormat* flipper_format, const char* key, FuriString* data) {
     furi_assert(flipper_format);
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_read_value_line(
         flipper_format->stream, key, FlipperStreamValueStr, data, 1, flipper_format->strict_mode);
 }
@@ -192,6 +384,7 @@ bool flipper_format_write_string(FlipperFormat* flipper_format, const char* key,
         .data = furi_string_get_cstr(data),
         .data_size = 1,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -207,6 +400,7 @@ bool flipper_format_write_string_cstr(
         .data = data,
         .data_size = 1,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -217,6 +411,7 @@ bool flipper_format_read_hex_uint64(
     uint64_t* data,
     const uint16_t data_size) {
     furi_assert(flipper_format);
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_read_value_line(
         flipper_format->stream,
         key,
@@ -238,6 +433,7 @@ bool flipper_format_write_hex_uint64(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -248,6 +444,7 @@ bool flipper_format_read_uint32(
     uint32_t* data,
     const uint16_t data_size) {
     furi_assert(flipper_format);
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_read_value_line(
         flipper_format->stream,
         key,
@@ -269,6 +466,7 @@ bool flipper_format_write_uint32(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -278,6 +476,7 @@ bool flipper_format_read_int32(
     const char* key,
     int32_t* data,
     const uint16_t data_size) {
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_read_value_line(
         flipper_format->stream,
         key,
@@ -299,6 +498,7 @@ bool flipper_format_write_int32(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -308,6 +508,7 @@ bool flipper_format_read_bool(
     const char* key,
     bool* data,
     const uint16_t data_size) {
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_read_value_line(
         flipper_format->stream,
         key,
@@ -329,6 +530,7 @@ bool flipper_format_write_bool(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -338,6 +540,7 @@ bool flipper_format_read_float(
     const char* key,
     float* data,
     const uint16_t data_size) {
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_read_value_line(
         flipper_format->stream,
         key,
@@ -359,6 +562,7 @@ bool flipper_format_write_float(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -368,6 +572,7 @@ bool flipper_format_read_hex(
     const char* key,
     uint8_t* data,
     const uint16_t data_size) {
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_read_value_line(
         flipper_format->stream,
         key,
@@ -389,6 +594,7 @@ bool flipper_format_write_hex(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -400,6 +606,7 @@ bool flipper_format_write_comment(FlipperFormat* flipper_format, FuriString* dat
 
 bool flipper_format_write_comment_cstr(FlipperFormat* flipper_format, const char* data) {
     furi_assert(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return flipper_format_stream_write_comment_cstr(flipper_format->stream, data);
 }
 
@@ -411,6 +618,7 @@ bool flipper_format_delete_key(FlipperFormat* flipper_format, const char* key) {
         .data = NULL,
         .data_size = 0,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
@@ -424,6 +632,7 @@ bool flipper_format_update_string(FlipperFormat* flipper_format, const char* key
         .data = furi_string_get_cstr(data),
         .data_size = 1,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
@@ -440,6 +649,7 @@ bool flipper_format_update_string_cstr(
         .data = data,
         .data_size = 1,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
@@ -457,6 +667,7 @@ bool flipper_format_update_uint32(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
@@ -473,6 +684,7 @@ bool flipper_format_update_int32(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
@@ -489,6 +701,7 @@ bool flipper_format_update_bool(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
@@ -505,6 +718,7 @@ bool flipper_format_update_float(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
@@ -521,6 +735,7 @@ bool flipper_format_update_hex(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_key_index_reset(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
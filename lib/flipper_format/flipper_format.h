@@ -203,6 +203,16 @@ void flipper_format_free(FlipperFormat* flipper_format);
  */
 void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_mode);
 
+/**
+ * Enable key offset index. Disabled by default.
+ * Index is built on the first read after open and maps every key to its offset, so reads of
+ * large files don't rescan the stream. Any write drops the index, it is rebuilt on the next read.
+ * If there is not enough memory for the index, reads fall back to the regular scan.
+ * @param flipper_format Pointer to a FlipperFormat instance
+ * @param enable True to enable the index
+ */
+void flipper_format_set_key_index(FlipperFormat* flipper_format, bool enable);
+
 /**
  * Rewind the RW pointer.
  * @param flipper_format Pointer to a FlipperFormat instance
@@ -97,6 +97,10 @@ static bool flipper_format_stream_read_valid_key(Stream* stream, FuriString* key
     return found;
 }
 
+bool flipper_format_stream_seek_to_next_key(Stream* stream, FuriString* key) {
+    return flipper_format_stream_read_valid_key(stream, key);
+}
+
 bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode) {
     bool found = false;
     FuriString* read_key;
@@ -29,6 +29,17 @@ bool flipper_format_stream_write_eol(Stream* stream);
  */
 bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode);
 
+/**
+ * Seek to the next key from the current position of the stream.
+ * Position will be at the delimiter after the key, if the key is found,
+ * or at the end of the stream.
+ * @param stream 
+ * @param key key that was found
+ * @return true key is found
+ * @return false end of the stream
+ */
+bool flipper_format_stream_seek_to_next_key(Stream* stream, FuriString* key);
+
 #ifdef __cplusplus
 }
 #endif
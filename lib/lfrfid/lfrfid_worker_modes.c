@@ -24,6 +24,10 @@
 #define LFRFID_WORKER_READ_AVERAGE_COUNT 64
 #define LFRFID_WORKER_READ_MIN_TIME_US 16
 
+// FSK cards toggle at RF/8 and RF/10, ASK cards at RF/32 and slower
+#define LFRFID_WORKER_READ_FSK_PERIOD_MAX_US 100
+#define LFRFID_WORKER_READ_ASK_PERIOD_MIN_US 200
+
 #define LFRFID_WORKER_READ_DROP_TIME_MS 50
 #define LFRFID_WORKER_READ_STABILIZE_TIME_MS 450
 #define LFRFID_WORKER_READ_SWITCH_TIME_MS 2000
@@ -94,6 +98,45 @@ typedef enum {
     LFRFIDWorkerReadTimeout,
 } LFRFIDWorkerReadState;
 
+typedef enum {
+    LFRFIDWorkerReadModulationUnknown,
+    LFRFIDWorkerReadModulationASK,
+    LFRFIDWorkerReadModulationFSK,
+} LFRFIDWorkerReadModulation;
+
+static LFRFIDWorkerReadModulation
+    lfrfid_worker_read_get_modulation(LFRFIDFeature feature, bool card_sensed, uint32_t period) {
+    LFRFIDWorkerReadModulation modulation = LFRFIDWorkerReadModulationUnknown;
+
+    if((feature & LFRFIDFeatureASK) && card_sensed) {
+        if(period < LFRFID_WORKER_READ_FSK_PERIOD_MAX_US) {
+            modulation = LFRFIDWorkerReadModulationFSK;
+        } else if(period > LFRFID_WORKER_READ_ASK_PERIOD_MIN_US) {
+            modulation = LFRFIDWorkerReadModulationASK;
+        }
+    }
+
+    return modulation;
+}
+
+static void lfrfid_worker_read_prune_decoders(
+    LFRFIDWorker* worker,
+    LFRFIDFeature feature,
+    LFRFIDWorkerReadModulation modulation,
+    bool restart) {
+    // Decoders can only be re-armed by restarting them
+    if(restart) {
+        protocol_dict_decoders_start(worker->protocols);
+        protocol_dict_decoders_keep_by_feature(worker->protocols, feature);
+    }
+
+    if(modulation == LFRFIDWorkerReadModulationFSK) {
+        protocol_dict_decoders_keep_by_feature(worker->protocols, LFRFIDFeatureFSK);
+    } else if(modulation == LFRFIDWorkerReadModulationASK) {
+        protocol_dict_decoders_drop_by_feature(worker->protocols, LFRFIDFeatureFSK);
+    }
+}
+
 static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     LFRFIDWorker* worker,
     LFRFIDFeature feature,
@@ -118,7 +161,8 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     // stabilize detector
     lfrfid_worker_delay(worker, LFRFID_WORKER_READ_STABILIZE_TIME_MS);
 
-    protocol_dict_decoders_start(worker->protocols);
+    LFRFIDWorkerReadModulation modulation = LFRFIDWorkerReadModulationUnknown;
+    lfrfid_worker_read_prune_decoders(worker, feature, modulation, true);
 
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
     furi_hal_gpio_init_simple(LFRFID_WORKER_READ_DEBUG_GPIO_VALUE, GpioModeOutputPushPull);
@@ -197,10 +241,23 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
                 average_index++;
                 if(average_index >= LFRFID_WORKER_READ_AVERAGE_COUNT) {
                     float average = (float)average_pulse / (float)average_duration;
+                    uint32_t average_period = average_duration / LFRFID_WORKER_READ_AVERAGE_COUNT;
                     average_pulse = 0;
                     average_duration = 0;
                     average_index = 0;
 
+                    // Drop decoders that can't sync to the card in the field
+                    LFRFIDWorkerReadModulation new_modulation = lfrfid_worker_read_get_modulation(
+                        feature, average > 0.2f && average < 0.8f, average_period);
+                    if(new_modulation != modulation) {
+                        lfrfid_worker_read_prune_decoders(
+                            worker,
+                            feature,
+                            new_modulation,
+                            modulation != LFRFIDWorkerReadModulationUnknown);
+                        modulation = new_modulation;
+                    }
+
                     if(worker->read_cb) {
                         if(average > 0.2f && average < 0.8f) {
                             if(!card_detected) {
@@ -220,11 +277,11 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
 
                 ProtocolId protocol = PROTOCOL_NO;
 
-                protocol = protocol_dict_decoders_feed_by_feature(
-                    worker->protocols, feature, true, pulse);
+                // Active decoders are already pruned to the feature
+                protocol = protocol_dict_decoders_feed(worker->protocols, true, pulse);
                 if(protocol == PROTOCOL_NO) {
-                    protocol = protocol_dict_decoders_feed_by_feature(
-                        worker->protocols, feature, false, duration - pulse);
+                    protocol =
+                        protocol_dict_decoders_feed(worker->protocols, false, duration - pulse);
                 }
 
                 if(protocol != PROTOCOL_NO) {
@@ -280,7 +337,7 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
                         furi_string_free(string_info);
                     }
 
-                    protocol_dict_decoders_start(worker->protocols);
+                    lfrfid_worker_read_prune_decoders(worker, feature, modulation, true);
                 }
             }
         }
@@ -231,7 +231,7 @@ const ProtocolBase protocol_fdx_a = {
     .name = "FDX-A",
     .manufacturer = "FECAVA",
     .data_size = FDXA_DECODED_DATA_SIZE,
-    .features = LFRFIDFeatureASK,
+    .features = LFRFIDFeatureASK | LFRFIDFeatureFSK,
     .validate_count = 3,
     .alloc = (ProtocolAlloc)protocol_fdx_a_alloc,
     .free = (ProtocolFree)protocol_fdx_a_free,
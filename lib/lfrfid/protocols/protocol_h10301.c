@@ -369,7 +369,7 @@ const ProtocolBase protocol_h10301 = {
     .name = "H10301",
     .manufacturer = "HID",
     .data_size = H10301_DECODED_DATA_SIZE,
-    .features = LFRFIDFeatureASK,
+    .features = LFRFIDFeatureASK | LFRFIDFeatureFSK,
     .validate_count = 3,
     .alloc = (ProtocolAlloc)protocol_h10301_alloc,
     .free = (ProtocolFree)protocol_h10301_free,
@@ -202,7 +202,7 @@ const ProtocolBase protocol_hid_ex_generic = {
     .name = "HIDExt",
     .manufacturer = "Generic",
     .data_size = HID_DECODED_DATA_SIZE,
-    .features = LFRFIDFeatureASK,
+    .features = LFRFIDFeatureASK | LFRFIDFeatureFSK,
     .validate_count = 3,
     .alloc = (ProtocolAlloc)protocol_hid_ex_generic_alloc,
     .free = (ProtocolFree)protocol_hid_ex_generic_free,
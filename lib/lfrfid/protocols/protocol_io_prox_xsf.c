@@ -280,7 +280,7 @@ const ProtocolBase protocol_io_prox_xsf = {
     .name = "IoProxXSF",
     .manufacturer = "Kantech",
     .data_size = IOPROXXSF_DECODED_DATA_SIZE,
-    .features = LFRFIDFeatureASK,
+    .features = LFRFIDFeatureASK | LFRFIDFeatureFSK,
     .validate_count = 3,
     .alloc = (ProtocolAlloc)protocol_io_prox_xsf_alloc,
     .free = (ProtocolFree)protocol_io_prox_xsf_free,
@@ -219,7 +219,7 @@ const ProtocolBase protocol_paradox = {
     .name = "Paradox",
     .manufacturer = "Paradox",
     .data_size = PARADOX_DECODED_DATA_SIZE,
-    .features = LFRFIDFeatureASK,
+    .features = LFRFIDFeatureASK | LFRFIDFeatureFSK,
     .validate_count = 3,
     .alloc = (ProtocolAlloc)protocol_paradox_alloc,
     .free = (ProtocolFree)protocol_paradox_free,
@@ -1,19 +1,72 @@
 #include "mf_classic_dict.h"
 
 #include <lib/toolbox/args.h>
+#include <lib/toolbox/crc32_calc.h>
 #include <lib/flipper_format/flipper_format.h>
 
 #define MF_CLASSIC_DICT_FLIPPER_PATH EXT_PATH("nfc/assets/mf_classic_dict.nfc")
 #define MF_CLASSIC_DICT_USER_PATH EXT_PATH("nfc/assets/mf_classic_dict_user.nfc")
 #define MF_CLASSIC_DICT_UNIT_TEST_PATH EXT_PATH("unit_tests/mf_classic_dict.nfc")
 
+#define MF_CLASSIC_DICT_FLIPPER_INDEX_PATH EXT_PATH("nfc/assets/mf_classic_dict.idx")
+#define MF_CLASSIC_DICT_USER_INDEX_PATH EXT_PATH("nfc/assets/mf_classic_dict_user.idx")
+#define MF_CLASSIC_DICT_UNIT_TEST_INDEX_PATH EXT_PATH("unit_tests/mf_classic_dict.idx")
+
 #define TAG "MfClassicDict"
 
 #define NFC_MF_CLASSIC_KEY_LEN (13)
 
+/*
+ * Index is a sidecar file next to the text dictionary:
+ * header followed by entries sorted in ascending order.
+ * Each entry is 48 bit key in upper bits and 16 bit position
+ * of the first occurrence of the key in the text dictionary.
+ * Duplicate keys are stored once.
+ * Index is bound to the text dictionary by its size and CRC32:
+ * storage timestamp is storage-wide and can't tell which file was changed.
+ */
+#define MF_CLASSIC_DICT_INDEX_MAGIC (0x5844434DUL)
+#define MF_CLASSIC_DICT_INDEX_VERSION (2)
+#define MF_CLASSIC_DICT_INDEX_KEYS_MAX (UINT16_MAX)
+#define MF_CLASSIC_DICT_INDEX_BLOCK_ENTRIES (64)
+#define MF_CLASSIC_DICT_INDEX_HEAP_RESERVE (8 * 1024)
+#define MF_CLASSIC_DICT_INDEX_CRC_CHUNK (512)
+
+#define MF_CLASSIC_DICT_INDEX_ENTRY(key, index) (((key) << 16) | ((index)&0xFFFF))
+#define MF_CLASSIC_DICT_INDEX_ENTRY_KEY(entry) ((entry) >> 16)
+#define MF_CLASSIC_DICT_INDEX_ENTRY_POSITION(entry) ((uint32_t)((entry)&0xFFFF))
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t source_size;
+    uint32_t source_crc;
+    uint32_t entries_count;
+} MfClassicDictIndexHeader;
+
+typedef enum {
+    MfClassicDictIndexStateUnknown,
+    MfClassicDictIndexStateReady,
+    MfClassicDictIndexStateUnavailable,
+} MfClassicDictIndexState;
+
+typedef struct {
+    MfClassicDictIndexState state;
+    bool rebuilt;
+    File* file;
+    uint32_t entries_count;
+    // First key of every block, used to pick the block for a lookup
+    uint64_t* fences;
+    uint32_t fences_count;
+    uint64_t block[MF_CLASSIC_DICT_INDEX_BLOCK_ENTRIES];
+} MfClassicDictIndex;
+
 struct MfClassicDict {
     Stream* stream;
     uint32_t total_keys;
+    const char* path;
+    const char* index_path;
+    MfClassicDictIndex index;
 };
 
 bool mf_classic_dict_check_presence(MfClassicDictType dict_type) {
@@ -40,9 +93,19 @@ MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
     dict->stream = buffered_file_stream_alloc(storage);
     furi_record_close(RECORD_STORAGE);
 
+    dict->total_keys = 0;
+    dict->index.state = MfClassicDictIndexStateUnknown;
+    dict->index.rebuilt = false;
+    dict->index.file = NULL;
+    dict->index.fences = NULL;
+    dict->index.fences_count = 0;
+    dict->index.entries_count = 0;
+
     bool dict_loaded = false;
     do {
         if(dict_type == MfClassicDictTypeSystem) {
+            dict->path = MF_CLASSIC_DICT_FLIPPER_PATH;
+            dict->index_path = MF_CLASSIC_DICT_FLIPPER_INDEX_PATH;
             if(!buffered_file_stream_open(
                    dict->stream,
                    MF_CLASSIC_DICT_FLIPPER_PATH,
@@ -52,12 +115,16 @@ MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
                 break;
             }
         } else if(dict_type == MfClassicDictTypeUser) {
+            dict->path = MF_CLASSIC_DICT_USER_PATH;
+            dict->index_path = MF_CLASSIC_DICT_USER_INDEX_PATH;
             if(!buffered_file_stream_open(
                    dict->stream, MF_CLASSIC_DICT_USER_PATH, FSAM_READ_WRITE, FSOM_OPEN_ALWAYS)) {
                 buffered_file_stream_close(dict->stream);
                 break;
             }
         } else if(dict_type == MfClassicDictTypeUnitTest) {
+            dict->path = MF_CLASSIC_DICT_UNIT_TEST_PATH;
+            dict->index_path = MF_CLASSIC_DICT_UNIT_TEST_INDEX_PATH;
             if(!buffered_file_stream_open(
                    dict->stream,
                    MF_CLASSIC_DICT_UNIT_TEST_PATH,
@@ -106,6 +173,7 @@ MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
 
     if(!dict_loaded) {
         buffered_file_stream_close(dict->stream);
+        stream_free(dict->stream);
         free(dict);
         dict = NULL;
     }
@@ -113,10 +181,13 @@ MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
     return dict;
 }
 
+static void mf_classic_dict_index_reset(MfClassicDict* dict);
+
 void mf_classic_dict_free(MfClassicDict* dict) {
     furi_assert(dict);
     furi_assert(dict->stream);
 
+    mf_classic_dict_index_reset(dict);
     buffered_file_stream_close(dict->stream);
     stream_free(dict->stream);
     free(dict);
@@ -140,6 +211,297 @@ static void mf_classic_dict_str_to_int(FuriString* key_str, uint64_t* key_int) {
     }
 }
 
+static void mf_classic_dict_index_reset(MfClassicDict* dict) {
+    MfClassicDictIndex* index = &dict->index;
+
+    if(index->file) {
+        storage_file_close(index->file);
+        storage_file_free(index->file);
+        index->file = NULL;
+    }
+    if(index->fences) {
+        free(index->fences);
+        index->fences = NULL;
+    }
+    index->fences_count = 0;
+    index->entries_count = 0;
+    index->state = MfClassicDictIndexStateUnknown;
+}
+
+static void mf_classic_dict_index_invalidate(MfClassicDict* dict) {
+    mf_classic_dict_index_reset(dict);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_common_remove(storage, dict->index_path);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static bool
+    mf_classic_dict_index_get_source_info(MfClassicDict* dict, MfClassicDictIndexHeader* header) {
+    if(!buffered_file_stream_sync(dict->stream)) return false;
+
+    header->magic = MF_CLASSIC_DICT_INDEX_MAGIC;
+    header->version = MF_CLASSIC_DICT_INDEX_VERSION;
+    header->source_size = stream_size(dict->stream);
+    header->source_crc = 0;
+    header->entries_count = 0;
+
+    if(!stream_rewind(dict->stream)) return false;
+
+    uint8_t* buffer = malloc(MF_CLASSIC_DICT_INDEX_CRC_CHUNK);
+    size_t total_read = 0;
+    size_t read;
+    do {
+        read = stream_read(dict->stream, buffer, MF_CLASSIC_DICT_INDEX_CRC_CHUNK);
+        header->source_crc = crc32_calc_buffer(header->source_crc, buffer, read);
+        total_read += read;
+    } while(read == MF_CLASSIC_DICT_INDEX_CRC_CHUNK);
+    free(buffer);
+
+    return total_read == header->source_size;
+}
+
+static bool
+    mf_classic_dict_index_open(MfClassicDict* dict, const MfClassicDictIndexHeader* source) {
+    MfClassicDictIndex* index = &dict->index;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    index->file = storage_file_alloc(storage);
+    furi_record_close(RECORD_STORAGE);
+
+    bool index_opened = false;
+    do {
+        if(!storage_file_open(index->file, dict->index_path, FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        MfClassicDictIndexHeader header;
+        if(storage_file_read(index->file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != source->magic || header.version != source->version) break;
+        if(header.source_size != source->source_size ||
+           header.source_crc != source->source_crc) {
+            FURI_LOG_D(TAG, "Index is outdated");
+            break;
+        }
+        if(header.entries_count > dict->total_keys) break;
+
+        uint32_t fences_count = (header.entries_count + MF_CLASSIC_DICT_INDEX_BLOCK_ENTRIES - 1) /
+                                MF_CLASSIC_DICT_INDEX_BLOCK_ENTRIES;
+        uint64_t expected_size = sizeof(header) +
+                                 (uint64_t)(header.entries_count + fences_count) *
+                                     sizeof(uint64_t);
+        if(storage_file_size(index->file) != expected_size) break;
+
+        index->entries_count = header.entries_count;
+        index->fences_count = fences_count;
+        if(fences_count) {
+            uint16_t fences_size = fences_count * sizeof(uint64_t);
+            index->fences = malloc(fences_size);
+            if(!storage_file_seek(
+                   index->file,
+                   sizeof(header) + header.entries_count * sizeof(uint64_t),
+                   true))
+                break;
+            if(storage_file_read(index->file, index->fences, fences_size) != fences_size) break;
+        }
+
+        index_opened = true;
+    } while(false);
+
+    if(!index_opened) {
+        mf_classic_dict_index_reset(dict);
+    }
+
+    return index_opened;
+}
+
+static int mf_classic_dict_index_entry_cmp(const void* a, const void* b) {
+    const uint64_t entry_a = *(const uint64_t*)a;
+    const uint64_t entry_b = *(const uint64_t*)b;
+    return (entry_a > entry_b) - (entry_a < entry_b);
+}
+
+static bool
+    mf_classic_dict_index_build(MfClassicDict* dict, const MfClassicDictIndexHeader* source) {
+    if(dict->total_keys > MF_CLASSIC_DICT_INDEX_KEYS_MAX) return false;
+
+    size_t entries_size = dict->total_keys * sizeof(uint64_t);
+    if(memmgr_heap_get_max_free_block() < entries_size + MF_CLASSIC_DICT_INDEX_HEAP_RESERVE) {
+        FURI_LOG_W(TAG, "Not enough memory to build index");
+        return false;
+    }
+
+    uint64_t* entries = malloc(entries_size + sizeof(uint64_t));
+    uint32_t entries_count = 0;
+
+    // Collect keys with their positions in text dictionary
+    FuriString* next_line;
+    next_line = furi_string_alloc();
+    stream_rewind(dict->stream);
+    while(entries_count < dict->total_keys) {
+        if(!stream_read_line(dict->stream, next_line)) break;
+        if(furi_string_get_char(next_line, 0) == '#') continue;
+        if(furi_string_size(next_line) != NFC_MF_CLASSIC_KEY_LEN) continue;
+        uint64_t key = 0;
+        mf_classic_dict_str_to_int(next_line, &key);
+        entries[entries_count] = MF_CLASSIC_DICT_INDEX_ENTRY(key, entries_count);
+        entries_count++;
+    }
+    furi_string_free(next_line);
+
+    // Same keys are ordered by position, keep only the first occurrence
+    qsort(entries, entries_count, sizeof(uint64_t), mf_classic_dict_index_entry_cmp);
+    uint32_t unique_count = 0;
+    for(uint32_t i = 0; i < entries_count; i++) {
+        if(unique_count && MF_CLASSIC_DICT_INDEX_ENTRY_KEY(entries[unique_count - 1]) ==
+                               MF_CLASSIC_DICT_INDEX_ENTRY_KEY(entries[i])) {
+            continue;
+        }
+        entries[unique_count++] = entries[i];
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    bool index_built = false;
+    do {
+        if(!storage_file_open(file, dict->index_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+
+        MfClassicDictIndexHeader header = *source;
+        header.entries_count = unique_count;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        uint32_t written = 0;
+        while(written < unique_count) {
+            uint32_t chunk = MIN(unique_count - written, MF_CLASSIC_DICT_INDEX_BLOCK_ENTRIES);
+            uint16_t chunk_size = chunk * sizeof(uint64_t);
+            if(storage_file_write(file, &entries[written], chunk_size) != chunk_size) break;
+            written += chunk;
+        }
+        if(written != unique_count) break;
+
+        uint32_t fence = 0;
+        for(; fence < unique_count; fence += MF_CLASSIC_DICT_INDEX_BLOCK_ENTRIES) {
+            if(storage_file_write(file, &entries[fence], sizeof(uint64_t)) != sizeof(uint64_t))
+                break;
+        }
+        if(fence < unique_count) break;
+
+        index_built = true;
+    } while(false);
+
+    storage_file_close(file);
+    if(!index_built) {
+        storage_common_remove(storage, dict->index_path);
+    }
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    free(entries);
+
+    FURI_LOG_I(
+        TAG,
+        "Index %s: %lu keys, %lu unique",
+        index_built ? "built" : "failed",
+        entries_count,
+        unique_count);
+
+    return index_built;
+}
+
+static bool mf_classic_dict_index_prepare(MfClassicDict* dict) {
+    MfClassicDictIndex* index = &dict->index;
+
+    if(index->state == MfClassicDictIndexStateUnknown) {
+        // Lookups must not disturb key iteration
+        size_t position = stream_tell(dict->stream);
+
+        MfClassicDictIndexHeader source;
+        bool index_ready = false;
+        index->rebuilt = false;
+        if(mf_classic_dict_index_get_source_info(dict, &source)) {
+            index_ready = mf_classic_dict_index_open(dict, &source);
+            if(!index_ready && mf_classic_dict_index_build(dict, &source)) {
+                index->rebuilt = true;
+                index_ready = mf_classic_dict_index_open(dict, &source);
+            }
+        }
+
+        index->state = index_ready ? MfClassicDictIndexStateReady :
+                                     MfClassicDictIndexStateUnavailable;
+        stream_seek(dict->stream, position, StreamOffsetFromStart);
+    }
+
+    return index->state == MfClassicDictIndexStateReady;
+}
+
+static bool mf_classic_dict_index_find(MfClassicDict* dict, uint64_t key, uint32_t* target) {
+    MfClassicDictIndex* index = &dict->index;
+
+    // Find last block whose first key is not greater than the key
+    uint32_t low = 0;
+    uint32_t high = index->fences_count;
+    while(low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if(MF_CLASSIC_DICT_INDEX_ENTRY_KEY(index->fences[mid]) <= key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if(low == 0) return false;
+
+    uint32_t block_start = (low - 1) * MF_CLASSIC_DICT_INDEX_BLOCK_ENTRIES;
+    uint32_t block_entries =
+        MIN(index->entries_count - block_start, MF_CLASSIC_DICT_INDEX_BLOCK_ENTRIES);
+    uint16_t block_size = block_entries * sizeof(uint64_t);
+    if(!storage_file_seek(
+           index->file,
+           sizeof(MfClassicDictIndexHeader) + block_start * sizeof(uint64_t),
+           true))
+        return false;
+    if(storage_file_read(index->file, index->block, block_size) != block_size) return false;
+
+    low = 0;
+    high = block_entries;
+    while(low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        uint64_t mid_key = MF_CLASSIC_DICT_INDEX_ENTRY_KEY(index->block[mid]);
+        if(mid_key == key) {
+            if(target) *target = MF_CLASSIC_DICT_INDEX_ENTRY_POSITION(index->block[mid]);
+            return true;
+        } else if(mid_key < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return false;
+}
+
+static bool mf_classic_dict_scan_for_key(MfClassicDict* dict, FuriString* key, uint32_t* target) {
+    FuriString* next_line;
+    next_line = furi_string_alloc();
+
+    bool key_found = false;
+    uint32_t index = 0;
+    stream_rewind(dict->stream);
+    while(!key_found) { //-V654
+        if(!stream_read_line(dict->stream, next_line)) break;
+        if(furi_string_get_char(next_line, 0) == '#') continue;
+        if(furi_string_size(next_line) != NFC_MF_CLASSIC_KEY_LEN) continue;
+        furi_string_left(next_line, 12);
+        if(!furi_string_equal(key, next_line)) {
+            index++;
+            continue;
+        }
+        key_found = true;
+        if(target) *target = index;
+    }
+
+    furi_string_free(next_line);
+    return key_found;
+}
+
 uint32_t mf_classic_dict_get_total_keys(MfClassicDict* dict) {
     furi_assert(dict);
 
@@ -188,22 +550,13 @@ bool mf_classic_dict_is_key_present_str(MfClassicDict* dict, FuriString* key) {
     furi_assert(dict);
     furi_assert(dict->stream);
 
-    FuriString* next_line;
-    next_line = furi_string_alloc();
-
-    bool key_found = false;
-    stream_rewind(dict->stream);
-    while(!key_found) { //-V654
-        if(!stream_read_line(dict->stream, next_line)) break;
-        if(furi_string_get_char(next_line, 0) == '#') continue;
-        if(furi_string_size(next_line) != NFC_MF_CLASSIC_KEY_LEN) continue;
-        furi_string_left(next_line, 12);
-        if(!furi_string_equal(key, next_line)) continue;
-        key_found = true;
+    if(mf_classic_dict_index_prepare(dict)) {
+        uint64_t key_int = 0;
+        mf_classic_dict_str_to_int(key, &key_int);
+        return mf_classic_dict_index_find(dict, key_int, NULL);
     }
 
-    furi_string_free(next_line);
-    return key_found;
+    return mf_classic_dict_scan_for_key(dict, key, NULL);
 }
 
 bool mf_classic_dict_is_key_present(MfClassicDict* dict, uint8_t* key) {
@@ -227,6 +580,7 @@ bool mf_classic_dict_add_key_str(MfClassicDict* dict, FuriString* key) {
         if(!stream_seek(dict->stream, 0, StreamOffsetFromEnd)) break;
         if(!stream_insert_string(dict->stream, key)) break;
         dict->total_keys++;
+        mf_classic_dict_index_invalidate(dict);
         key_added = true;
     } while(false);
 
@@ -288,24 +642,13 @@ bool mf_classic_dict_find_index_str(MfClassicDict* dict, FuriString* key, uint32
     furi_assert(dict);
     furi_assert(dict->stream);
 
-    FuriString* next_line;
-    next_line = furi_string_alloc();
-
-    bool key_found = false;
-    uint32_t index = 0;
-    stream_rewind(dict->stream);
-    while(!key_found) { //-V654
-        if(!stream_read_line(dict->stream, next_line)) break;
-        if(furi_string_get_char(next_line, 0) == '#') continue;
-        if(furi_string_size(next_line) != NFC_MF_CLASSIC_KEY_LEN) continue;
-        furi_string_left(next_line, 12);
-        if(!furi_string_equal(key, next_line)) continue;
-        key_found = true;
-        *target = index;
+    if(mf_classic_dict_index_prepare(dict)) {
+        uint64_t key_int = 0;
+        mf_classic_dict_str_to_int(key, &key_int);
+        return mf_classic_dict_index_find(dict, key_int, target);
     }
 
-    furi_string_free(next_line);
-    return key_found;
+    return mf_classic_dict_scan_for_key(dict, key, target);
 }
 
 bool mf_classic_dict_find_index(MfClassicDict* dict, uint8_t* key, uint32_t* target) {
@@ -339,6 +682,7 @@ bool mf_classic_dict_delete_index(MfClassicDict* dict, uint32_t target) {
         stream_seek(dict->stream, -NFC_MF_CLASSIC_KEY_LEN, StreamOffsetFromCurrent);
         if(!stream_delete(dict->stream, NFC_MF_CLASSIC_KEY_LEN)) break;
         dict->total_keys--;
+        mf_classic_dict_index_invalidate(dict);
         key_removed = true;
     }
 
@@ -347,3 +691,9 @@ bool mf_classic_dict_delete_index(MfClassicDict* dict, uint32_t target) {
     furi_string_free(next_line);
     return key_removed;
 }
+
+bool mf_classic_dict_is_index_rebuilt(MfClassicDict* dict) {
+    furi_assert(dict);
+
+    return dict->index.rebuilt;
+}
@@ -102,6 +102,15 @@ bool mf_classic_dict_find_index_str(MfClassicDict* dict, FuriString* key, uint32
  */
 bool mf_classic_dict_delete_index(MfClassicDict* dict, uint32_t target);
 
+/** Check if key index was rebuilt on last lookup
+ *
+ * @param      dict  MfClassicDict instance
+ *
+ * @return     true if index was built from the text dictionary, false if
+ *             index file was reused or index is not used
+ */
+bool mf_classic_dict_is_index_rebuilt(MfClassicDict* dict);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
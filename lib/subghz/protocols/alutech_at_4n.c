@@ -47,6 +47,15 @@ typedef enum {
     Alutech_at_4nDecoderStepCheckDuration,
 } Alutech_at_4nDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_alutech_at_4n_envelope = {
+    .timing = &subghz_protocol_alutech_at_4n_const,
+    .start_level = true,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 1,
+    .start_delta_count = 1,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderAlutech_at_4n, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_alutech_at_4n_decoder = {
     .alloc = subghz_protocol_decoder_alutech_at_4n_alloc,
     .free = subghz_protocol_decoder_alutech_at_4n_free,
@@ -58,6 +67,8 @@ const SubGhzProtocolDecoder subghz_protocol_alutech_at_4n_decoder = {
     .serialize = subghz_protocol_decoder_alutech_at_4n_serialize,
     .deserialize = subghz_protocol_decoder_alutech_at_4n_deserialize,
     .get_string = subghz_protocol_decoder_alutech_at_4n_get_string,
+
+    .envelope = &subghz_protocol_alutech_at_4n_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_alutech_at_4n_encoder = {
@@ -42,6 +42,15 @@ typedef enum {
     AnsonicDecoderStepCheckDuration,
 } AnsonicDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_ansonic_envelope = {
+    .timing = &subghz_protocol_ansonic_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 35,
+    .start_delta_count = 35,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderAnsonic, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_ansonic_decoder = {
     .alloc = subghz_protocol_decoder_ansonic_alloc,
     .free = subghz_protocol_decoder_ansonic_free,
@@ -53,6 +62,8 @@ const SubGhzProtocolDecoder subghz_protocol_ansonic_decoder = {
     .serialize = subghz_protocol_decoder_ansonic_serialize,
     .deserialize = subghz_protocol_decoder_ansonic_deserialize,
     .get_string = subghz_protocol_decoder_ansonic_get_string,
+
+    .envelope = &subghz_protocol_ansonic_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_ansonic_encoder = {
@@ -52,6 +52,15 @@ typedef enum {
     BETTDecoderStepCheckDuration,
 } BETTDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_bett_envelope = {
+    .timing = &subghz_protocol_bett_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 44,
+    .start_delta_count = 15,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderBETT, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_bett_decoder = {
     .alloc = subghz_protocol_decoder_bett_alloc,
     .free = subghz_protocol_decoder_bett_free,
@@ -63,6 +72,8 @@ const SubGhzProtocolDecoder subghz_protocol_bett_decoder = {
     .serialize = subghz_protocol_decoder_bett_serialize,
     .deserialize = subghz_protocol_decoder_bett_deserialize,
     .get_string = subghz_protocol_decoder_bett_get_string,
+
+    .envelope = &subghz_protocol_bett_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_bett_encoder = {
@@ -48,6 +48,15 @@ typedef enum {
     CameDecoderStepCheckDuration,
 } CameDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_came_envelope = {
+    .timing = &subghz_protocol_came_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 56,
+    .start_delta_count = 47,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderCame, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_came_decoder = {
     .alloc = subghz_protocol_decoder_came_alloc,
     .free = subghz_protocol_decoder_came_free,
@@ -59,6 +68,8 @@ const SubGhzProtocolDecoder subghz_protocol_came_decoder = {
     .serialize = subghz_protocol_decoder_came_serialize,
     .deserialize = subghz_protocol_decoder_came_deserialize,
     .get_string = subghz_protocol_decoder_came_get_string,
+
+    .envelope = &subghz_protocol_came_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_came_encoder = {
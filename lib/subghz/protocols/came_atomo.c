@@ -39,6 +39,15 @@ typedef enum {
     CameAtomoDecoderStepDecoderData,
 } CameAtomoDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_came_atomo_envelope = {
+    .timing = &subghz_protocol_came_atomo_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeLong,
+    .start_te_count = 60,
+    .start_delta_count = 40,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderCameAtomo, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_came_atomo_decoder = {
     .alloc = subghz_protocol_decoder_came_atomo_alloc,
     .free = subghz_protocol_decoder_came_atomo_free,
@@ -50,6 +59,8 @@ const SubGhzProtocolDecoder subghz_protocol_came_atomo_decoder = {
     .serialize = subghz_protocol_decoder_came_atomo_serialize,
     .deserialize = subghz_protocol_decoder_came_atomo_deserialize,
     .get_string = subghz_protocol_decoder_came_atomo_get_string,
+
+    .envelope = &subghz_protocol_came_atomo_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_came_atomo_encoder = {
@@ -70,6 +70,15 @@ typedef enum {
     CameTweeDecoderStepDecoderData,
 } CameTweeDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_came_twee_envelope = {
+    .timing = &subghz_protocol_came_twee_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeLong,
+    .start_te_count = 51,
+    .start_delta_count = 20,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderCameTwee, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_came_twee_decoder = {
     .alloc = subghz_protocol_decoder_came_twee_alloc,
     .free = subghz_protocol_decoder_came_twee_free,
@@ -81,6 +90,8 @@ const SubGhzProtocolDecoder subghz_protocol_came_twee_decoder = {
     .serialize = subghz_protocol_decoder_came_twee_serialize,
     .deserialize = subghz_protocol_decoder_came_twee_deserialize,
     .get_string = subghz_protocol_decoder_came_twee_get_string,
+
+    .envelope = &subghz_protocol_came_twee_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_came_twee_encoder = {
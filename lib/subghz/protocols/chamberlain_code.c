@@ -66,6 +66,15 @@ typedef enum {
     Chamb_CodeDecoderStepCheckDuration,
 } Chamb_CodeDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_chamb_code_envelope = {
+    .timing = &subghz_protocol_chamb_code_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 39,
+    .start_delta_count = 20,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderChamb_Code, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_chamb_code_decoder = {
     .alloc = subghz_protocol_decoder_chamb_code_alloc,
     .free = subghz_protocol_decoder_chamb_code_free,
@@ -77,6 +86,8 @@ const SubGhzProtocolDecoder subghz_protocol_chamb_code_decoder = {
     .serialize = subghz_protocol_decoder_chamb_code_serialize,
     .deserialize = subghz_protocol_decoder_chamb_code_deserialize,
     .get_string = subghz_protocol_decoder_chamb_code_get_string,
+
+    .envelope = &subghz_protocol_chamb_code_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_chamb_code_encoder = {
@@ -51,6 +51,15 @@ typedef enum {
     ClemsaDecoderStepCheckDuration,
 } ClemsaDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_clemsa_envelope = {
+    .timing = &subghz_protocol_clemsa_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 51,
+    .start_delta_count = 25,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderClemsa, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_clemsa_decoder = {
     .alloc = subghz_protocol_decoder_clemsa_alloc,
     .free = subghz_protocol_decoder_clemsa_free,
@@ -62,6 +71,8 @@ const SubGhzProtocolDecoder subghz_protocol_clemsa_decoder = {
     .serialize = subghz_protocol_decoder_clemsa_serialize,
     .deserialize = subghz_protocol_decoder_clemsa_deserialize,
     .get_string = subghz_protocol_decoder_clemsa_get_string,
+
+    .envelope = &subghz_protocol_clemsa_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_clemsa_encoder = {
@@ -43,6 +43,15 @@ typedef enum {
     DoitrandDecoderStepCheckDuration,
 } DoitrandDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_doitrand_envelope = {
+    .timing = &subghz_protocol_doitrand_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 62,
+    .start_delta_count = 30,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderDoitrand, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_doitrand_decoder = {
     .alloc = subghz_protocol_decoder_doitrand_alloc,
     .free = subghz_protocol_decoder_doitrand_free,
@@ -54,6 +63,8 @@ const SubGhzProtocolDecoder subghz_protocol_doitrand_decoder = {
     .serialize = subghz_protocol_decoder_doitrand_serialize,
     .deserialize = subghz_protocol_decoder_doitrand_deserialize,
     .get_string = subghz_protocol_decoder_doitrand_get_string,
+
+    .envelope = &subghz_protocol_doitrand_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_doitrand_encoder = {
@@ -37,6 +37,15 @@ typedef enum {
     DooyaDecoderStepCheckDuration,
 } DooyaDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_dooya_envelope = {
+    .timing = &subghz_protocol_dooya_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeLong,
+    .start_te_count = 12,
+    .start_delta_count = 20,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderDooya, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_dooya_decoder = {
     .alloc = subghz_protocol_decoder_dooya_alloc,
     .free = subghz_protocol_decoder_dooya_free,
@@ -48,6 +57,8 @@ const SubGhzProtocolDecoder subghz_protocol_dooya_decoder = {
     .serialize = subghz_protocol_decoder_dooya_serialize,
     .deserialize = subghz_protocol_decoder_dooya_deserialize,
     .get_string = subghz_protocol_decoder_dooya_get_string,
+
+    .envelope = &subghz_protocol_dooya_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_dooya_encoder = {
@@ -44,6 +44,15 @@ typedef enum {
     FaacSLHDecoderStepCheckDuration,
 } FaacSLHDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_faac_slh_envelope = {
+    .timing = &subghz_protocol_faac_slh_const,
+    .start_level = true,
+    .start_te = SubGhzProtocolEnvelopeTeLong,
+    .start_te_count = 2,
+    .start_delta_count = 3,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderFaacSLH, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_faac_slh_decoder = {
     .alloc = subghz_protocol_decoder_faac_slh_alloc,
     .free = subghz_protocol_decoder_faac_slh_free,
@@ -55,6 +64,8 @@ const SubGhzProtocolDecoder subghz_protocol_faac_slh_decoder = {
     .serialize = subghz_protocol_decoder_faac_slh_serialize,
     .deserialize = subghz_protocol_decoder_faac_slh_deserialize,
     .get_string = subghz_protocol_decoder_faac_slh_get_string,
+
+    .envelope = &subghz_protocol_faac_slh_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_faac_slh_encoder = {
@@ -36,6 +36,15 @@ typedef enum {
     GateTXDecoderStepCheckDuration,
 } GateTXDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_gate_tx_envelope = {
+    .timing = &subghz_protocol_gate_tx_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 47,
+    .start_delta_count = 47,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderGateTx, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_gate_tx_decoder = {
     .alloc = subghz_protocol_decoder_gate_tx_alloc,
     .free = subghz_protocol_decoder_gate_tx_free,
@@ -47,6 +56,8 @@ const SubGhzProtocolDecoder subghz_protocol_gate_tx_decoder = {
     .serialize = subghz_protocol_decoder_gate_tx_serialize,
     .deserialize = subghz_protocol_decoder_gate_tx_deserialize,
     .get_string = subghz_protocol_decoder_gate_tx_get_string,
+
+    .envelope = &subghz_protocol_gate_tx_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_gate_tx_encoder = {
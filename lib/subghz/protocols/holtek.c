@@ -46,6 +46,15 @@ typedef enum {
     HoltekDecoderStepCheckDuration,
 } HoltekDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_holtek_envelope = {
+    .timing = &subghz_protocol_holtek_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 36,
+    .start_delta_count = 36,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderHoltek, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_holtek_decoder = {
     .alloc = subghz_protocol_decoder_holtek_alloc,
     .free = subghz_protocol_decoder_holtek_free,
@@ -57,6 +66,8 @@ const SubGhzProtocolDecoder subghz_protocol_holtek_decoder = {
     .serialize = subghz_protocol_decoder_holtek_serialize,
     .deserialize = subghz_protocol_decoder_holtek_deserialize,
     .get_string = subghz_protocol_decoder_holtek_get_string,
+
+    .envelope = &subghz_protocol_holtek_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_holtek_encoder = {
@@ -53,6 +53,15 @@ typedef enum {
     Holtek_HT12XDecoderStepCheckDuration,
 } Holtek_HT12XDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_holtek_th12x_envelope = {
+    .timing = &subghz_protocol_holtek_th12x_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 36,
+    .start_delta_count = 36,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderHoltek_HT12X, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_holtek_th12x_decoder = {
     .alloc = subghz_protocol_decoder_holtek_th12x_alloc,
     .free = subghz_protocol_decoder_holtek_th12x_free,
@@ -64,6 +73,8 @@ const SubGhzProtocolDecoder subghz_protocol_holtek_th12x_decoder = {
     .serialize = subghz_protocol_decoder_holtek_th12x_serialize,
     .deserialize = subghz_protocol_decoder_holtek_th12x_deserialize,
     .get_string = subghz_protocol_decoder_holtek_th12x_get_string,
+
+    .envelope = &subghz_protocol_holtek_th12x_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_holtek_th12x_encoder = {
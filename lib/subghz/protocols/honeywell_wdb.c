@@ -47,6 +47,15 @@ typedef enum {
     Honeywell_WDBDecoderStepCheckDuration,
 } Honeywell_WDBDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_honeywell_wdb_envelope = {
+    .timing = &subghz_protocol_honeywell_wdb_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 3,
+    .start_delta_count = 1,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderHoneywell_WDB, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_honeywell_wdb_decoder = {
     .alloc = subghz_protocol_decoder_honeywell_wdb_alloc,
     .free = subghz_protocol_decoder_honeywell_wdb_free,
@@ -58,6 +67,8 @@ const SubGhzProtocolDecoder subghz_protocol_honeywell_wdb_decoder = {
     .serialize = subghz_protocol_decoder_honeywell_wdb_serialize,
     .deserialize = subghz_protocol_decoder_honeywell_wdb_deserialize,
     .get_string = subghz_protocol_decoder_honeywell_wdb_get_string,
+
+    .envelope = &subghz_protocol_honeywell_wdb_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_honeywell_wdb_encoder = {
@@ -40,6 +40,15 @@ typedef enum {
     HormannDecoderStepCheckDuration,
 } HormannDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_hormann_envelope = {
+    .timing = &subghz_protocol_hormann_const,
+    .start_level = true,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 24,
+    .start_delta_count = 24,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderHormann, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_hormann_decoder = {
     .alloc = subghz_protocol_decoder_hormann_alloc,
     .free = subghz_protocol_decoder_hormann_free,
@@ -51,6 +60,8 @@ const SubGhzProtocolDecoder subghz_protocol_hormann_decoder = {
     .serialize = subghz_protocol_decoder_hormann_serialize,
     .deserialize = subghz_protocol_decoder_hormann_deserialize,
     .get_string = subghz_protocol_decoder_hormann_get_string,
+
+    .envelope = &subghz_protocol_hormann_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_hormann_encoder = {
@@ -36,6 +36,15 @@ typedef enum {
     IDoDecoderStepCheckDuration,
 } IDoDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_ido_envelope = {
+    .timing = &subghz_protocol_ido_const,
+    .start_level = true,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 10,
+    .start_delta_count = 5,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderIDo, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_ido_decoder = {
     .alloc = subghz_protocol_decoder_ido_alloc,
     .free = subghz_protocol_decoder_ido_free,
@@ -47,6 +56,8 @@ const SubGhzProtocolDecoder subghz_protocol_ido_decoder = {
     .deserialize = subghz_protocol_decoder_ido_deserialize,
     .serialize = subghz_protocol_decoder_ido_serialize,
     .get_string = subghz_protocol_decoder_ido_get_string,
+
+    .envelope = &subghz_protocol_ido_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_ido_encoder = {
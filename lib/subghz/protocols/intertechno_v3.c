@@ -45,6 +45,15 @@ typedef enum {
     IntertechnoV3DecoderStepEndDuration,
 } IntertechnoV3DecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_intertechno_v3_envelope = {
+    .timing = &subghz_protocol_intertechno_v3_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 37,
+    .start_delta_count = 15,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderIntertechno_V3, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_intertechno_v3_decoder = {
     .alloc = subghz_protocol_decoder_intertechno_v3_alloc,
     .free = subghz_protocol_decoder_intertechno_v3_free,
@@ -56,6 +65,8 @@ const SubGhzProtocolDecoder subghz_protocol_intertechno_v3_decoder = {
     .serialize = subghz_protocol_decoder_intertechno_v3_serialize,
     .deserialize = subghz_protocol_decoder_intertechno_v3_deserialize,
     .get_string = subghz_protocol_decoder_intertechno_v3_get_string,
+
+    .envelope = &subghz_protocol_intertechno_v3_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_intertechno_v3_encoder = {
@@ -54,6 +54,15 @@ typedef enum {
     KeeloqDecoderStepCheckDuration,
 } KeeloqDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_keeloq_envelope = {
+    .timing = &subghz_protocol_keeloq_const,
+    .start_level = true,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 1,
+    .start_delta_count = 1,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderKeeloq, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_keeloq_decoder = {
     .alloc = subghz_protocol_decoder_keeloq_alloc,
     .free = subghz_protocol_decoder_keeloq_free,
@@ -65,6 +74,8 @@ const SubGhzProtocolDecoder subghz_protocol_keeloq_decoder = {
     .serialize = subghz_protocol_decoder_keeloq_serialize,
     .deserialize = subghz_protocol_decoder_keeloq_deserialize,
     .get_string = subghz_protocol_decoder_keeloq_get_string,
+
+    .envelope = &subghz_protocol_keeloq_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_keeloq_encoder = {
@@ -728,19 +739,34 @@ static inline bool subghz_protocol_keeloq_check_decrypt_centurion(
 }
 
 /** 
- * Checking the accepted code against the database manafacture key
+ * Decrypt hop with the manufacture key, counting attempts
+ * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param hop Hop encrypted part of the parcel
+ * @param key Manufacture key
+ * @return Decrypted data
+ */
+static inline uint32_t
+    subghz_protocol_keeloq_keystore_decrypt(SubGhzKeystore* keystore, uint32_t hop, uint64_t key) {
+    keystore->kl_stats.attempts_last++;
+    return subghz_protocol_keeloq_common_decrypt(hop, key);
+}
+
+/** 
+ * Checking the accepted code against one manufacture key, all learning types of the key
  * @param instance Pointer to a SubGhzBlockGeneric* instance
  * @param fix Fix part of the parcel
  * @param hop Hop encrypted part of the parcel
  * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param manufacture_code Manufacture key
  * @param manufacture_name 
- * @return true on successful search
+ * @return true on success
  */
-static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
+static bool subghz_protocol_keeloq_check_manufacture_code(
     SubGhzBlockGeneric* instance,
     uint32_t fix,
     uint32_t hop,
     SubGhzKeystore* keystore,
+    const SubGhzKey* manufacture_code,
     const char** manufacture_name) {
     // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
     // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
@@ -750,7 +776,198 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     uint8_t btn = (uint8_t)(fix >> 28);
     uint32_t decrypt = 0;
     uint64_t man;
-    bool mf_not_set = false;
+
+    switch(manufacture_code->type) {
+    case KEELOQ_LEARNING_SIMPLE:
+        // Simple Learning
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, manufacture_code->key);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_NORMAL:
+        // Normal Learning
+        // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+        man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, man);
+        if((strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0)) {
+            if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
+                *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                keystore->mfname = *manufacture_name;
+                return true;
+            }
+        } else {
+            if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                keystore->mfname = *manufacture_name;
+                return true;
+            }
+        }
+        break;
+    case KEELOQ_LEARNING_SECURE:
+        man = subghz_protocol_keeloq_common_secure_learning(
+            fix, instance->seed, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+        man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+        man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
+            fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+        man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
+            fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+        man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
+            fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_UNKNOWN:
+        // Simple Learning
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, manufacture_code->key);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 1;
+            return true;
+        }
+
+        // Check for mirrored man
+        uint64_t man_rev = 0;
+        uint64_t man_rev_byte = 0;
+        for(uint8_t i = 0; i < 64; i += 8) {
+            man_rev_byte = (uint8_t)(manufacture_code->key >> i);
+            man_rev = man_rev | man_rev_byte << (56 - i);
+        }
+
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, man_rev);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 1;
+            return true;
+        }
+
+        //###########################
+        // Normal Learning
+        // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+        man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 2;
+            return true;
+        }
+
+        // Check for mirrored man
+        man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 2;
+            return true;
+        }
+
+        // Secure Learning
+        man = subghz_protocol_keeloq_common_secure_learning(
+            fix, instance->seed, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 3;
+            return true;
+        }
+
+        // Check for mirrored man
+        man = subghz_protocol_keeloq_common_secure_learning(fix, instance->seed, man_rev);
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 3;
+            return true;
+        }
+
+        // Magic xor type1 learning
+        man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 4;
+            return true;
+        }
+
+        // Check for mirrored man
+        man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
+        decrypt = subghz_protocol_keeloq_keystore_decrypt(keystore, hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 4;
+            return true;
+        }
+
+        break;
+    }
+
+    return false;
+}
+
+/** 
+ * Checking the accepted code against the database manafacture key
+ * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param fix Fix part of the parcel
+ * @param hop Hop encrypted part of the parcel
+ * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param manufacture_name 
+ * @return true on successful search
+ */
+static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint32_t hop,
+    SubGhzKeystore* keystore,
+    const char** manufacture_name) {
+    SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+    SubGhzKeystoreKlStats* stats = &keystore->kl_stats;
+    bool found = false;
     // TODO:
     // if(mfname == 0x0) {
     //     mfname = "";
@@ -760,189 +977,70 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
 
     if(strcmp(mfname, "Unknown") == 0) {
         return 1;
-    } else if(strcmp(mfname, "") == 0) {
-        mf_not_set = true;
     }
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if((strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0)) {
-                        if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    } else {
-                        if(subghz_protocol_keeloq_check_decrypt(
-                               instance, decrypt, btn, end_serial)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    }
-                    break;
-                case KEELOQ_LEARNING_SECURE:
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                    man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                    man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    uint64_t man_rev = 0;
-                    uint64_t man_rev_byte = 0;
-                    for(uint8_t i = 0; i < 64; i += 8) {
-                        man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev | man_rev_byte << (56 - i);
-                    }
-
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
 
-                    //###########################
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Secure Learning
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Magic xor type1 learning
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
+    stats->attempts_last = 0;
+    if(strcmp(mfname, "") == 0) {
+        // Remotes repeat the same parcel while the button is held and keep the manufacture key
+        // between presses, so remember the key that decoded this serial number last time.
+        SubGhzKeystoreKlCache* cache = subghz_keystore_get_kl_cache(keystore, fix);
+        bool serial_cached = cache->valid && ((cache->fix ^ fix) & 0x0FFFFFFF) == 0 &&
+                             cache->seed == instance->seed;
+        bool parcel_cached = serial_cached && cache->fix == fix && cache->hop == hop;
+
+        if(serial_cached && cache->key_index != SUBGHZ_KEYSTORE_INDEX_NONE) {
+            found = subghz_protocol_keeloq_check_manufacture_code(
+                instance,
+                fix,
+                hop,
+                keystore,
+                SubGhzKeyArray_cget(*keys, cache->key_index),
+                manufacture_name);
+        }
 
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
+        if(found || parcel_cached) {
+            stats->cache_hits++;
+        } else {
+            size_t key_index = 0;
+            for
+                M_EACH(manufacture_code, *keys, SubGhzKeyArray_t) {
+                    if(subghz_protocol_keeloq_check_manufacture_code(
+                           instance, fix, hop, keystore, manufacture_code, manufacture_name)) {
+                        found = true;
+                        break;
                     }
-
-                    break;
+                    key_index++;
                 }
+            cache->key_index = found ? key_index : SUBGHZ_KEYSTORE_INDEX_NONE;
+        }
+
+        cache->fix = fix;
+        cache->hop = hop;
+        cache->seed = instance->seed;
+        cache->valid = true;
+    } else {
+        for(size_t i = subghz_keystore_find_first(keystore, mfname);
+            i != SUBGHZ_KEYSTORE_INDEX_NONE;
+            i = subghz_keystore_find_next(keystore, i)) {
+            if(subghz_protocol_keeloq_check_manufacture_code(
+                   instance,
+                   fix,
+                   hop,
+                   keystore,
+                   SubGhzKeyArray_cget(*keys, i),
+                   manufacture_name)) {
+                found = true;
+                break;
             }
         }
+    }
+
+    stats->packets++;
+    stats->attempts += stats->attempts_last;
+    stats->attempts_max = MAX(stats->attempts_max, stats->attempts_last);
+    FURI_LOG_D(TAG, "Decrypt attempts: %lu", stats->attempts_last);
+
+    if(found) return 1;
 
     *manufacture_name = "Unknown";
     keystore->mfname = "Unknown";
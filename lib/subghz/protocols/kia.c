@@ -38,6 +38,15 @@ typedef enum {
     KIADecoderStepCheckDuration,
 } KIADecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_kia_envelope = {
+    .timing = &subghz_protocol_kia_const,
+    .start_level = true,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 1,
+    .start_delta_count = 1,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderKIA, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_kia_decoder = {
     .alloc = subghz_protocol_decoder_kia_alloc,
     .free = subghz_protocol_decoder_kia_free,
@@ -49,6 +58,8 @@ const SubGhzProtocolDecoder subghz_protocol_kia_decoder = {
     .serialize = subghz_protocol_decoder_kia_serialize,
     .deserialize = subghz_protocol_decoder_kia_deserialize,
     .get_string = subghz_protocol_decoder_kia_get_string,
+
+    .envelope = &subghz_protocol_kia_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_kia_encoder = {
@@ -43,6 +43,15 @@ typedef enum {
     KingGates_stylo_4kDecoderStepCheckDuration,
 } KingGates_stylo_4kDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_kinggates_stylo_4k_envelope = {
+    .timing = &subghz_protocol_kinggates_stylo_4k_const,
+    .start_level = true,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 1,
+    .start_delta_count = 1,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderKingGates_stylo_4k, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_kinggates_stylo_4k_decoder = {
     .alloc = subghz_protocol_decoder_kinggates_stylo_4k_alloc,
     .free = subghz_protocol_decoder_kinggates_stylo_4k_free,
@@ -54,6 +63,8 @@ const SubGhzProtocolDecoder subghz_protocol_kinggates_stylo_4k_decoder = {
     .serialize = subghz_protocol_decoder_kinggates_stylo_4k_serialize,
     .deserialize = subghz_protocol_decoder_kinggates_stylo_4k_deserialize,
     .get_string = subghz_protocol_decoder_kinggates_stylo_4k_get_string,
+
+    .envelope = &subghz_protocol_kinggates_stylo_4k_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_kinggates_stylo_4k_encoder = {
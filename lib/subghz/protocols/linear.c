@@ -42,6 +42,15 @@ typedef enum {
     LinearDecoderStepCheckDuration,
 } LinearDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_linear_envelope = {
+    .timing = &subghz_protocol_linear_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 42,
+    .start_delta_count = 20,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderLinear, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_linear_decoder = {
     .alloc = subghz_protocol_decoder_linear_alloc,
     .free = subghz_protocol_decoder_linear_free,
@@ -53,6 +62,8 @@ const SubGhzProtocolDecoder subghz_protocol_linear_decoder = {
     .serialize = subghz_protocol_decoder_linear_serialize,
     .deserialize = subghz_protocol_decoder_linear_deserialize,
     .get_string = subghz_protocol_decoder_linear_get_string,
+
+    .envelope = &subghz_protocol_linear_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_linear_encoder = {
@@ -43,6 +43,15 @@ typedef enum {
     LinearDecoderStepCheckDuration,
 } LinearDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_linear_delta3_envelope = {
+    .timing = &subghz_protocol_linear_delta3_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 70,
+    .start_delta_count = 24,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderLinearDelta3, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_linear_delta3_decoder = {
     .alloc = subghz_protocol_decoder_linear_delta3_alloc,
     .free = subghz_protocol_decoder_linear_delta3_free,
@@ -54,6 +63,8 @@ const SubGhzProtocolDecoder subghz_protocol_linear_delta3_decoder = {
     .serialize = subghz_protocol_decoder_linear_delta3_serialize,
     .deserialize = subghz_protocol_decoder_linear_delta3_deserialize,
     .get_string = subghz_protocol_decoder_linear_delta3_get_string,
+
+    .envelope = &subghz_protocol_linear_delta3_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_linear_delta3_encoder = {
@@ -38,6 +38,15 @@ typedef enum {
     MagellanDecoderStepCheckDuration,
 } MagellanDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_magellan_envelope = {
+    .timing = &subghz_protocol_magellan_const,
+    .start_level = true,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 1,
+    .start_delta_count = 1,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderMagellan, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_magellan_decoder = {
     .alloc = subghz_protocol_decoder_magellan_alloc,
     .free = subghz_protocol_decoder_magellan_free,
@@ -49,6 +58,8 @@ const SubGhzProtocolDecoder subghz_protocol_magellan_decoder = {
     .serialize = subghz_protocol_decoder_magellan_serialize,
     .deserialize = subghz_protocol_decoder_magellan_deserialize,
     .get_string = subghz_protocol_decoder_magellan_get_string,
+
+    .envelope = &subghz_protocol_magellan_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_magellan_encoder = {
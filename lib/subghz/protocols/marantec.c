@@ -38,6 +38,15 @@ typedef enum {
     MarantecDecoderStepDecoderData,
 } MarantecDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_marantec_envelope = {
+    .timing = &subghz_protocol_marantec_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeLong,
+    .start_te_count = 5,
+    .start_delta_count = 8,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderMarantec, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_marantec_decoder = {
     .alloc = subghz_protocol_decoder_marantec_alloc,
     .free = subghz_protocol_decoder_marantec_free,
@@ -49,6 +58,8 @@ const SubGhzProtocolDecoder subghz_protocol_marantec_decoder = {
     .serialize = subghz_protocol_decoder_marantec_serialize,
     .deserialize = subghz_protocol_decoder_marantec_deserialize,
     .get_string = subghz_protocol_decoder_marantec_get_string,
+
+    .envelope = &subghz_protocol_marantec_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_marantec_encoder = {
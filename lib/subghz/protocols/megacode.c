@@ -48,6 +48,15 @@ typedef enum {
     MegaCodeDecoderStepCheckDuration,
 } MegaCodeDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_megacode_envelope = {
+    .timing = &subghz_protocol_megacode_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 13,
+    .start_delta_count = 17,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderMegaCode, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_megacode_decoder = {
     .alloc = subghz_protocol_decoder_megacode_alloc,
     .free = subghz_protocol_decoder_megacode_free,
@@ -59,6 +68,8 @@ const SubGhzProtocolDecoder subghz_protocol_megacode_decoder = {
     .serialize = subghz_protocol_decoder_megacode_serialize,
     .deserialize = subghz_protocol_decoder_megacode_deserialize,
     .get_string = subghz_protocol_decoder_megacode_get_string,
+
+    .envelope = &subghz_protocol_megacode_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_megacode_encoder = {
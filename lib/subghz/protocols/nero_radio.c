@@ -38,6 +38,15 @@ typedef enum {
     NeroRadioDecoderStepCheckDuration,
 } NeroRadioDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_nero_radio_envelope = {
+    .timing = &subghz_protocol_nero_radio_const,
+    .start_level = true,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 1,
+    .start_delta_count = 1,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderNeroRadio, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_nero_radio_decoder = {
     .alloc = subghz_protocol_decoder_nero_radio_alloc,
     .free = subghz_protocol_decoder_nero_radio_free,
@@ -49,6 +58,8 @@ const SubGhzProtocolDecoder subghz_protocol_nero_radio_decoder = {
     .serialize = subghz_protocol_decoder_nero_radio_serialize,
     .deserialize = subghz_protocol_decoder_nero_radio_deserialize,
     .get_string = subghz_protocol_decoder_nero_radio_get_string,
+
+    .envelope = &subghz_protocol_nero_radio_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nero_radio_encoder = {
@@ -37,6 +37,15 @@ typedef enum {
     NeroSketchDecoderStepCheckDuration,
 } NeroSketchDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_nero_sketch_envelope = {
+    .timing = &subghz_protocol_nero_sketch_const,
+    .start_level = true,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 1,
+    .start_delta_count = 1,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderNeroSketch, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_nero_sketch_decoder = {
     .alloc = subghz_protocol_decoder_nero_sketch_alloc,
     .free = subghz_protocol_decoder_nero_sketch_free,
@@ -48,6 +57,8 @@ const SubGhzProtocolDecoder subghz_protocol_nero_sketch_decoder = {
     .serialize = subghz_protocol_decoder_nero_sketch_serialize,
     .deserialize = subghz_protocol_decoder_nero_sketch_deserialize,
     .get_string = subghz_protocol_decoder_nero_sketch_get_string,
+
+    .envelope = &subghz_protocol_nero_sketch_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nero_sketch_encoder = {
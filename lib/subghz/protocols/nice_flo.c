@@ -35,6 +35,15 @@ typedef enum {
     NiceFloDecoderStepCheckDuration,
 } NiceFloDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_nice_flo_envelope = {
+    .timing = &subghz_protocol_nice_flo_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 36,
+    .start_delta_count = 36,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderNiceFlo, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_nice_flo_decoder = {
     .alloc = subghz_protocol_decoder_nice_flo_alloc,
     .free = subghz_protocol_decoder_nice_flo_free,
@@ -46,6 +55,8 @@ const SubGhzProtocolDecoder subghz_protocol_nice_flo_decoder = {
     .serialize = subghz_protocol_decoder_nice_flo_serialize,
     .deserialize = subghz_protocol_decoder_nice_flo_deserialize,
     .get_string = subghz_protocol_decoder_nice_flo_get_string,
+
+    .envelope = &subghz_protocol_nice_flo_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nice_flo_encoder = {
@@ -53,6 +53,15 @@ typedef enum {
     NiceFlorSDecoderStepCheckDuration,
 } NiceFlorSDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_nice_flor_s_envelope = {
+    .timing = &subghz_protocol_nice_flor_s_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 38,
+    .start_delta_count = 38,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderNiceFlorS, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_nice_flor_s_decoder = {
     .alloc = subghz_protocol_decoder_nice_flor_s_alloc,
     .free = subghz_protocol_decoder_nice_flor_s_free,
@@ -64,6 +73,8 @@ const SubGhzProtocolDecoder subghz_protocol_nice_flor_s_decoder = {
     .serialize = subghz_protocol_decoder_nice_flor_s_serialize,
     .deserialize = subghz_protocol_decoder_nice_flor_s_deserialize,
     .get_string = subghz_protocol_decoder_nice_flor_s_get_string,
+
+    .envelope = &subghz_protocol_nice_flor_s_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nice_flor_s_encoder = {
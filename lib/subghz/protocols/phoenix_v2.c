@@ -38,6 +38,15 @@ typedef enum {
     Phoenix_V2DecoderStepCheckDuration,
 } Phoenix_V2DecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_phoenix_v2_envelope = {
+    .timing = &subghz_protocol_phoenix_v2_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 60,
+    .start_delta_count = 30,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderPhoenix_V2, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_phoenix_v2_decoder = {
     .alloc = subghz_protocol_decoder_phoenix_v2_alloc,
     .free = subghz_protocol_decoder_phoenix_v2_free,
@@ -49,6 +58,8 @@ const SubGhzProtocolDecoder subghz_protocol_phoenix_v2_decoder = {
     .serialize = subghz_protocol_decoder_phoenix_v2_serialize,
     .deserialize = subghz_protocol_decoder_phoenix_v2_deserialize,
     .get_string = subghz_protocol_decoder_phoenix_v2_get_string,
+
+    .envelope = &subghz_protocol_phoenix_v2_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_phoenix_v2_encoder = {
@@ -46,6 +46,15 @@ typedef enum {
     PrincetonDecoderStepCheckDuration,
 } PrincetonDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_princeton_envelope = {
+    .timing = &subghz_protocol_princeton_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 36,
+    .start_delta_count = 36,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderPrinceton, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_princeton_decoder = {
     .alloc = subghz_protocol_decoder_princeton_alloc,
     .free = subghz_protocol_decoder_princeton_free,
@@ -57,6 +66,8 @@ const SubGhzProtocolDecoder subghz_protocol_princeton_decoder = {
     .serialize = subghz_protocol_decoder_princeton_serialize,
     .deserialize = subghz_protocol_decoder_princeton_deserialize,
     .get_string = subghz_protocol_decoder_princeton_get_string,
+
+    .envelope = &subghz_protocol_princeton_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_princeton_encoder = {
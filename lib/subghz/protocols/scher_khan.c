@@ -44,6 +44,15 @@ typedef enum {
     ScherKhanDecoderStepCheckDuration,
 } ScherKhanDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_scher_khan_envelope = {
+    .timing = &subghz_protocol_scher_khan_const,
+    .start_level = true,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 2,
+    .start_delta_count = 1,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderScherKhan, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_scher_khan_decoder = {
     .alloc = subghz_protocol_decoder_scher_khan_alloc,
     .free = subghz_protocol_decoder_scher_khan_free,
@@ -55,6 +64,8 @@ const SubGhzProtocolDecoder subghz_protocol_scher_khan_decoder = {
     .serialize = subghz_protocol_decoder_scher_khan_serialize,
     .deserialize = subghz_protocol_decoder_scher_khan_deserialize,
     .get_string = subghz_protocol_decoder_scher_khan_get_string,
+
+    .envelope = &subghz_protocol_scher_khan_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_scher_khan_encoder = {
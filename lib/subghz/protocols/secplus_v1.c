@@ -59,6 +59,15 @@ typedef enum {
     SecPlus_v1DecoderStepDecoderData,
 } SecPlus_v1DecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_secplus_v1_envelope = {
+    .timing = &subghz_protocol_secplus_v1_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 120,
+    .start_delta_count = 120,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderSecPlus_v1, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_secplus_v1_decoder = {
     .alloc = subghz_protocol_decoder_secplus_v1_alloc,
     .free = subghz_protocol_decoder_secplus_v1_free,
@@ -70,6 +79,8 @@ const SubGhzProtocolDecoder subghz_protocol_secplus_v1_decoder = {
     .serialize = subghz_protocol_decoder_secplus_v1_serialize,
     .deserialize = subghz_protocol_decoder_secplus_v1_deserialize,
     .get_string = subghz_protocol_decoder_secplus_v1_get_string,
+
+    .envelope = &subghz_protocol_secplus_v1_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_secplus_v1_encoder = {
@@ -53,6 +53,15 @@ typedef enum {
     SecPlus_v2DecoderStepDecoderData,
 } SecPlus_v2DecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_secplus_v2_envelope = {
+    .timing = &subghz_protocol_secplus_v2_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeLong,
+    .start_te_count = 130,
+    .start_delta_count = 100,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderSecPlus_v2, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_secplus_v2_decoder = {
     .alloc = subghz_protocol_decoder_secplus_v2_alloc,
     .free = subghz_protocol_decoder_secplus_v2_free,
@@ -64,6 +73,8 @@ const SubGhzProtocolDecoder subghz_protocol_secplus_v2_decoder = {
     .serialize = subghz_protocol_decoder_secplus_v2_serialize,
     .deserialize = subghz_protocol_decoder_secplus_v2_deserialize,
     .get_string = subghz_protocol_decoder_secplus_v2_get_string,
+
+    .envelope = &subghz_protocol_secplus_v2_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_secplus_v2_encoder = {
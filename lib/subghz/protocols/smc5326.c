@@ -61,6 +61,15 @@ typedef enum {
     SMC5326DecoderStepCheckDuration,
 } SMC5326DecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_smc5326_envelope = {
+    .timing = &subghz_protocol_smc5326_const,
+    .start_level = false,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 24,
+    .start_delta_count = 12,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderSMC5326, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_smc5326_decoder = {
     .alloc = subghz_protocol_decoder_smc5326_alloc,
     .free = subghz_protocol_decoder_smc5326_free,
@@ -72,6 +81,8 @@ const SubGhzProtocolDecoder subghz_protocol_smc5326_decoder = {
     .serialize = subghz_protocol_decoder_smc5326_serialize,
     .deserialize = subghz_protocol_decoder_smc5326_deserialize,
     .get_string = subghz_protocol_decoder_smc5326_get_string,
+
+    .envelope = &subghz_protocol_smc5326_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_smc5326_encoder = {
@@ -42,6 +42,15 @@ typedef enum {
     SomfyKeytisDecoderStepDecoderData,
 } SomfyKeytisDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_somfy_keytis_envelope = {
+    .timing = &subghz_protocol_somfy_keytis_const,
+    .start_level = true,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 4,
+    .start_delta_count = 4,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderSomfyKeytis, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_somfy_keytis_decoder = {
     .alloc = subghz_protocol_decoder_somfy_keytis_alloc,
     .free = subghz_protocol_decoder_somfy_keytis_free,
@@ -53,6 +62,8 @@ const SubGhzProtocolDecoder subghz_protocol_somfy_keytis_decoder = {
     .serialize = subghz_protocol_decoder_somfy_keytis_serialize,
     .deserialize = subghz_protocol_decoder_somfy_keytis_deserialize,
     .get_string = subghz_protocol_decoder_somfy_keytis_get_string,
+
+    .envelope = &subghz_protocol_somfy_keytis_envelope,
 };
 
 const SubGhzProtocol subghz_protocol_somfy_keytis = {
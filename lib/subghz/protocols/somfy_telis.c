@@ -43,6 +43,15 @@ typedef enum {
     SomfyTelisDecoderStepDecoderData,
 } SomfyTelisDecoderStep;
 
+static const SubGhzProtocolDecoderEnvelope subghz_protocol_somfy_telis_envelope = {
+    .timing = &subghz_protocol_somfy_telis_const,
+    .start_level = true,
+    .start_te = SubGhzProtocolEnvelopeTeShort,
+    .start_te_count = 4,
+    .start_delta_count = 4,
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderSomfyTelis, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_somfy_telis_decoder = {
     .alloc = subghz_protocol_decoder_somfy_telis_alloc,
     .free = subghz_protocol_decoder_somfy_telis_free,
@@ -54,6 +63,8 @@ const SubGhzProtocolDecoder subghz_protocol_somfy_telis_decoder = {
     .serialize = subghz_protocol_decoder_somfy_telis_serialize,
     .deserialize = subghz_protocol_decoder_somfy_telis_deserialize,
     .get_string = subghz_protocol_decoder_somfy_telis_get_string,
+
+    .envelope = &subghz_protocol_somfy_telis_envelope,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_somfy_telis_encoder = {
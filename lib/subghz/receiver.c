@@ -7,6 +7,14 @@
 
 typedef struct {
     SubGhzProtocolEncoderBase* base;
+    SubGhzDecoderFeed feed;
+    bool enabled;
+
+    // Start window from the protocol envelope, parser_step is NULL without envelope
+    const uint32_t* parser_step;
+    bool start_level;
+    uint32_t start_min;
+    uint32_t start_max;
 } SubGhzReceiverSlot;
 
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
@@ -20,6 +28,28 @@ struct SubGhzReceiver {
     void* context;
 };
 
+static void subghz_receiver_slot_init(SubGhzReceiverSlot* slot, const SubGhzProtocol* protocol) {
+    const SubGhzProtocolDecoderEnvelope* envelope = protocol->decoder->envelope;
+
+    slot->feed = protocol->decoder->feed;
+    slot->enabled = false;
+    slot->parser_step = NULL;
+
+    if(envelope) {
+        uint32_t te = (envelope->start_te == SubGhzProtocolEnvelopeTeShort) ?
+                          envelope->timing->te_short :
+                          envelope->timing->te_long;
+        uint32_t center = te * envelope->start_te_count;
+        uint32_t delta = (uint32_t)envelope->timing->te_delta * envelope->start_delta_count;
+
+        // DURATION_DIFF(duration, center) < delta
+        slot->parser_step = (const uint32_t*)((uint8_t*)slot->base + envelope->parser_step_offset);
+        slot->start_level = envelope->start_level;
+        slot->start_min = (center > delta) ? (center - delta + 1) : 0;
+        slot->start_max = center + delta;
+    }
+}
+
 SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
     SubGhzReceiver* instance = malloc(sizeof(SubGhzReceiver));
     SubGhzReceiverSlotArray_init(instance->slots);
@@ -33,9 +63,11 @@ SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
         if(protocol->decoder && protocol->decoder->alloc) {
             SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_push_new(instance->slots);
             slot->base = protocol->decoder->alloc(environment);
+            subghz_receiver_slot_init(slot, protocol);
         }
     }
 
+    instance->filter = 0;
     instance->callback = NULL;
     instance->context = NULL;
     return instance;
@@ -64,9 +96,14 @@ void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t durat
 
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if((slot->base->protocol->flag & instance->filter) != 0) {
-                slot->base->protocol->decoder->feed(slot->base, level, duration);
+            if(!slot->enabled) continue;
+            // Idle decoder ignores everything except the pulse that starts a packet
+            if(slot->parser_step && (*slot->parser_step == 0) &&
+               ((level != slot->start_level) || (duration < slot->start_min) ||
+                (duration >= slot->start_max))) {
+                continue;
             }
+            slot->feed(slot->base, level, duration);
         }
 }
 
@@ -106,6 +143,11 @@ void subghz_receiver_set_rx_callback(
 void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag filter) {
     furi_assert(instance);
     instance->filter = filter;
+
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            slot->enabled = (slot->base->protocol->flag & filter) != 0;
+        }
 }
 
 SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
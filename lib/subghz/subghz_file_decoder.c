@@ -0,0 +1,177 @@
+#include "subghz_file_decoder.h"
+#include "receiver.h"
+
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+
+#define TAG "SubGhzFileDecoder"
+
+#define SUBGHZ_FILE_DECODER_CHUNK_SIZE (512)
+#define SUBGHZ_FILE_DECODER_DURATION_MAX (1000000)
+#define SUBGHZ_FILE_DECODER_DURATION_OVERFLOW (100)
+
+struct SubGhzFileDecoder {
+    SubGhzReceiver* receiver;
+    Storage* storage;
+    FlipperFormat* flipper_format;
+    int32_t* chunk;
+
+    bool is_running;
+    bool is_finished;
+    bool level;
+    uint32_t pulse_count;
+    uint32_t packet_count;
+
+    SubGhzFileDecoderCallback callback;
+    void* context;
+};
+
+static void subghz_file_decoder_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    SubGhzFileDecoder* instance = context;
+    instance->packet_count++;
+    if(instance->callback) {
+        instance->callback(decoder_base, instance->context);
+    }
+    subghz_receiver_reset(receiver);
+}
+
+SubGhzFileDecoder* subghz_file_decoder_alloc(SubGhzEnvironment* environment) {
+    furi_assert(environment);
+    SubGhzFileDecoder* instance = malloc(sizeof(SubGhzFileDecoder));
+
+    instance->receiver = subghz_receiver_alloc_init(environment);
+    subghz_receiver_set_filter(instance->receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_rx_callback(
+        instance->receiver, subghz_file_decoder_rx_callback, instance);
+
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->flipper_format = flipper_format_file_alloc(instance->storage);
+    instance->chunk = malloc(sizeof(int32_t) * SUBGHZ_FILE_DECODER_CHUNK_SIZE);
+
+    instance->is_running = false;
+    instance->callback = NULL;
+    instance->context = NULL;
+    return instance;
+}
+
+void subghz_file_decoder_free(SubGhzFileDecoder* instance) {
+    furi_assert(instance);
+    furi_assert(!instance->is_running);
+
+    free(instance->chunk);
+    flipper_format_free(instance->flipper_format);
+    furi_record_close(RECORD_STORAGE);
+    subghz_receiver_free(instance->receiver);
+    free(instance);
+}
+
+void subghz_file_decoder_set_callback(
+    SubGhzFileDecoder* instance,
+    SubGhzFileDecoderCallback callback,
+    void* context) {
+    furi_assert(instance);
+    instance->callback = callback;
+    instance->context = context;
+}
+
+bool subghz_file_decoder_start(SubGhzFileDecoder* instance, const char* file_path) {
+    furi_assert(instance);
+    furi_assert(!instance->is_running);
+
+    FuriString* temp_str = furi_string_alloc();
+    uint32_t temp_data32 = 0;
+
+    do {
+        if(!flipper_format_file_open_existing(instance->flipper_format, file_path)) {
+            FURI_LOG_E(TAG, "Error open file %s", file_path);
+            break;
+        }
+
+        if(!flipper_format_read_header(instance->flipper_format, temp_str, &temp_data32)) {
+            FURI_LOG_E(TAG, "Missing or incorrect header");
+            break;
+        }
+
+        if(furi_string_cmp_str(temp_str, SUBGHZ_RAW_FILE_TYPE) != 0 ||
+           temp_data32 != SUBGHZ_RAW_FILE_VERSION) {
+            FURI_LOG_E(TAG, "Type or version mismatch");
+            break;
+        }
+
+        instance->is_running = true;
+    } while(false);
+
+    furi_string_free(temp_str);
+
+    if(instance->is_running) {
+        subghz_receiver_reset(instance->receiver);
+        instance->is_finished = false;
+        instance->level = false;
+        instance->pulse_count = 0;
+        instance->packet_count = 0;
+    } else {
+        flipper_format_file_close(instance->flipper_format);
+    }
+
+    return instance->is_running;
+}
+
+size_t subghz_file_decoder_process(SubGhzFileDecoder* instance) {
+    furi_assert(instance);
+    if(!instance->is_running || instance->is_finished) return 0;
+
+    uint32_t count = 0;
+    if(!flipper_format_get_value_count(instance->flipper_format, "RAW_Data", &count)) return 0;
+    count = MIN(count, (uint32_t)SUBGHZ_FILE_DECODER_CHUNK_SIZE);
+    if(!flipper_format_read_int32(instance->flipper_format, "RAW_Data", instance->chunk, count)) {
+        return 0;
+    }
+
+    // Same rules as in SubGhzFileEncoderWorker
+    size_t decoded = 0;
+    for(size_t i = 0; i < count; i++) {
+        int32_t duration = instance->chunk[i];
+        if(duration == 0) {
+            instance->is_finished = true;
+            break;
+        } else if(duration < -SUBGHZ_FILE_DECODER_DURATION_MAX) {
+            duration = -SUBGHZ_FILE_DECODER_DURATION_OVERFLOW;
+        } else if(duration > SUBGHZ_FILE_DECODER_DURATION_MAX) {
+            duration = SUBGHZ_FILE_DECODER_DURATION_OVERFLOW;
+        }
+
+        bool level = duration > 0;
+        if(level == instance->level) {
+            FURI_LOG_E(TAG, "Invalid level in the stream");
+            continue;
+        }
+        instance->level = level;
+
+        subghz_receiver_decode(instance->receiver, level, level ? duration : -duration);
+        decoded++;
+    }
+
+    instance->pulse_count += decoded;
+    return count;
+}
+
+void subghz_file_decoder_stop(SubGhzFileDecoder* instance) {
+    furi_assert(instance);
+    if(instance->is_running) {
+        flipper_format_file_close(instance->flipper_format);
+        instance->is_running = false;
+    }
+}
+
+uint32_t subghz_file_decoder_get_pulse_count(SubGhzFileDecoder* instance) {
+    furi_assert(instance);
+    return instance->pulse_count;
+}
+
+uint32_t subghz_file_decoder_get_packet_count(SubGhzFileDecoder* instance) {
+    furi_assert(instance);
+    return instance->packet_count;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "types.h"
+#include "protocols/base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*SubGhzFileDecoderCallback)(SubGhzProtocolDecoderBase* decoder_base, void* context);
+
+typedef struct SubGhzFileDecoder SubGhzFileDecoder;
+
+/** 
+ * Allocate SubGhzFileDecoder.
+ * Decodes RAW files with all decodable protocols of the environment registry,
+ * without radio timing and worker thread.
+ * @param environment Pointer to a SubGhzEnvironment instance
+ * @return SubGhzFileDecoder* pointer to a SubGhzFileDecoder instance
+ */
+SubGhzFileDecoder* subghz_file_decoder_alloc(SubGhzEnvironment* environment);
+
+/** 
+ * Free SubGhzFileDecoder.
+ * @param instance Pointer to a SubGhzFileDecoder instance
+ */
+void subghz_file_decoder_free(SubGhzFileDecoder* instance);
+
+/** 
+ * Set a callback upon completion of successful decoding of one of the protocols.
+ * @param instance Pointer to a SubGhzFileDecoder instance
+ * @param callback Callback, SubGhzFileDecoderCallback
+ * @param context Context
+ */
+void subghz_file_decoder_set_callback(
+    SubGhzFileDecoder* instance,
+    SubGhzFileDecoderCallback callback,
+    void* context);
+
+/** 
+ * Open RAW file and reset decoders.
+ * @param instance Pointer to a SubGhzFileDecoder instance
+ * @param file_path Path to the RAW file
+ * @return true On success
+ */
+bool subghz_file_decoder_start(SubGhzFileDecoder* instance, const char* file_path);
+
+/** 
+ * Decode next chunk of the file.
+ * @param instance Pointer to a SubGhzFileDecoder instance
+ * @return Number of samples read, 0 at the end of the file
+ */
+size_t subghz_file_decoder_process(SubGhzFileDecoder* instance);
+
+/** 
+ * Close RAW file.
+ * @param instance Pointer to a SubGhzFileDecoder instance
+ */
+void subghz_file_decoder_stop(SubGhzFileDecoder* instance);
+
+/** 
+ * Get number of pulses decoded since start.
+ * @param instance Pointer to a SubGhzFileDecoder instance
+ * @return Pulse count
+ */
+uint32_t subghz_file_decoder_get_pulse_count(SubGhzFileDecoder* instance);
+
+/** 
+ * Get number of packets decoded since start.
+ * @param instance Pointer to a SubGhzFileDecoder instance
+ * @return Packet count
+ */
+uint32_t subghz_file_decoder_get_packet_count(SubGhzFileDecoder* instance);
+
+#ifdef __cplusplus
+}
+#endif
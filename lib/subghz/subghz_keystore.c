@@ -31,8 +31,11 @@ SubGhzKeystore* subghz_keystore_alloc() {
     SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
 
     SubGhzKeyArray_init(instance->data);
+    memset(&instance->name_index, 0, sizeof(SubGhzKeystoreNameIndex));
+    memset(instance->kl_cache, 0, sizeof(instance->kl_cache));
 
     subghz_keystore_reset_kl(instance);
+    subghz_keystore_reset_kl_stats(instance);
 
     return instance;
 }
@@ -54,9 +57,120 @@ void subghz_keystore_free(SubGhzKeystore* instance) {
         }
     SubGhzKeyArray_clear(instance->data);
 
+    free(instance->name_index.heads);
+    free(instance->name_index.next);
     free(instance);
 }
 
+static uint32_t subghz_keystore_name_hash(const char* name) {
+    // FNV-1a
+    uint32_t hash = 0x811C9DC5;
+    while(*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= 0x01000193;
+    }
+    return hash;
+}
+
+static void subghz_keystore_name_index_build(SubGhzKeystore* instance) {
+    SubGhzKeystoreNameIndex* index = &instance->name_index;
+    size_t size = SubGhzKeyArray_size(instance->data);
+
+    free(index->heads);
+    free(index->next);
+    index->heads = NULL;
+    index->next = NULL;
+    index->size = size;
+
+    // Chains hold 16-bit key indexes, larger keystores are searched linearly
+    if(size >= SUBGHZ_KEYSTORE_NAME_INDEX_END) {
+        FURI_LOG_W(TAG, "Too many keys for name index: %zu", size);
+        return;
+    }
+
+    size_t buckets = 16;
+    while(buckets < size / 2) buckets <<= 1;
+    index->heads = malloc(sizeof(uint16_t) * buckets);
+    index->next = malloc(sizeof(uint16_t) * (size ? size : 1));
+    index->mask = buckets - 1;
+    memset(index->heads, 0xFF, sizeof(uint16_t) * buckets);
+
+    // Insert backwards to keep load order in the chains
+    for(size_t i = size; i-- > 0;) {
+        const SubGhzKey* key = SubGhzKeyArray_cget(instance->data, i);
+        uint32_t bucket = subghz_keystore_name_hash(furi_string_get_cstr(key->name)) &
+                          index->mask;
+        index->next[i] = index->heads[bucket];
+        index->heads[bucket] = i;
+    }
+}
+
+static size_t subghz_keystore_name_index_match(
+    SubGhzKeystore* instance,
+    size_t index,
+    const char* name) {
+    while(index != SUBGHZ_KEYSTORE_NAME_INDEX_END) {
+        const SubGhzKey* key = SubGhzKeyArray_cget(instance->data, index);
+        if(furi_string_cmp_str(key->name, name) == 0) return index;
+        index = instance->name_index.next[index];
+    }
+    return SUBGHZ_KEYSTORE_INDEX_NONE;
+}
+
+static size_t subghz_keystore_name_scan(SubGhzKeystore* instance, size_t index, const char* name) {
+    for(; index < SubGhzKeyArray_size(instance->data); index++) {
+        const SubGhzKey* key = SubGhzKeyArray_cget(instance->data, index);
+        if(furi_string_cmp_str(key->name, name) == 0) return index;
+    }
+    return SUBGHZ_KEYSTORE_INDEX_NONE;
+}
+
+size_t subghz_keystore_find_first(SubGhzKeystore* instance, const char* name) {
+    furi_assert(instance);
+    furi_assert(name);
+
+    // Keys array is exposed, so rebuild if it was changed behind our back
+    if(instance->name_index.size != SubGhzKeyArray_size(instance->data) ||
+       (!instance->name_index.heads &&
+        instance->name_index.size < SUBGHZ_KEYSTORE_NAME_INDEX_END)) {
+        subghz_keystore_name_index_build(instance);
+    }
+
+    if(!instance->name_index.heads) {
+        return subghz_keystore_name_scan(instance, 0, name);
+    }
+
+    uint32_t bucket = subghz_keystore_name_hash(name) & instance->name_index.mask;
+    return subghz_keystore_name_index_match(instance, instance->name_index.heads[bucket], name);
+}
+
+size_t subghz_keystore_find_next(SubGhzKeystore* instance, size_t index) {
+    furi_assert(instance);
+    furi_assert(index < instance->name_index.size);
+
+    const char* name = furi_string_get_cstr(SubGhzKeyArray_cget(instance->data, index)->name);
+    if(!instance->name_index.heads) {
+        return subghz_keystore_name_scan(instance, index + 1, name);
+    }
+    return subghz_keystore_name_index_match(instance, instance->name_index.next[index], name);
+}
+
+SubGhzKeystoreKlCache* subghz_keystore_get_kl_cache(SubGhzKeystore* instance, uint32_t fix) {
+    furi_assert(instance);
+    uint32_t serial = fix & 0x0FFFFFFF;
+    return &instance->kl_cache[(serial ^ serial >> 8) % SUBGHZ_KEYSTORE_KL_CACHE_SIZE];
+}
+
+const SubGhzKeystoreKlStats* subghz_keystore_get_kl_stats(SubGhzKeystore* instance) {
+    furi_assert(instance);
+    return &instance->kl_stats;
+}
+
+void subghz_keystore_reset_kl_stats(SubGhzKeystore* instance) {
+    furi_assert(instance);
+    memset(&instance->kl_stats, 0, sizeof(SubGhzKeystoreKlStats));
+}
+
 static void subghz_keystore_add_key(
     SubGhzKeystore* instance,
     const char* name,
@@ -246,6 +360,10 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
 
     furi_string_free(filetype);
 
+    // Key indexes stored in the cache are not valid anymore
+    memset(instance->kl_cache, 0, sizeof(instance->kl_cache));
+    subghz_keystore_name_index_build(instance);
+
     return result;
 }
 
@@ -20,6 +20,14 @@ ARRAY_DEF(SubGhzKeyArray, SubGhzKey, M_POD_OPLIST)
 
 typedef struct SubGhzKeystore SubGhzKeystore;
 
+typedef struct {
+    uint32_t packets; /**< Packets checked against the keystore */
+    uint32_t attempts; /**< Decrypt attempts for all packets */
+    uint32_t attempts_last; /**< Decrypt attempts for the last packet */
+    uint32_t attempts_max; /**< Most decrypt attempts for one packet */
+    uint32_t cache_hits; /**< Packets resolved by the per-serial cache */
+} SubGhzKeystoreKlStats;
+
 /**
  * Allocate SubGhzKeystore.
  * @return SubGhzKeystore* pointer to a SubGhzKeystore instance
@@ -77,6 +85,19 @@ bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t*
 
 void subghz_keystore_reset_kl(SubGhzKeystore* instance);
 
+/** 
+ * Get KeeLoq decrypt statistics
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @return const SubGhzKeystoreKlStats*
+ */
+const SubGhzKeystoreKlStats* subghz_keystore_get_kl_stats(SubGhzKeystore* instance);
+
+/** 
+ * Reset KeeLoq decrypt statistics
+ * @param instance Pointer to a SubGhzKeystore instance
+ */
+void subghz_keystore_reset_kl_stats(SubGhzKeystore* instance);
+
 #ifdef __cplusplus
 }
 #endif
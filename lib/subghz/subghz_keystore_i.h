@@ -1,9 +1,58 @@
 #pragma once
 
+#include "subghz_keystore.h"
+
 #include <m-array.h>
 
+#define SUBGHZ_KEYSTORE_INDEX_NONE (SIZE_MAX)
+#define SUBGHZ_KEYSTORE_NAME_INDEX_END (0xFFFF)
+#define SUBGHZ_KEYSTORE_KL_CACHE_SIZE (8)
+
+typedef struct {
+    uint16_t* heads;
+    uint16_t* next;
+    uint16_t mask;
+    size_t size;
+} SubGhzKeystoreNameIndex;
+
+typedef struct {
+    uint32_t fix;
+    uint32_t hop;
+    uint32_t seed;
+    size_t key_index;
+    bool valid;
+} SubGhzKeystoreKlCache;
+
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
     const char* mfname;
     uint8_t kl_type;
+
+    SubGhzKeystoreNameIndex name_index;
+    SubGhzKeystoreKlCache kl_cache[SUBGHZ_KEYSTORE_KL_CACHE_SIZE];
+    SubGhzKeystoreKlStats kl_stats;
 };
+
+/**
+ * Find first key with given manufacture name, in load order
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param name Manufacture name
+ * @return Key index or SUBGHZ_KEYSTORE_INDEX_NONE
+ */
+size_t subghz_keystore_find_first(SubGhzKeystore* instance, const char* name);
+
+/**
+ * Find next key with the same manufacture name
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param index Key index returned by subghz_keystore_find_first or subghz_keystore_find_next
+ * @return Key index or SUBGHZ_KEYSTORE_INDEX_NONE
+ */
+size_t subghz_keystore_find_next(SubGhzKeystore* instance, size_t index);
+
+/**
+ * Get KeeLoq decode cache slot for the serial number
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param fix Fix part of the parcel
+ * @return SubGhzKeystoreKlCache*
+ */
+SubGhzKeystoreKlCache* subghz_keystore_get_kl_cache(SubGhzKeystore* instance, uint32_t fix);
@@ -8,6 +8,7 @@
 #include <lib/toolbox/level_duration.h>
 
 #include "environment.h"
+#include "blocks/const.h"
 #include <furi.h>
 #include <furi_hal.h>
 
@@ -79,6 +80,28 @@ typedef void (*SubGhzGetString)(void* decoder, FuriString* output);
 typedef void (*SubGhzEncoderStop)(void* encoder);
 typedef LevelDuration (*SubGhzEncoderYield)(void* context);
 
+typedef enum {
+    SubGhzProtocolEnvelopeTeShort,
+    SubGhzProtocolEnvelopeTeLong,
+} SubGhzProtocolEnvelopeTe;
+
+/** Timing envelope of the pulse that moves decoder out of its reset step
+ *
+ * Window matches the decoder reset step check:
+ * DURATION_DIFF(duration, te * start_te_count) < te_delta * start_delta_count
+ *
+ * Receiver doesn't feed pulses outside of the window to a decoder
+ * while its parser step is 0, decode results stay the same.
+ */
+typedef struct {
+    const SubGhzBlockConst* timing;
+    bool start_level;
+    SubGhzProtocolEnvelopeTe start_te;
+    uint16_t start_te_count;
+    uint16_t start_delta_count;
+    size_t parser_step_offset; ///< offset of uint32_t parser step in decoder instance
+} SubGhzProtocolDecoderEnvelope;
+
 typedef struct {
     SubGhzAlloc alloc;
     SubGhzFree free;
@@ -90,6 +113,8 @@ typedef struct {
     SubGhzGetString get_string;
     SubGhzSerialize serialize;
     SubGhzDeserialize deserialize;
+
+    const SubGhzProtocolDecoderEnvelope* envelope; ///< optional, NULL - feed every pulse
 } SubGhzProtocolDecoder;
 
 typedef struct {
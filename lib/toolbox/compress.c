@@ -1,6 +1,7 @@
 #include "compress.h"
 
 #include <furi.h>
+#include <furi_hal_flash.h>
 #include <lib/heatshrink/heatshrink_encoder.h>
 #include <lib/heatshrink/heatshrink_decoder.h>
 
@@ -14,6 +15,11 @@
 #define COMPRESS_ICON_ENCODED_BUFF_SIZE (1024u)
 #define COMPRESS_ICON_DECODED_BUFF_SIZE (1024u)
 
+/** Decoded icon cache limits */
+#define COMPRESS_ICON_CACHE_ENTRIES (16u)
+#define COMPRESS_ICON_CACHE_SIZE_MAX (8u * 1024u)
+#define COMPRESS_ICON_CACHE_HEAP_RESERVE (16u * 1024u)
+
 typedef struct {
     uint8_t is_compressed;
     uint8_t reserved;
@@ -22,9 +28,21 @@ typedef struct {
 
 _Static_assert(sizeof(CompressHeader) == 4, "Incorrect CompressHeader size");
 
+typedef struct {
+    const uint8_t* icon_data;
+    // Copy of encoded data to validate icons outside of firmware, NULL for firmware icons
+    uint8_t* encoded;
+    uint8_t* decoded;
+    size_t size;
+    uint32_t last_used;
+} CompressIconCacheEntry;
+
 struct CompressIcon {
     heatshrink_decoder* decoder;
     uint8_t decoded_buff[COMPRESS_ICON_DECODED_BUFF_SIZE];
+    CompressIconCacheEntry cache[COMPRESS_ICON_CACHE_ENTRIES];
+    uint32_t cache_clock;
+    CompressIconStats stats;
 };
 
 CompressIcon* compress_icon_alloc() {
@@ -39,8 +57,116 @@ CompressIcon* compress_icon_alloc() {
     return instance;
 }
 
+static void compress_icon_cache_remove(CompressIcon* instance, CompressIconCacheEntry* entry) {
+    free(entry->decoded);
+    instance->stats.cache_size -= entry->size;
+    instance->stats.cache_entries--;
+    memset(entry, 0, sizeof(CompressIconCacheEntry));
+}
+
+static void compress_icon_cache_evict_lru(CompressIcon* instance) {
+    CompressIconCacheEntry* lru = NULL;
+    for(size_t i = 0; i < COMPRESS_ICON_CACHE_ENTRIES; i++) {
+        CompressIconCacheEntry* entry = &instance->cache[i];
+        if(entry->icon_data && (!lru || entry->last_used < lru->last_used)) {
+            lru = entry;
+        }
+    }
+    furi_assert(lru);
+    compress_icon_cache_remove(instance, lru);
+    instance->stats.evictions++;
+}
+
+static CompressIconCacheEntry* compress_icon_cache_find(
+    CompressIcon* instance,
+    const uint8_t* icon_data,
+    size_t encoded_size) {
+    for(size_t i = 0; i < COMPRESS_ICON_CACHE_ENTRIES; i++) {
+        CompressIconCacheEntry* entry = &instance->cache[i];
+        if(entry->icon_data != icon_data) continue;
+
+        // Memory of freed icon can be reused for another one
+        if(entry->encoded && memcmp(entry->encoded, icon_data, encoded_size) != 0) {
+            compress_icon_cache_remove(instance, entry);
+            return NULL;
+        }
+
+        entry->last_used = ++instance->cache_clock;
+        return entry;
+    }
+    return NULL;
+}
+
+/** Firmware icons never change, others live in RAM and may be freed at any time */
+static bool compress_icon_is_firmware_data(const uint8_t* icon_data) {
+    size_t address = (size_t)icon_data;
+    return address >= furi_hal_flash_get_base() &&
+           address < furi_hal_flash_get_free_page_start_address();
+}
+
+/** Cache budget shrinks when free heap goes below reserve */
+static size_t compress_icon_cache_get_budget(CompressIcon* instance) {
+    size_t free_heap = memmgr_get_free_heap();
+    size_t cache_size = instance->stats.cache_size;
+
+    if(free_heap >= COMPRESS_ICON_CACHE_HEAP_RESERVE) {
+        return MIN(
+            (size_t)COMPRESS_ICON_CACHE_SIZE_MAX,
+            cache_size + free_heap - COMPRESS_ICON_CACHE_HEAP_RESERVE);
+    } else if(cache_size > COMPRESS_ICON_CACHE_HEAP_RESERVE - free_heap) {
+        return cache_size - (COMPRESS_ICON_CACHE_HEAP_RESERVE - free_heap);
+    } else {
+        return 0;
+    }
+}
+
+static void compress_icon_cache_add(
+    CompressIcon* instance,
+    const uint8_t* icon_data,
+    size_t encoded_size,
+    size_t decoded_size) {
+    bool is_firmware_data = compress_icon_is_firmware_data(icon_data);
+    size_t size = decoded_size + (is_firmware_data ? 0 : encoded_size);
+
+    size_t budget = compress_icon_cache_get_budget(instance);
+    while(instance->stats.cache_entries && instance->stats.cache_size + size > budget) {
+        compress_icon_cache_evict_lru(instance);
+    }
+    if(instance->stats.cache_size + size > budget ||
+       memmgr_heap_get_max_free_block() < size + COMPRESS_ICON_CACHE_HEAP_RESERVE) {
+        return;
+    }
+
+    if(instance->stats.cache_entries == COMPRESS_ICON_CACHE_ENTRIES) {
+        compress_icon_cache_evict_lru(instance);
+    }
+
+    CompressIconCacheEntry* entry = NULL;
+    for(size_t i = 0; i < COMPRESS_ICON_CACHE_ENTRIES; i++) {
+        if(!instance->cache[i].icon_data) {
+            entry = &instance->cache[i];
+            break;
+        }
+    }
+    furi_assert(entry);
+
+    entry->icon_data = icon_data;
+    entry->decoded = malloc(size);
+    memcpy(entry->decoded, instance->decoded_buff, decoded_size);
+    if(!is_firmware_data) {
+        entry->encoded = entry->decoded + decoded_size;
+        memcpy(entry->encoded, icon_data, encoded_size);
+    }
+    entry->size = size;
+    entry->last_used = ++instance->cache_clock;
+
+    instance->stats.cache_size += size;
+    instance->stats.cache_entries++;
+}
+
 void compress_icon_free(CompressIcon* instance) {
     furi_assert(instance);
+    compress_icon_cache_clear(instance);
     heatshrink_decoder_free(instance->decoder);
     free(instance);
 }
@@ -52,30 +178,59 @@ void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint
 
     CompressHeader* header = (CompressHeader*)icon_data;
     if(header->is_compressed) {
+        size_t encoded_size = sizeof(CompressHeader) + header->compressed_buff_size;
+        CompressIconCacheEntry* entry =
+            compress_icon_cache_find(instance, icon_data, encoded_size);
+        if(entry) {
+            instance->stats.hits++;
+            *decoded_buff = entry->decoded;
+            return;
+        }
+        instance->stats.misses++;
+
         size_t data_processed = 0;
+        size_t decoded_size = 0;
         heatshrink_decoder_sink(
             instance->decoder,
             (uint8_t*)&icon_data[sizeof(CompressHeader)],
             header->compressed_buff_size,
             &data_processed);
-        while(1) {
+        while(decoded_size < sizeof(instance->decoded_buff)) {
             HSD_poll_res res = heatshrink_decoder_poll(
                 instance->decoder,
-                instance->decoded_buff,
-                sizeof(instance->decoded_buff),
+                &instance->decoded_buff[decoded_size],
+                sizeof(instance->decoded_buff) - decoded_size,
                 &data_processed);
+            decoded_size += data_processed;
             furi_assert((res == HSDR_POLL_EMPTY) || (res == HSDR_POLL_MORE));
             if(res != HSDR_POLL_MORE) {
                 break;
             }
         }
         heatshrink_decoder_reset(instance->decoder);
+
+        compress_icon_cache_add(instance, icon_data, encoded_size, decoded_size);
         *decoded_buff = instance->decoded_buff;
     } else {
         *decoded_buff = (uint8_t*)&icon_data[1];
     }
 }
 
+void compress_icon_cache_clear(CompressIcon* instance) {
+    furi_assert(instance);
+    for(size_t i = 0; i < COMPRESS_ICON_CACHE_ENTRIES; i++) {
+        if(instance->cache[i].icon_data) {
+            compress_icon_cache_remove(instance, &instance->cache[i]);
+        }
+    }
+}
+
+void compress_icon_get_stats(CompressIcon* instance, CompressIconStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+    *stats = instance->stats;
+}
+
 struct Compress {
     heatshrink_encoder* encoder;
     heatshrink_decoder* decoder;
@@ -15,6 +15,15 @@ extern "C" {
 /** Compress Icon control structure */
 typedef struct CompressIcon CompressIcon;
 
+/** Decoded icon cache statistics */
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t cache_entries;
+    size_t cache_size;
+} CompressIconStats;
+
 /** Initialize icon compressor
  *
  * @return     Compress Icon instance
@@ -28,9 +37,14 @@ CompressIcon* compress_icon_alloc();
 void compress_icon_free(CompressIcon* instance);
 
 /** Decompress icon
+ *
+ * Recently decoded frames are kept in a small LRU cache, so icons drawn on
+ * every redraw are decoded only once. Cache size is limited and shrinks when
+ * free heap is running low.
  *
  * @warning    decoded_buff pointer set by this function is valid till next
- *             `compress_icon_decode` or `compress_icon_free` call
+ *             `compress_icon_decode`, `compress_icon_cache_clear` or
+ *             `compress_icon_free` call
  *
  * @param      instance      The Compress Icon instance
  * @param      icon_data     pointer to icon data
@@ -38,6 +52,19 @@ void compress_icon_free(CompressIcon* instance);
  */
 void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint8_t** decoded_buff);
 
+/** Free all decoded icons kept in cache
+ *
+ * @param      instance  The Compress Icon instance
+ */
+void compress_icon_cache_clear(CompressIcon* instance);
+
+/** Get decoded icon cache statistics
+ *
+ * @param      instance  The Compress Icon instance
+ * @param      stats     pointer to stats to fill
+ */
+void compress_icon_get_stats(CompressIcon* instance, CompressIconStats* stats);
+
 /** Compress control structure */
 typedef struct Compress Compress;
 
@@ -3,6 +3,9 @@
 
 LIST_DEF(DirIndexList, uint32_t);
 
+#define DIR_WALK_BATCH_SIZE 8
+#define DIR_WALK_NAME_LENGTH 256
+
 struct DirWalk {
     File* file;
     FuriString* path;
@@ -11,6 +14,11 @@ struct DirWalk {
     bool recursive;
     DirWalkFilterCb filter_cb;
     void* filter_context;
+
+    StorageDirEntry entries[DIR_WALK_BATCH_SIZE];
+    char* names;
+    size_t entries_count;
+    size_t entries_position;
 };
 
 DirWalk* dir_walk_alloc(Storage* storage) {
@@ -20,10 +28,18 @@ DirWalk* dir_walk_alloc(Storage* storage) {
     DirIndexList_init(dir_walk->index_list);
     dir_walk->recursive = true;
     dir_walk->filter_cb = NULL;
+
+    dir_walk->names = malloc(DIR_WALK_BATCH_SIZE * DIR_WALK_NAME_LENGTH);
+    for(size_t i = 0; i < DIR_WALK_BATCH_SIZE; i++) {
+        dir_walk->entries[i].name = &dir_walk->names[i * DIR_WALK_NAME_LENGTH];
+    }
+    dir_walk->entries_count = 0;
+    dir_walk->entries_position = 0;
     return dir_walk;
 }
 
 void dir_walk_free(DirWalk* dir_walk) {
+    free(dir_walk->names);
     storage_file_free(dir_walk->file);
     furi_string_free(dir_walk->path);
     DirIndexList_clear(dir_walk->index_list);
@@ -39,9 +55,33 @@ void dir_walk_set_filter_cb(DirWalk* dir_walk, DirWalkFilterCb cb, void* context
     dir_walk->filter_context = context;
 }
 
+static void dir_walk_reset_entries(DirWalk* dir_walk) {
+    dir_walk->entries_count = 0;
+    dir_walk->entries_position = 0;
+}
+
+// Entries are read from storage in batches, cache is valid until directory is reopened
+static FS_Error dir_walk_read_entry(DirWalk* dir_walk, FileInfo* fileinfo, const char** name) {
+    if(dir_walk->entries_position == dir_walk->entries_count) {
+        dir_walk->entries_count = storage_dir_read_batch(
+            dir_walk->file, dir_walk->entries, DIR_WALK_BATCH_SIZE, DIR_WALK_NAME_LENGTH, NULL);
+        dir_walk->entries_position = 0;
+
+        if(dir_walk->entries_count == 0) {
+            return storage_file_get_error(dir_walk->file);
+        }
+    }
+
+    StorageDirEntry* entry = &dir_walk->entries[dir_walk->entries_position++];
+    memcpy(fileinfo, &entry->fileinfo, sizeof(FileInfo));
+    *name = entry->name;
+    return FSE_OK;
+}
+
 bool dir_walk_open(DirWalk* dir_walk, const char* path) {
     furi_string_set(dir_walk->path, path);
     dir_walk->current_index = 0;
+    dir_walk_reset_entries(dir_walk);
     return storage_dir_open(dir_walk->file, path);
 }
 
@@ -56,14 +96,14 @@ static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* filei
 static DirWalkResult
     dir_walk_iter(DirWalk* dir_walk, FuriString* return_path, FileInfo* fileinfo) {
     DirWalkResult result = DirWalkError;
-    char* name = malloc(256); // FIXME: remove magic number
+    const char* name;
     FileInfo info;
     bool end = false;
 
     while(!end) {
-        storage_dir_read(dir_walk->file, &info, name, 255);
+        FS_Error error = dir_walk_read_entry(dir_walk, &info, &name);
 
-        if(storage_file_get_error(dir_walk->file) == FSE_OK) {
+        if(error == FSE_OK) {
             result = DirWalkOK;
             dir_walk->current_index++;
 
@@ -90,9 +130,10 @@ static DirWalkResult
                 storage_dir_close(dir_walk->file);
 
                 furi_string_cat_printf(dir_walk->path, "/%s", name);
+                dir_walk_reset_entries(dir_walk);
                 storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
             }
-        } else if(storage_file_get_error(dir_walk->file) == FSE_NOT_EXIST) {
+        } else if(error == FSE_NOT_EXIST) {
             if(DirIndexList_size(dir_walk->index_list) == 0) {
                 // last
                 result = DirWalkLast;
@@ -110,6 +151,7 @@ static DirWalkResult
                     furi_string_left(dir_walk->path, last_char);
                 }
 
+                dir_walk_reset_entries(dir_walk);
                 storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
 
                 // rewind
@@ -119,7 +161,7 @@ static DirWalkResult
                         break;
                     }
 
-                    if(!storage_dir_read(dir_walk->file, &info, name, 255)) {
+                    if(dir_walk_read_entry(dir_walk, &info, &name) != FSE_OK) {
                         result = DirWalkError;
                         end = true;
                         break;
@@ -134,7 +176,6 @@ static DirWalkResult
         }
     }
 
-    free(name);
     return result;
 }
 
@@ -154,4 +195,5 @@ void dir_walk_close(DirWalk* dir_walk) {
     DirIndexList_reset(dir_walk->index_list);
     furi_string_reset(dir_walk->path);
     dir_walk->current_index = 0;
+    dir_walk_reset_entries(dir_walk);
 }
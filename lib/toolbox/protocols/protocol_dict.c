@@ -5,18 +5,44 @@ struct ProtocolDict {
     const ProtocolBase** base;
     size_t count;
     void** data;
+    // decoders that are fed, in protocol order
+    size_t* active;
+    size_t active_count;
 };
 
+static void protocol_dict_decoders_arm(ProtocolDict* dict) {
+    dict->active_count = 0;
+    for(size_t i = 0; i < dict->count; i++) {
+        if(dict->base[i]->decoder.feed) {
+            dict->active[dict->active_count++] = i;
+        }
+    }
+}
+
+static void protocol_dict_decoders_filter(ProtocolDict* dict, uint32_t feature, bool keep) {
+    size_t active_count = 0;
+    for(size_t i = 0; i < dict->active_count; i++) {
+        size_t index = dict->active[i];
+        if(((dict->base[index]->features & feature) != 0) == keep) {
+            dict->active[active_count++] = index;
+        }
+    }
+    dict->active_count = active_count;
+}
+
 ProtocolDict* protocol_dict_alloc(const ProtocolBase** protocols, size_t count) {
     ProtocolDict* dict = malloc(sizeof(ProtocolDict));
     dict->base = protocols;
     dict->count = count;
     dict->data = malloc(sizeof(void*) * dict->count);
+    dict->active = malloc(sizeof(size_t) * dict->count);
 
     for(size_t i = 0; i < dict->count; i++) {
         dict->data[i] = dict->base[i]->alloc();
     }
 
+    protocol_dict_decoders_arm(dict);
+
     return dict;
 }
 
@@ -25,6 +51,7 @@ void protocol_dict_free(ProtocolDict* dict) {
         dict->base[i]->free(dict->data[i]);
     }
 
+    free(dict->active);
     free(dict->data);
     free(dict);
 }
@@ -90,6 +117,20 @@ void protocol_dict_decoders_start(ProtocolDict* dict) {
             fn(dict->data[i]);
         }
     }
+
+    protocol_dict_decoders_arm(dict);
+}
+
+void protocol_dict_decoders_keep_by_feature(ProtocolDict* dict, uint32_t feature) {
+    protocol_dict_decoders_filter(dict, feature, true);
+}
+
+void protocol_dict_decoders_drop_by_feature(ProtocolDict* dict, uint32_t feature) {
+    protocol_dict_decoders_filter(dict, feature, false);
+}
+
+size_t protocol_dict_decoders_get_active_count(ProtocolDict* dict) {
+    return dict->active_count;
 }
 
 uint32_t protocol_dict_get_features(ProtocolDict* dict, size_t protocol_index) {
@@ -101,15 +142,14 @@ ProtocolId protocol_dict_decoders_feed(ProtocolDict* dict, bool level, uint32_t
     bool done = false;
     ProtocolId ready_protocol_id = PROTOCOL_NO;
 
-    for(size_t i = 0; i < dict->count; i++) {
-        ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
+    for(size_t i = 0; i < dict->active_count; i++) {
+        size_t index = dict->active[i];
+        ProtocolDecoderFeed fn = dict->base[index]->decoder.feed;
 
-        if(fn) {
-            if(fn(dict->data[i], level, duration)) {
-                if(!done) {
-                    ready_protocol_id = i;
-                    done = true;
-                }
+        if(fn(dict->data[index], level, duration)) {
+            if(!done) {
+                ready_protocol_id = index;
+                done = true;
             }
         }
     }
@@ -125,17 +165,16 @@ ProtocolId protocol_dict_decoders_feed_by_feature(
     bool done = false;
     ProtocolId ready_protocol_id = PROTOCOL_NO;
 
-    for(size_t i = 0; i < dict->count; i++) {
-        uint32_t features = dict->base[i]->features;
+    for(size_t i = 0; i < dict->active_count; i++) {
+        size_t index = dict->active[i];
+        uint32_t features = dict->base[index]->features;
         if(features & feature) {
-            ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
-
-            if(fn) {
-                if(fn(dict->data[i], level, duration)) {
-                    if(!done) {
-                        ready_protocol_id = i;
-                        done = true;
-                    }
+            ProtocolDecoderFeed fn = dict->base[index]->decoder.feed;
+
+            if(fn(dict->data[index], level, duration)) {
+                if(!done) {
+                    ready_protocol_id = index;
+                    done = true;
                 }
             }
         }
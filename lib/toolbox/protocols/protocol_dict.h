@@ -36,8 +36,27 @@ const char* protocol_dict_get_name(ProtocolDict* dict, size_t protocol_index);
 
 const char* protocol_dict_get_manufacturer(ProtocolDict* dict, size_t protocol_index);
 
+/**
+ * Start all decoders. Decoders dropped by protocol_dict_decoders_keep_by_feature or
+ * protocol_dict_decoders_drop_by_feature are re-armed.
+ */
 void protocol_dict_decoders_start(ProtocolDict* dict);
 
+/**
+ * Stop feeding decoders that don't have the feature, until the next protocol_dict_decoders_start.
+ * protocol_dict_decoders_feed and protocol_dict_decoders_feed_by_feature skip dropped decoders.
+ */
+void protocol_dict_decoders_keep_by_feature(ProtocolDict* dict, uint32_t feature);
+
+/**
+ * Stop feeding decoders that have the feature, until the next protocol_dict_decoders_start.
+ * protocol_dict_decoders_feed and protocol_dict_decoders_feed_by_feature skip dropped decoders.
+ */
+void protocol_dict_decoders_drop_by_feature(ProtocolDict* dict, uint32_t feature);
+
+/** Get the number of decoders that are fed */
+size_t protocol_dict_decoders_get_active_count(ProtocolDict* dict);
+
 uint32_t protocol_dict_get_features(ProtocolDict* dict, size_t protocol_index);
 
 ProtocolId protocol_dict_decoders_feed(ProtocolDict* dict, bool level, uint32_t duration);
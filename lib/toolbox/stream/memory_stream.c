@@ -0,0 +1,182 @@
+#include "stream.h"
+#include "stream_i.h"
+#include "memory_stream.h"
+#include <core/check.h>
+#include <core/common_defines.h>
+#include <core/log.h>
+#include <core/memmgr_heap.h>
+
+#define TAG "MemoryStream"
+
+typedef struct {
+    Stream stream_base;
+    const uint8_t* data;
+    size_t size;
+    size_t index;
+    uint8_t* owned_data;
+} MemoryStream;
+
+static void memory_stream_free(MemoryStream* stream);
+static bool memory_stream_eof(MemoryStream* stream);
+static void memory_stream_clean(MemoryStream* stream);
+static bool memory_stream_seek(MemoryStream* stream, int32_t offset, StreamOffset offset_type);
+static size_t memory_stream_tell(MemoryStream* stream);
+static size_t memory_stream_size(MemoryStream* stream);
+static size_t memory_stream_write(MemoryStream* stream, const uint8_t* data, size_t size);
+static size_t memory_stream_read(MemoryStream* stream, uint8_t* data, size_t size);
+static bool memory_stream_delete_and_insert(
+    MemoryStream* stream,
+    size_t delete_size,
+    StreamWriteCB write_callback,
+    const void* ctx);
+static size_t memory_stream_peek(MemoryStream* stream, const uint8_t** data);
+
+const StreamVTable memory_stream_vtable = {
+    .free = (StreamFreeFn)memory_stream_free,
+    .eof = (StreamEOFFn)memory_stream_eof,
+    .clean = (StreamCleanFn)memory_stream_clean,
+    .seek = (StreamSeekFn)memory_stream_seek,
+    .tell = (StreamTellFn)memory_stream_tell,
+    .size = (StreamSizeFn)memory_stream_size,
+    .write = (StreamWriteFn)memory_stream_write,
+    .read = (StreamReadFn)memory_stream_read,
+    .delete_and_insert = (StreamDeleteAndInsertFn)memory_stream_delete_and_insert,
+    .peek = (StreamPeekFn)memory_stream_peek,
+};
+
+Stream* memory_stream_alloc(const void* data, size_t size) {
+    furi_assert(data || !size);
+    MemoryStream* stream = malloc(sizeof(MemoryStream));
+    stream->data = data;
+    stream->size = size;
+    stream->index = 0;
+    stream->owned_data = NULL;
+    stream->stream_base.vtable = &memory_stream_vtable;
+    return (Stream*)stream;
+}
+
+Stream* memory_stream_alloc_from_file(Storage* storage, const char* path) {
+    furi_assert(storage);
+    furi_assert(path);
+
+    File* file = storage_file_alloc(storage);
+    uint8_t* data = NULL;
+    size_t size = 0;
+    bool success = false;
+
+    do {
+        if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        uint64_t file_size = storage_file_size(file);
+        // Leave some heap to the rest of the system
+        if(file_size + STREAM_CACHE_SIZE > memmgr_heap_get_max_free_block()) {
+            FURI_LOG_E(TAG, "Not enough memory for %s", path);
+            break;
+        }
+        size = file_size;
+        data = malloc(size ? size : 1);
+
+        size_t offset = 0;
+        while(offset < size) {
+            uint16_t to_read = MIN(size - offset, (size_t)UINT16_MAX);
+            uint16_t was_read = storage_file_read(file, data + offset, to_read);
+            if(was_read != to_read) break;
+            offset += was_read;
+        }
+        success = (offset == size);
+    } while(false);
+
+    storage_file_close(file);
+    storage_file_free(file);
+
+    if(!success) {
+        free(data);
+        return NULL;
+    }
+
+    MemoryStream* stream = (MemoryStream*)memory_stream_alloc(data, size);
+    stream->owned_data = data;
+    return (Stream*)stream;
+}
+
+static void memory_stream_free(MemoryStream* stream) {
+    free(stream->owned_data);
+    free(stream);
+}
+
+static bool memory_stream_eof(MemoryStream* stream) {
+    return stream->index >= stream->size;
+}
+
+static void memory_stream_clean(MemoryStream* stream) {
+    // Data is read-only, only the position is reset
+    stream->index = 0;
+}
+
+static bool memory_stream_seek(MemoryStream* stream, int32_t offset, StreamOffset offset_type) {
+    int64_t position = 0;
+    switch(offset_type) {
+    case StreamOffsetFromStart:
+        position = offset;
+        break;
+    case StreamOffsetFromCurrent:
+        position = (int64_t)stream->index + offset;
+        break;
+    case StreamOffsetFromEnd:
+        position = (int64_t)stream->size + offset;
+        break;
+    }
+
+    // Same clamping as other streams
+    bool result = true;
+    if(position < 0) {
+        position = 0;
+        result = false;
+    } else if(position > (int64_t)stream->size) {
+        position = stream->size;
+        result = false;
+    }
+
+    stream->index = position;
+    return result;
+}
+
+static size_t memory_stream_tell(MemoryStream* stream) {
+    return stream->index;
+}
+
+static size_t memory_stream_size(MemoryStream* stream) {
+    return stream->size;
+}
+
+static size_t memory_stream_write(MemoryStream* stream, const uint8_t* data, size_t size) {
+    UNUSED(stream);
+    UNUSED(data);
+    UNUSED(size);
+    return 0;
+}
+
+static size_t memory_stream_read(MemoryStream* stream, uint8_t* data, size_t size) {
+    size_t available = stream->size - stream->index;
+    size = MIN(size, available);
+    memcpy(data, stream->data + stream->index, size);
+    stream->index += size;
+    return size;
+}
+
+static bool memory_stream_delete_and_insert(
+    MemoryStream* stream,
+    size_t delete_size,
+    StreamWriteCB write_callback,
+    const void* ctx) {
+    UNUSED(stream);
+    UNUSED(delete_size);
+    UNUSED(write_callback);
+    UNUSED(ctx);
+    return false;
+}
+
+static size_t memory_stream_peek(MemoryStream* stream, const uint8_t** data) {
+    *data = stream->data + stream->index;
+    return stream->size - stream->index;
+}
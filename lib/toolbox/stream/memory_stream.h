@@ -0,0 +1,28 @@
+#pragma once
+#include <stdlib.h>
+#include <storage/storage.h>
+#include "stream.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Allocate read-only stream over a memory block, data is not copied
+ * @param data pointer to data, must stay valid until the stream is freed
+ * @param size data size
+ * @return Stream*
+ */
+Stream* memory_stream_alloc(const void* data, size_t size);
+
+/**
+ * Allocate read-only stream with the whole file loaded into memory
+ * @param storage pointer to storage record
+ * @param path path to file
+ * @return Stream* or NULL if the file can't be read or there is not enough memory
+ */
+Stream* memory_stream_alloc_from_file(Storage* storage, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,6 +1,7 @@
 #include "stream.h"
 #include "stream_i.h"
 #include "file_stream.h"
+#include <string.h>
 #include <core/check.h>
 #include <core/common_defines.h>
 
@@ -145,8 +146,29 @@ static bool stream_write_struct(Stream* stream, const void* context) {
     return (stream_write(stream, write_data->data, write_data->size) == write_data->size);
 }
 
+static void stream_read_line_peek(Stream* stream, FuriString* str_result) {
+    const uint8_t* data = NULL;
+    size_t available = stream->vtable->peek(stream, &data);
+    const uint8_t* line_end = memchr(data, '\n', available);
+    size_t line_size = line_end ? (size_t)(line_end - data) + 1 : available;
+
+    furi_string_reserve(str_result, line_size);
+    for(size_t i = 0; i < line_size; i++) {
+        if(data[i] != '\r') furi_string_push_back(str_result, data[i]);
+    }
+
+    stream_seek(stream, line_size, StreamOffsetFromCurrent);
+}
+
 bool stream_read_line(Stream* stream, FuriString* str_result) {
     furi_string_reset(str_result);
+
+    // Scan in place if the stream can expose its data
+    if(stream->vtable->peek) {
+        stream_read_line_peek(stream, str_result);
+        return furi_string_size(str_result) != 0;
+    }
+
     uint8_t buffer[STREAM_BUFFER_SIZE];
 
     do {
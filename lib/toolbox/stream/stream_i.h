@@ -24,6 +24,11 @@ typedef bool (*StreamDeleteAndInsertFn)(
     size_t delete_size,
     StreamWriteCB write_cb,
     const void* ctx);
+/**
+ * Optional: get contiguous data at the current position without moving it
+ * @return Number of bytes available at *data
+ */
+typedef size_t (*StreamPeekFn)(Stream* stream, const uint8_t** data);
 
 struct StreamVTable {
     const StreamFreeFn free;
@@ -35,6 +40,7 @@ struct StreamVTable {
     const StreamWriteFn write;
     const StreamReadFn read;
     const StreamDeleteAndInsertFn delete_and_insert;
+    const StreamPeekFn peek;
 };
 
 struct Stream {
@@ -24,6 +24,7 @@ static bool string_stream_delete_and_insert(
     size_t delete_size,
     StreamWriteCB write_callback,
     const void* ctx);
+static size_t string_stream_peek(StringStream* stream, const uint8_t** data);
 
 const StreamVTable string_stream_vtable = {
     .free = (StreamFreeFn)string_stream_free,
@@ -35,6 +36,7 @@ const StreamVTable string_stream_vtable = {
     .write = (StreamWriteFn)string_stream_write,
     .read = (StreamReadFn)string_stream_read,
     .delete_and_insert = (StreamDeleteAndInsertFn)string_stream_delete_and_insert,
+    .peek = (StreamPeekFn)string_stream_peek,
 };
 
 Stream* string_stream_alloc() {
@@ -161,6 +163,11 @@ static bool string_stream_delete_and_insert(
     return result;
 }
 
+static size_t string_stream_peek(StringStream* stream, const uint8_t** data) {
+    *data = (const uint8_t*)&furi_string_get_cstr(stream->string)[stream->index];
+    return string_stream_size(stream) - stream->index;
+}
+
 /**
  * Write to string stream helper
  * @param stream 
@@ -136,6 +136,9 @@ class AppBuilder:
             CPPPATH=self.app_env.Dir(self.app_work_dir),
         )
 
+        if self.app.fap_lazy_load:
+            self.app_env.Append(CPPDEFINES=["FAP_LAZY_LOAD"])
+
         app_sources = list(
             itertools.chain.from_iterable(
                 self.app_env.GlobRecursive(
@@ -384,18 +387,20 @@ def generate_embed_app_metadata_actions(source, target, env, for_signature):
         "${SOURCES} ${TARGET}"
     )
 
-    actions.extend(
-        (
-            Action(
-                objcopy_str,
-                "$APPMETAEMBED_COMSTR",
-            ),
+    actions.append(
+        Action(
+            objcopy_str,
+            "$APPMETAEMBED_COMSTR",
+        )
+    )
+
+    if app.fap_fast_relocation:
+        actions.append(
             Action(
                 "${PYTHON3} ${FBT_SCRIPT_DIR}/fastfap.py ${TARGET} ${OBJCOPY}",
                 "$FASTFAP_COMSTR",
-            ),
+            )
         )
-    )
 
     return Action(actions)
 
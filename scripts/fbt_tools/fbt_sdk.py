@@ -217,6 +217,10 @@ def gen_sdk_data(sdk_cache: SdkCache):
     api_def.append(",\n".join(api_lines))
 
     api_def.append("));")
+
+    api_def.append(
+        "static constexpr auto elf_api_perfect_hash_table = make_perfect_hash_table(elf_api_table);"
+    )
     return api_def
 
 